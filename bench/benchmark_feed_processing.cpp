@@ -6,28 +6,65 @@
 #include "decoder.hpp"
 #include "order_book.hpp"
 #include "ring_buffer.hpp"
+#include "byte_ring.hpp"
 #include "messages.hpp"
 #include "clock.hpp"
+#include "publisher.hpp"
+#include "binary_publisher.hpp"
+#include "async_publisher.hpp"
+#include "udp_publisher.hpp"
+#include "tob_sink.hpp"
+#include "columnar.hpp"
+#include "trades.hpp"
+#include "trade_publisher.hpp"
+#include "feed_generator.hpp"
 #include <benchmark/benchmark.h>
 #include <fstream>
 #include <vector>
 #include <random>
 #include <cstdio>
 #include <unistd.h>
+#include <thread>
+#include <cstring>
 
 namespace {
 
-// Create a temporary test file with synthetic data
-std::string create_test_feed(size_t num_messages) {
-    static std::string temp_filename = "bench_feed_XXXXXX";
-    static bool created = false;
+// Feed files shared by several benchmarks, removed when the binary exits
+class TempFeeds {
+public:
+    ~TempFeeds() {
+        for (const std::string& filename : filenames_) {
+            std::remove(filename.c_str());
+        }
+    }
     
-    if (!created) {
-        int fd = mkstemp(&temp_filename[0]);
+    std::string create() {
+        std::string filename = "bench_feed_XXXXXX";
+        int fd = mkstemp(&filename[0]);
         if (fd == -1) {
             throw std::runtime_error("Cannot create temp file");
         }
         close(fd);
+        filenames_.push_back(filename);
+        return filename;
+    }
+
+private:
+    std::vector<std::string> filenames_;
+};
+
+TempFeeds& temp_feeds() {
+    static TempFeeds feeds;
+    return feeds;
+}
+
+// Create a temporary test file with synthetic data
+std::string create_test_feed(size_t num_messages) {
+    static std::string temp_filename;
+    static bool created = false;
+    
+    if (!created) {
+        temp_filename = temp_feeds().create();
         
         std::ofstream file(temp_filename, std::ios::binary);
         std::mt19937 rng(42); // Fixed seed for reproducibility
@@ -267,7 +304,447 @@ static void BM_ThroughputTest(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * num_messages);
 }
 
+// Decoder -> ring -> consumer across threads, replaying the test feed until
+// num_messages have crossed. Events: the producer decodes into Event slots.
+static void BM_EventRingTransport(benchmark::State& state) {
+    const size_t num_messages = 1000000;
+    std::string filename = create_test_feed(100000);
+    
+    for (auto _ : state) {
+        feed::Decoder decoder(filename);
+        core::RingBuffer<feed::Event> ring(4096);
+        
+        std::thread producer([&]() {
+            size_t produced = 0;
+            while (produced < num_messages) {
+                std::span<feed::Event> slots = ring.claim_batch(std::min<size_t>(64, num_messages - produced));
+                size_t filled = 0;
+                while (filled < slots.size()) {
+                    if (!decoder.has_next()) {
+                        decoder.reset();
+                    }
+                    if (decoder.next_into(slots[filled])) {
+                        filled++;
+                    }
+                }
+                ring.commit(filled);
+                produced += filled;
+                if (filled == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        
+        uint64_t checksum = 0;
+        for (size_t consumed = 0; consumed < num_messages;) {
+            std::span<feed::Event> events = ring.peek_batch(64);
+            for (const auto& event : events) {
+                checksum += event.payload.delete_order.order_id;
+            }
+            ring.release(events.size());
+            consumed += events.size();
+            if (events.empty()) {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        benchmark::DoNotOptimize(checksum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_messages);
+    state.counters["ring_bytes_per_msg"] = sizeof(feed::Event);
+}
+
+// Same, but the producer only frames wire bytes into a ByteRing and the
+// consumer decodes
+static void BM_ByteRingTransport(benchmark::State& state) {
+    const size_t num_messages = 1000000;
+    std::string filename = create_test_feed(100000);
+    uint64_t ring_bytes = 0;
+    
+    for (auto _ : state) {
+        feed::Decoder decoder(filename);
+        core::ByteRing ring(4096 * 32);
+        ring_bytes = 0;
+        
+        std::thread producer([&]() {
+            size_t produced = 0;
+            while (produced < num_messages) {
+                size_t framed = 0;
+                while (framed < 64 && produced + framed < num_messages) {
+                    if (!decoder.has_next()) {
+                        decoder.reset();
+                    }
+                    const size_t position = decoder.position();
+                    std::span<const char> raw = decoder.next_raw();
+                    char* slot = ring.try_claim(raw.size());
+                    if (slot == nullptr) {
+                        decoder.seek(position);
+                        break;
+                    }
+                    std::memcpy(slot, raw.data(), raw.size());
+                    ring_bytes += core::ByteRing::frame_size(raw.size());
+                    framed++;
+                }
+                ring.commit();
+                produced += framed;
+                if (framed == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        
+        uint64_t checksum = 0;
+        feed::Event event;
+        for (size_t consumed = 0; consumed < num_messages;) {
+            std::span<const char> raw = ring.peek();
+            if (raw.empty()) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (feed::Decoder::decode(raw, event)) {
+                checksum += event.payload.delete_order.order_id;
+            }
+            ring.release();
+            consumed++;
+        }
+        producer.join();
+        benchmark::DoNotOptimize(checksum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_messages);
+    state.counters["ring_bytes_per_msg"] = static_cast<double>(ring_bytes) / num_messages;
+}
+
+// Decode speed of one delta-encoded price column (1M rows, 64K-row groups)
+static void BM_ColumnarScan(benchmark::State& state) {
+    char filename[] = "bench_columnar_XXXXXX";
+    const int fd = mkstemp(filename);
+    if (fd == -1) {
+        state.SkipWithError("Cannot create temp file");
+        return;
+    }
+    close(fd);
+    constexpr int64_t ROWS = 1000000;
+    {
+        publish::ColumnarWriter writer(filename, publish::columnar_tob_columns(), {feed::Symbol("AAPL")});
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int64_t> step(-5, 5);
+        int64_t price = 100000000000LL;
+        for (int64_t i = 0; i < ROWS; ++i) {
+            price += step(rng) * 10000000;
+            const int64_t row[] = {i * 10, 0, price, 100, price + 10000000, 200};
+            writer.append(row);
+        }
+    }
+    
+    publish::ColumnarReader reader(filename);
+    const size_t column = reader.column_index("bid_px");
+    std::vector<int64_t> values;
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (size_t group = 0; group < reader.row_group_count(); ++group) {
+            reader.read_column(group, column, values);
+            for (const int64_t value : values) {
+                sum += value;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    std::remove(filename);
+    state.SetItemsProcessed(state.iterations() * ROWS);
+    state.SetBytesProcessed(state.iterations() * ROWS * static_cast<int64_t>(sizeof(int64_t)));
+}
+
+// Book updates plus a top-of-book row after every event, through a sink
+// chosen at compile time; NullSink is the pipeline without any I/O
+template<typename Sink>
+static void run_pipeline_with_sink(benchmark::State& state, Sink sink) {
+    const size_t num_messages = state.range(0);
+    std::string filename = create_test_feed(num_messages);
+    const feed::Symbol symbol("AAPL");
+    
+    for (auto _ : state) {
+        feed::Decoder decoder(filename);
+        book::OrderBook order_book;
+        feed::Event event;
+        while (decoder.has_next()) {
+            if (!decoder.next_into(event)) {
+                continue;
+            }
+            switch (event.type) {
+                case feed::EventType::ADD_ORDER: {
+                    const auto& msg = event.payload.add;
+                    book::Side side = (msg.side == 'B') ? book::Side::BUY : book::Side::SELL;
+                    order_book.on_add(msg.order_id, side, msg.px_nano, msg.qty);
+                    break;
+                }
+                case feed::EventType::MODIFY_ORDER:
+                    order_book.on_modify(event.payload.modify.order_id, event.payload.modify.new_px_nano,
+                                         event.payload.modify.new_qty);
+                    break;
+                case feed::EventType::EXECUTE_ORDER:
+                    order_book.on_execute(event.payload.execute.order_id, event.payload.execute.exec_qty);
+                    break;
+                case feed::EventType::DELETE_ORDER:
+                    order_book.on_delete(event.payload.delete_order.order_id);
+                    break;
+                default:
+                    break;
+            }
+            sink.write(publish::make_binary_tob_record(event.decode_timestamp_us, 0, order_book.top_of_book()),
+                       symbol);
+            sink.end_round();
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_messages);
+}
+
+static void BM_PipelineNullSink(benchmark::State& state) {
+    run_pipeline_with_sink(state, publish::NullSink{});
+}
+
+static void BM_PipelineCsvSink(benchmark::State& state) {
+    std::ofstream output("/dev/null");
+    publish::TopOfBookPublisher publisher(output, false);
+    run_pipeline_with_sink(state, publish::CsvSink(publisher));
+}
+
+// Cost per published top-of-book row: CSV text vs fixed binary records
+static void BM_PublishCsv(benchmark::State& state) {
+    std::ofstream sink("/dev/null");
+    publish::TopOfBookPublisher publisher(sink);
+    const feed::Symbol symbol("AAPL");
+    book::TopOfBook tob;
+    tob.best_bid_px = 100250000000LL;
+    tob.bid_sz = 300;
+    tob.best_ask_px = 100260000000LL;
+    tob.ask_sz = 200;
+    uint64_t ts = 0;
+    
+    for (auto _ : state) {
+        tob.bid_sz = static_cast<uint32_t>(ts & 1023);
+        publisher.publish(++ts, symbol, tob);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_PublishBinary(benchmark::State& state) {
+    publish::BinaryTopOfBookPublisher publisher("/dev/null", {feed::Symbol("AAPL")});
+    book::TopOfBook tob;
+    tob.best_bid_px = 100250000000LL;
+    tob.bid_sz = 300;
+    tob.best_ask_px = 100260000000LL;
+    tob.ask_sz = 200;
+    uint64_t ts = 0;
+    
+    for (auto _ : state) {
+        tob.bid_sz = static_cast<uint32_t>(ts & 1023);
+        publisher.publish(++ts, 0, tob);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Multicast on loopback, one sendmmsg() per 32 datagrams; the argument is
+// records per datagram
+static void BM_PublishUdp(benchmark::State& state) {
+    publish::UdpTopOfBookPublisher publisher("239.255.0.1", 30099, "127.0.0.1", 32,
+                                             static_cast<size_t>(state.range(0)));
+    const feed::Symbol symbol("AAPL");
+    book::TopOfBook tob;
+    tob.best_bid_px = 100250000000LL;
+    tob.bid_sz = 300;
+    tob.best_ask_px = 100260000000LL;
+    tob.ask_sz = 200;
+    uint64_t ts = 0;
+    
+    for (auto _ : state) {
+        tob.bid_sz = static_cast<uint32_t>(ts & 1023);
+        publisher.publish(++ts, symbol, tob);
+    }
+    publisher.flush();
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Book-thread cost of a CSV row when a publisher thread does the formatting;
+// the ring fills up (and publish() waits) once the publisher falls behind
+static void BM_PublishCsvAsync(benchmark::State& state) {
+    std::ofstream sink("/dev/null");
+    publish::TopOfBookPublisher publisher(sink, false);
+    const feed::Symbol symbol("AAPL");
+    publish::AsyncPublisher async([&](std::span<const publish::BinaryTobRecord> batch) {
+        for (const publish::BinaryTobRecord& record : batch) {
+            publisher.publish(record.ts_us, symbol, publish::to_top_of_book(record));
+        }
+        publisher.flush();
+    });
+    book::TopOfBook tob;
+    tob.best_bid_px = 100250000000LL;
+    tob.bid_sz = 300;
+    tob.best_ask_px = 100260000000LL;
+    tob.ask_sz = 200;
+    uint64_t ts = 0;
+    
+    for (auto _ : state) {
+        tob.bid_sz = static_cast<uint32_t>(ts & 1023);
+        async.publish(publish::make_binary_tob_record(++ts, 0, tob));
+    }
+    async.stop();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["full_waits"] = static_cast<double>(async.full_waits());
+}
+
+// Per-trade cost of bar aggregation on the book thread, with 1-3 intervals
+// (1s, 1m, 1h) and a trade every 10us of feed time
+static void BM_BarAggregation(benchmark::State& state) {
+    std::vector<book::BarAggregator> aggregators;
+    for (const uint64_t interval_us : {1000000ULL, 60000000ULL, 3600000000ULL}) {
+        if (aggregators.size() < static_cast<size_t>(state.range(0))) {
+            aggregators.emplace_back(interval_us);
+        }
+    }
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> step(-5, 5);
+    book::Trade trade{0, 1, 100000000000LL, 100, book::Side::BUY};
+    uint64_t completed = 0;
+    
+    for (auto _ : state) {
+        trade.ts_us += 10;
+        trade.price += step(rng) * 10000000;
+        for (book::BarAggregator& aggregator : aggregators) {
+            book::Bar bar;
+            completed += aggregator.on_trade(trade, bar);
+        }
+    }
+    benchmark::DoNotOptimize(completed);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Cost per trade row written by the trade stream
+static void BM_PublishTrade(benchmark::State& state) {
+    std::ofstream sink("/dev/null");
+    publish::TradePublisher publisher(sink);
+    const feed::Symbol symbol("AAPL");
+    book::Trade trade{0, 1, 100250000000LL, 100, book::Side::SELL};
+    
+    for (auto _ : state) {
+        trade.ts_us++;
+        trade.quantity = static_cast<uint32_t>(trade.ts_us & 1023);
+        publisher.publish(symbol, trade);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Simgen feed of PROFILE_MESSAGES messages over PROFILE_SYMBOLS symbols,
+// generated once per profile
+constexpr size_t PROFILE_SYMBOLS = 8;
+constexpr uint64_t PROFILE_MESSAGES = 1000000;
+
+static std::string profile_feed(feed::SimProfile profile) {
+    static std::string filenames[2];
+    std::string& filename = filenames[profile == feed::SimProfile::REALISTIC ? 1 : 0];
+    if (filename.empty()) {
+        filename = temp_feeds().create();
+        
+        feed::SimConfig config;
+        for (size_t i = 0; i < PROFILE_SYMBOLS; ++i) {
+            config.symbols.push_back("SYM" + std::to_string(i));
+        }
+        config.profile = profile;
+        feed::FeedWriter output(filename);
+        feed::FeedGenerator generator(config);
+        generator.generate(output, PROFILE_MESSAGES);
+        output.close();
+    }
+    return filename;
+}
+
+// Decoder -> ring -> per-symbol books across threads, on a uniform (0) or
+// realistic (1) simgen feed. Simgen order ids are sequence * symbols +
+// index + 1, which routes every event to its symbol's book without a lookup.
+static void BM_PipelineProfile(benchmark::State& state) {
+    const feed::SimProfile profile = state.range(0) == 0 ? feed::SimProfile::UNIFORM : feed::SimProfile::REALISTIC;
+    const std::string filename = profile_feed(profile);
+    uint64_t rejected = 0;
+    
+    for (auto _ : state) {
+        feed::Decoder decoder(filename);
+        core::RingBuffer<feed::Event> ring(4096);
+        std::vector<book::OrderBook> books(PROFILE_SYMBOLS);
+        
+        std::thread producer([&]() {
+            while (decoder.has_next()) {
+                std::span<feed::Event> slots = ring.claim_batch(64);
+                size_t filled = 0;
+                while (filled < slots.size() && decoder.has_next()) {
+                    if (decoder.next_into(slots[filled])) {
+                        filled++;
+                    }
+                }
+                ring.commit(filled);
+                if (filled == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        
+        rejected = 0;
+        for (uint64_t consumed = 0; consumed < PROFILE_MESSAGES;) {
+            std::span<feed::Event> events = ring.peek_batch(64);
+            for (const auto& event : events) {
+                // delete_order.order_id aliases every message's order id
+                book::OrderBook& book = books[(event.payload.delete_order.order_id - 1) % PROFILE_SYMBOLS];
+                bool applied = false;
+                switch (event.type) {
+                    case feed::EventType::ADD_ORDER: {
+                        const auto& msg = event.payload.add;
+                        book::Side side = (msg.side == 'B') ? book::Side::BUY : book::Side::SELL;
+                        applied = book.on_add(msg.order_id, side, msg.px_nano, msg.qty);
+                        break;
+                    }
+                    case feed::EventType::MODIFY_ORDER:
+                        applied = book.on_modify(event.payload.modify.order_id, event.payload.modify.new_px_nano,
+                                                 event.payload.modify.new_qty);
+                        break;
+                    case feed::EventType::EXECUTE_ORDER:
+                        applied = book.on_execute(event.payload.execute.order_id, event.payload.execute.exec_qty);
+                        break;
+                    case feed::EventType::DELETE_ORDER:
+                        applied = book.on_delete(event.payload.delete_order.order_id);
+                        break;
+                    default:
+                        break;
+                }
+                rejected += !applied;
+                benchmark::DoNotOptimize(book.top_of_book());
+            }
+            ring.release(events.size());
+            consumed += events.size();
+            if (events.empty()) {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+    }
+    
+    state.SetItemsProcessed(state.iterations() * PROFILE_MESSAGES);
+    state.counters["rejected_pct"] = 100.0 * static_cast<double>(rejected) / PROFILE_MESSAGES;
+}
+
 // Register benchmarks
 BENCHMARK(BM_DecodeMessages)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_FullPipelineProcessing)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_ThroughputTest)->Unit(benchmark::kSecond)->Iterations(1);
+BENCHMARK(BM_EventRingTransport)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ByteRingTransport)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ColumnarScan)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PipelineNullSink)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PipelineCsvSink)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PublishCsv)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_PublishBinary)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_PublishUdp)->Arg(1)->Arg(static_cast<int64_t>(publish::UDP_TOB_MAX_RECORDS))->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_PublishCsvAsync)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(BM_BarAggregation)->DenseRange(1, 3)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_PublishTrade)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_PipelineProfile)->DenseRange(0, 1)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -4,8 +4,13 @@
  */
 
 #include "order_book.hpp"
+#include "arena.hpp"
+#include "tob_table.hpp"
 #include <benchmark/benchmark.h>
 #include <random>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 static void BM_OrderBookAdd(benchmark::State& state) {
     book::OrderBook order_book;
@@ -194,9 +199,229 @@ static void BM_OrderBookMixedOperations(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations());
 }
 
+static void BM_OrderBookChurnHeap(benchmark::State& state) {
+    book::OrderBook order_book;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> price_dist(100000000000LL, 105000000000LL);
+    
+    uint64_t order_id = 1;
+    
+    for (auto _ : state) {
+        bool added = order_book.on_add(order_id, book::Side::BUY, price_dist(rng), 100);
+        bool deleted = order_book.on_delete(order_id++);
+        benchmark::DoNotOptimize(added);
+        benchmark::DoNotOptimize(deleted);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+static void BM_OrderBookChurnArena(benchmark::State& state) {
+    core::ArenaResource arena(4 * 1024 * 1024);
+    book::OrderBook order_book(&arena);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> price_dist(100000000000LL, 105000000000LL);
+    
+    uint64_t order_id = 1;
+    
+    for (auto _ : state) {
+        bool added = order_book.on_add(order_id, book::Side::BUY, price_dist(rng), 100);
+        bool deleted = order_book.on_delete(order_id++);
+        benchmark::DoNotOptimize(added);
+        benchmark::DoNotOptimize(deleted);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * 2);
+    state.counters["Allocations"] = static_cast<double>(arena.stats().allocations);
+    state.counters["PeakBytes"] = static_cast<double>(arena.stats().peak_bytes_in_use);
+}
+
+// Shared scenario for comparing policy combinations: one-cent grid, bids in
+// [99.00, 100.00], asks in [100.01, 101.00], monotonic order ids
+template<typename Book>
+static void BM_OrderBookPolicy(benchmark::State& state) {
+    constexpr int64_t TICK = 10000000LL;  // $0.01 in nano-units
+    Book order_book{book::PriceGrid{0, TICK}};
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> op_dist(0.0, 1.0);
+    std::uniform_int_distribution<int64_t> tick_dist(0, 100);
+    std::uniform_int_distribution<uint32_t> qty_dist(100, 1000);
+    
+    uint64_t next_order_id = 1;
+    std::vector<uint64_t> active_orders;
+    
+    auto random_price = [&](book::Side side) {
+        return side == book::Side::BUY ? (9900 + tick_dist(rng)) * TICK
+                                       : (10001 + tick_dist(rng)) * TICK;
+    };
+    auto take_random_order = [&]() {
+        size_t idx = static_cast<size_t>(op_dist(rng) * active_orders.size());
+        uint64_t order_id = active_orders[idx];
+        active_orders[idx] = active_orders.back();
+        active_orders.pop_back();
+        return order_id;
+    };
+    
+    // Warm up to a steady-state book
+    for (size_t i = 0; i < static_cast<size_t>(state.range(0)); ++i) {
+        book::Side side = (next_order_id % 2 == 0) ? book::Side::BUY : book::Side::SELL;
+        if (order_book.on_add(next_order_id, side, random_price(side), qty_dist(rng))) {
+            active_orders.push_back(next_order_id);
+        }
+        next_order_id++;
+    }
+    
+    for (auto _ : state) {
+        double op = op_dist(rng);
+        
+        if (active_orders.empty() || op < 0.45) {
+            book::Side side = (next_order_id % 2 == 0) ? book::Side::BUY : book::Side::SELL;
+            if (order_book.on_add(next_order_id, side, random_price(side), qty_dist(rng))) {
+                active_orders.push_back(next_order_id);
+            }
+            next_order_id++;
+        } else if (op < 0.65) {
+            uint64_t order_id = active_orders[static_cast<size_t>(op_dist(rng) * active_orders.size())];
+            book::Side side = (order_id % 2 == 0) ? book::Side::BUY : book::Side::SELL;
+            order_book.on_modify(order_id, random_price(side), qty_dist(rng));
+        } else if (op < 0.75) {
+            uint64_t order_id = active_orders[static_cast<size_t>(op_dist(rng) * active_orders.size())];
+            order_book.on_execute(order_id, 10);
+        } else {
+            order_book.on_delete(take_random_order());
+        }
+        
+        auto tob = order_book.top_of_book();
+        benchmark::DoNotOptimize(tob);
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Per-update cost of book analytics on a churning two-sided book (2000
+// orders, 100 one-cent levels a side): 0 = off, 1 = maintained but never
+// read, 2 = read every 64 updates (a publish round), 3 = read every update
+static void BM_OrderBookAnalytics(benchmark::State& state) {
+    const int64_t mode = state.range(0);
+    book::OrderBook order_book(book::PriceGrid{0, 10000000LL});
+    if (mode > 0) {
+        order_book.enable_analytics(5, 10);
+    }
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> level_dist(1, 100);
+    std::uniform_int_distribution<uint32_t> qty_dist(100, 1000);
+    auto random_price = [&](book::Side side) {
+        const int64_t cents = side == book::Side::BUY ? 10000 - level_dist(rng) : 10000 + level_dist(rng);
+        return cents * 10000000LL;
+    };
+    
+    constexpr uint64_t NUM_ORDERS = 2000;
+    std::vector<book::Side> sides(NUM_ORDERS + 1);
+    for (uint64_t id = 1; id <= NUM_ORDERS; ++id) {
+        sides[id] = id % 2 == 0 ? book::Side::BUY : book::Side::SELL;
+        order_book.on_add(id, sides[id], random_price(sides[id]), qty_dist(rng));
+    }
+    
+    std::uniform_int_distribution<uint64_t> order_dist(1, NUM_ORDERS);
+    uint64_t updates = 0;
+    double sink = 0.0;
+    for (auto _ : state) {
+        const uint64_t id = order_dist(rng);
+        // Alternate quantity-only changes with moves to a new level
+        if (updates++ % 2 == 0) {
+            order_book.on_execute(id, 1);
+        } else {
+            order_book.on_delete(id);
+            order_book.on_add(id, sides[id], random_price(sides[id]), qty_dist(rng));
+        }
+        if (mode == 3 || (mode == 2 && updates % 64 == 0)) {
+            sink += order_book.analytics().imbalance;
+        }
+    }
+    benchmark::DoNotOptimize(sink);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Writer cost of a seqlock update with range(0) reader threads polling the entry
+static void BM_TopOfBookTableUpdate(benchmark::State& state) {
+    book::TopOfBookTable table(1);
+    const size_t slot = table.add_symbol(feed::Symbol("AAPL"));
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int64_t r = 0; r < state.range(0); ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load(std::memory_order_relaxed)) {
+                benchmark::DoNotOptimize(table.read(slot));
+            }
+        });
+    }
+    
+    book::TopOfBook tob;
+    tob.best_ask_px = 101000000000LL;
+    tob.ask_sz = 100;
+    uint32_t k = 0;
+    for (auto _ : state) {
+        tob.best_bid_px = 100000000000LL + (k & 1023);
+        tob.bid_sz = ++k;
+        benchmark::DoNotOptimize(table.update(slot, tob, k));
+    }
+    
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Reader throughput on one entry, idle (0) or while a writer updates it (1)
+static void BM_TopOfBookTableRead(benchmark::State& state) {
+    book::TopOfBookTable table(1);
+    const size_t slot = table.add_symbol(feed::Symbol("AAPL"));
+    std::atomic<bool> done{false};
+    std::thread writer;
+    if (state.range(0) != 0) {
+        writer = std::thread([&]() {
+            book::TopOfBook tob;
+            for (uint32_t k = 1; !done.load(std::memory_order_relaxed); ++k) {
+                tob.bid_sz = k;
+                table.update(slot, tob, k);
+            }
+        });
+    }
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.read(slot));
+    }
+    
+    done.store(true);
+    if (writer.joinable()) {
+        writer.join();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
 // Register benchmarks
 BENCHMARK(BM_OrderBookAdd)->Unit(benchmark::kNanosecond);
 BENCHMARK(BM_OrderBookModify)->Range(100, 10000)->Unit(benchmark::kNanosecond);
 BENCHMARK(BM_OrderBookExecute)->Range(100, 10000)->Unit(benchmark::kNanosecond);
 BENCHMARK(BM_OrderBookTopOfBook)->Range(100, 10000)->Unit(benchmark::kNanosecond);
 BENCHMARK(BM_OrderBookMixedOperations)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_OrderBookChurnHeap)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_OrderBookChurnArena)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_OrderBookAnalytics)->DenseRange(0, 3)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_TopOfBookTableUpdate)->DenseRange(0, 2)->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_TopOfBookTableRead)->DenseRange(0, 1)->Unit(benchmark::kNanosecond);
+
+// Level store x order index combinations over the same scenario
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::BasicOrderBook<book::MapLevels, book::HashOrderIndex>)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::BasicOrderBook<book::MapLevels, book::OpenAddressingOrderIndex>)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::BasicOrderBook<book::MapLevels, book::DirectOrderIndex>)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::BasicOrderBook<book::SortedVectorLevels, book::HashOrderIndex>)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::BasicOrderBook<book::SortedVectorLevels, book::OpenAddressingOrderIndex>)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::BasicOrderBook<book::SortedVectorLevels, book::DirectOrderIndex>)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::BasicOrderBook<book::FlatLadderLevels, book::HashOrderIndex>)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::BasicOrderBook<book::FlatLadderLevels, book::OpenAddressingOrderIndex>)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::BasicOrderBook<book::FlatLadderLevels, book::DirectOrderIndex>)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::PackedOrderBook)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::DensePackedOrderBook)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_OrderBookPolicy, book::BasicOrderBook<book::FlatLadderLevels, book::DirectOrderIndex, book::PackedOrder>)->Range(1000, 100000);
@@ -4,9 +4,15 @@
  */
 
 #include "ring_buffer.hpp"
+#include "messages.hpp"
+#include "mpmc_queue.hpp"
+#include "broadcast_ring.hpp"
 #include <benchmark/benchmark.h>
 #include <thread>
 #include <atomic>
+#include <span>
+#include <vector>
+#include <memory>
 
 static void BM_RingBufferSingleThreaded(benchmark::State& state) {
     const size_t buffer_size = state.range(0);
@@ -132,6 +138,69 @@ static void BM_RingBufferContention(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * items_per_iteration);
 }
 
+// N producers (range(0)) feeding one or more consumers; range(1) is the
+// producer batch size (1 = try_push per item)
+template<typename Queue>
+static void run_queue_contention(benchmark::State& state, size_t num_consumers) {
+    const size_t num_producers = static_cast<size_t>(state.range(0));
+    const size_t batch = static_cast<size_t>(state.range(1));
+    const size_t items_per_iteration = 80000;
+    const size_t per_producer = items_per_iteration / num_producers;
+    const size_t total = per_producer * num_producers;
+    
+    for (auto _ : state) {
+        Queue queue(1024);
+        std::atomic<size_t> total_consumed{0};
+        std::vector<std::thread> threads;
+        
+        for (size_t p = 0; p < num_producers; ++p) {
+            threads.emplace_back([&, p]() {
+                std::vector<int> items(batch, static_cast<int>(p));
+                size_t produced = 0;
+                while (produced < per_producer) {
+                    size_t pushed = batch == 1
+                        ? (queue.try_push(static_cast<int>(p)) ? 1 : 0)
+                        : queue.try_push_batch(items.data(), std::min(batch, per_producer - produced));
+                    produced += pushed;
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        
+        for (size_t c = 0; c < num_consumers; ++c) {
+            threads.emplace_back([&]() {
+                int values[64];
+                while (total_consumed.load(std::memory_order_relaxed) < total) {
+                    size_t popped = queue.try_pop_batch(values, 64);
+                    if (popped > 0) {
+                        total_consumed.fetch_add(popped, std::memory_order_relaxed);
+                        benchmark::DoNotOptimize(values);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        benchmark::DoNotOptimize(total_consumed.load());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * total);
+}
+
+static void BM_MpscQueueContention(benchmark::State& state) {
+    run_queue_contention<core::MpscQueue<int>>(state, 1);
+}
+
+static void BM_MpmcQueueContention(benchmark::State& state) {
+    run_queue_contention<core::MpmcQueue<int>>(state, 2);
+}
+
 static void BM_RingBufferThroughput(benchmark::State& state) {
     const size_t buffer_size = 1024 * 1024; // Large buffer
     const size_t num_items = 1000000; // 1M items
@@ -177,8 +246,262 @@ static void BM_RingBufferThroughput(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * num_items);
 }
 
+// Build an event the way the decoder does
+static void fill_event(feed::Event& event, uint64_t i) {
+    event.type = feed::EventType::ADD_ORDER;
+    event.payload.add.order_id = i;
+    event.payload.add.px_nano = 100000000000LL + static_cast<int64_t>(i & 0xFF);
+    event.payload.add.qty = 100;
+    event.decode_timestamp_us = i;
+}
+
+// Baseline: build on the stack, copy in with try_push, copy out with try_pop
+static void BM_RingBufferEventCopy(benchmark::State& state) {
+    const size_t num_items = 1000000;
+    
+    for (auto _ : state) {
+        core::RingBuffer<feed::Event> buffer(4096);
+        
+        std::thread producer([&]() {
+            for (size_t i = 0; i < num_items; ++i) {
+                feed::Event event;
+                fill_event(event, i);
+                while (!buffer.try_push(event)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        
+        feed::Event event;
+        uint64_t checksum = 0;
+        for (size_t consumed = 0; consumed < num_items;) {
+            if (buffer.try_pop(event)) {
+                checksum += event.payload.add.order_id;
+                consumed++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        benchmark::DoNotOptimize(checksum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_items);
+}
+
+// Claim/commit and peek/release; range(0) is the batch size (1 = single-slot API)
+static void BM_RingBufferEventInPlace(benchmark::State& state) {
+    const size_t num_items = 1000000;
+    const size_t batch = static_cast<size_t>(state.range(0));
+    
+    for (auto _ : state) {
+        core::RingBuffer<feed::Event> buffer(4096);
+        
+        std::thread producer([&]() {
+            size_t produced = 0;
+            while (produced < num_items) {
+                if (batch == 1) {
+                    if (feed::Event* slot = buffer.try_claim()) {
+                        fill_event(*slot, produced++);
+                        buffer.commit();
+                    } else {
+                        std::this_thread::yield();
+                    }
+                    continue;
+                }
+                std::span<feed::Event> slots = buffer.claim_batch(std::min(batch, num_items - produced));
+                for (auto& slot : slots) {
+                    fill_event(slot, produced++);
+                }
+                buffer.commit(slots.size());
+                if (slots.empty()) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        
+        uint64_t checksum = 0;
+        for (size_t consumed = 0; consumed < num_items;) {
+            if (batch == 1) {
+                if (const feed::Event* event = buffer.peek()) {
+                    checksum += event->payload.add.order_id;
+                    buffer.release();
+                    consumed++;
+                } else {
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+            std::span<feed::Event> events = buffer.peek_batch(batch);
+            for (const auto& event : events) {
+                checksum += event.payload.add.order_id;
+            }
+            buffer.release(events.size());
+            consumed += events.size();
+            if (events.empty()) {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        benchmark::DoNotOptimize(checksum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_items);
+}
+
+// Every consumer (range(0) of them) sees every event: one RingBuffer per
+// consumer, each event copied into all of them
+static void BM_RingBufferFanOut(benchmark::State& state) {
+    const size_t num_items = 1000000;
+    const size_t num_consumers = static_cast<size_t>(state.range(0));
+    
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<core::RingBuffer<feed::Event>>> buffers;
+        for (size_t c = 0; c < num_consumers; ++c) {
+            buffers.push_back(std::make_unique<core::RingBuffer<feed::Event>>(4096));
+        }
+        
+        std::vector<std::thread> consumers;
+        std::vector<uint64_t> checksums(num_consumers, 0);
+        for (size_t c = 0; c < num_consumers; ++c) {
+            consumers.emplace_back([&, c]() {
+                core::RingBuffer<feed::Event>& buffer = *buffers[c];
+                uint64_t checksum = 0;
+                for (size_t consumed = 0; consumed < num_items;) {
+                    std::span<feed::Event> events = buffer.peek_batch(64);
+                    for (const auto& event : events) {
+                        checksum += event.payload.add.order_id;
+                    }
+                    buffer.release(events.size());
+                    consumed += events.size();
+                    if (events.empty()) {
+                        std::this_thread::yield();
+                    }
+                }
+                checksums[c] = checksum;
+            });
+        }
+        
+        feed::Event event;
+        for (size_t i = 0; i < num_items; ++i) {
+            fill_event(event, i);
+            for (auto& buffer : buffers) {
+                while (!buffer->try_push(event)) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        
+        for (auto& consumer : consumers) {
+            consumer.join();
+        }
+        benchmark::DoNotOptimize(checksums.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_items);
+}
+
+// Same fan-out through one BroadcastRing: events are written once and read in
+// place by every consumer
+static void BM_BroadcastRingFanOut(benchmark::State& state) {
+    const size_t num_items = 1000000;
+    const size_t num_consumers = static_cast<size_t>(state.range(0));
+    
+    for (auto _ : state) {
+        core::BroadcastRing<feed::Event> ring(4096);
+        for (size_t c = 0; c < num_consumers; ++c) {
+            ring.add_consumer();
+        }
+        
+        std::vector<std::thread> consumers;
+        std::vector<uint64_t> checksums(num_consumers, 0);
+        for (size_t c = 0; c < num_consumers; ++c) {
+            consumers.emplace_back([&, c]() {
+                uint64_t checksum = 0;
+                for (size_t consumed = 0; consumed < num_items;) {
+                    std::span<const feed::Event> events = ring.peek_batch(c, 64);
+                    for (const auto& event : events) {
+                        checksum += event.payload.add.order_id;
+                    }
+                    ring.release(c, events.size());
+                    consumed += events.size();
+                    if (events.empty()) {
+                        std::this_thread::yield();
+                    }
+                }
+                checksums[c] = checksum;
+            });
+        }
+        
+        for (size_t produced = 0; produced < num_items;) {
+            std::span<feed::Event> slots = ring.claim_batch(std::min<size_t>(64, num_items - produced));
+            for (auto& slot : slots) {
+                fill_event(slot, produced++);
+            }
+            ring.commit(slots.size());
+            if (slots.empty()) {
+                std::this_thread::yield();
+            }
+        }
+        
+        for (auto& consumer : consumers) {
+            consumer.join();
+        }
+        benchmark::DoNotOptimize(checksums.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_items);
+}
+
 // Register benchmarks
+// First lap over a freshly built 1M-event ring: heap storage vs a prefaulted
+// mapping with transparent huge pages (arg 1) or hugetlb pages (arg 2)
+static void BM_RingBufferFirstLap(benchmark::State& state) {
+    constexpr size_t capacity = 1024 * 1024;
+    constexpr size_t batch = 64;
+    
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::unique_ptr<core::RingBuffer<feed::Event>> buffer;
+        if (state.range(0) == 0) {
+            buffer = std::make_unique<core::RingBuffer<feed::Event>>(capacity);
+        } else {
+            core::PageOptions options;
+            options.pages = state.range(0) == 1 ? core::PageMode::TRANSPARENT : core::PageMode::HUGETLB;
+            options.numa_node = core::current_numa_node();
+            options.prefault = true;
+            buffer = std::make_unique<core::RingBuffer<feed::Event>>(capacity, options);
+        }
+        state.ResumeTiming();
+        
+        uint64_t i = 0;
+        for (size_t lap = 0; lap + batch < capacity; lap += batch) {
+            std::span<feed::Event> slots = buffer->claim_batch(batch);
+            for (feed::Event& event : slots) {
+                fill_event(event, i++);
+            }
+            buffer->commit(slots.size());
+            std::span<feed::Event> ready = buffer->peek_batch(batch);
+            benchmark::DoNotOptimize(ready.data());
+            buffer->release(ready.size());
+        }
+        
+        state.PauseTiming();
+        buffer.reset();
+        state.ResumeTiming();
+    }
+    
+    state.SetItemsProcessed(state.iterations() * (capacity - batch));
+}
+
 BENCHMARK(BM_RingBufferSingleThreaded)->Range(64, 1024*1024)->Unit(benchmark::kNanosecond);
 BENCHMARK(BM_RingBufferSPSC)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_RingBufferContention)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MpscQueueContention)->ArgsProduct({{2, 4, 8}, {1, 16}})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MpmcQueueContention)->ArgsProduct({{2, 4, 8}, {1, 16}})->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_RingBufferThroughput)->Unit(benchmark::kSecond)->Iterations(3);
+BENCHMARK(BM_RingBufferEventCopy)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RingBufferEventInPlace)->Arg(1)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RingBufferFanOut)->DenseRange(1, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BroadcastRingFanOut)->DenseRange(1, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RingBufferFirstLap)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
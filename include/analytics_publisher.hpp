@@ -0,0 +1,42 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "order_book.hpp"
+#include "messages.hpp"
+#include <iostream>
+
+namespace publish {
+
+/**
+ * @brief CSV publisher for book analytics
+ *
+ * Rows are ts_us,symbol,microprice,imbalance,bid_depth,ask_depth,
+ * bid_band_depth,ask_band_depth; microprice is in decimal units and empty
+ * unless both sides are quoted. Output is buffered; call flush() to push it.
+ */
+class AnalyticsPublisher {
+public:
+    explicit AnalyticsPublisher(std::ostream& output);
+    
+    /**
+     * @brief Write one row (and the header before the first one)
+     */
+    void publish(uint64_t timestamp_us, const feed::Symbol& symbol, const book::BookAnalytics& analytics);
+    
+    void flush();
+    
+    /**
+     * @brief Rows written so far
+     */
+    uint64_t published() const noexcept { return published_; }
+
+private:
+    std::ostream& output_;
+    uint64_t published_ = 0;
+};
+
+} // namespace publish
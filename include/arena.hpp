@@ -0,0 +1,149 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace core {
+
+/**
+ * @brief Per-owner memory arena with allocation accounting
+ *
+ * Allocations are served from a preallocated block through a monotonic
+ * resource, optionally fronted by an unsynchronized pool so that freed nodes
+ * are recycled (needed for long replays with heavy order churn). Not
+ * thread-safe: give each book or shard its own arena.
+ */
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Allocation strategy
+     */
+    enum class Kind : uint8_t {
+        MONOTONIC,  // bump allocation, frees are no-ops until reset()
+        POOL        // size-class pools on top of the monotonic arena
+    };
+    
+    /**
+     * @brief Allocation counters since construction or the last reset()
+     */
+    struct Stats {
+        uint64_t allocations = 0;
+        uint64_t deallocations = 0;
+        size_t bytes_in_use = 0;
+        size_t peak_bytes_in_use = 0;
+        size_t upstream_bytes = 0;  // Bytes taken from the heap beyond the initial block
+    };
+    
+    /**
+     * @brief Construct arena
+     * @param initial_bytes Size of the preallocated block
+     * @param kind Allocation strategy
+     */
+    explicit ArenaResource(size_t initial_bytes, Kind kind = Kind::POOL)
+        : initial_size_(initial_bytes),
+          initial_(std::make_unique<std::byte[]>(initial_bytes)),
+          upstream_(stats_),
+          monotonic_(initial_.get(), initial_size_, &upstream_) {
+        if (kind == Kind::POOL) {
+            pool_.emplace(&monotonic_);
+        }
+    }
+    
+    ArenaResource(const ArenaResource&) = delete;
+    ArenaResource& operator=(const ArenaResource&) = delete;
+    
+    /**
+     * @brief Release everything back to the initial block
+     *
+     * All containers using the arena must have been destroyed first. When the
+     * working set fit in the initial block this is O(1); otherwise the
+     * overflow chunks are returned to the heap.
+     */
+    void reset() noexcept {
+        assert(stats_.bytes_in_use == 0 && "Arena reset with live allocations");
+        if (pool_) {
+            pool_->release();
+        }
+        monotonic_.release();
+        stats_ = Stats{};
+    }
+    
+    /**
+     * @brief Get allocation counters
+     * @return Counters since construction or the last reset()
+     */
+    const Stats& stats() const noexcept { return stats_; }
+    
+    /**
+     * @brief Get size of the preallocated block
+     * @return Initial block size in bytes
+     */
+    size_t initial_bytes() const noexcept { return initial_size_; }
+
+private:
+    /**
+     * @brief Heap upstream that records how much the arena overflowed
+     */
+    class CountingUpstream : public std::pmr::memory_resource {
+    public:
+        explicit CountingUpstream(Stats& stats) : stats_(stats) {}
+    
+    private:
+        Stats& stats_;
+        
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            stats_.upstream_bytes += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+    
+    Stats stats_;
+    size_t initial_size_;
+    std::unique_ptr<std::byte[]> initial_;
+    CountingUpstream upstream_;
+    std::pmr::monotonic_buffer_resource monotonic_;
+    std::optional<std::pmr::unsynchronized_pool_resource> pool_;
+    
+    std::pmr::memory_resource* front() noexcept {
+        return pool_ ? static_cast<std::pmr::memory_resource*>(&*pool_) : &monotonic_;
+    }
+    
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* p = front()->allocate(bytes, alignment);
+        stats_.allocations++;
+        stats_.bytes_in_use += bytes;
+        if (stats_.bytes_in_use > stats_.peak_bytes_in_use) {
+            stats_.peak_bytes_in_use = stats_.bytes_in_use;
+        }
+        return p;
+    }
+    
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        front()->deallocate(p, bytes, alignment);
+        stats_.deallocations++;
+        stats_.bytes_in_use -= bytes;
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace core
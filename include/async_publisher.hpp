@@ -0,0 +1,112 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "binary_publisher.hpp"
+#include "ring_buffer.hpp"
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <span>
+#include <thread>
+
+namespace publish {
+
+/**
+ * @brief Moves top-of-book publishing off the book thread
+ *
+ * The book thread hands compact BinaryTobRecords to a dedicated publisher
+ * thread through an SPSC ring; the publisher thread drains them in batches
+ * and passes each batch to the sink, which does all formatting and I/O.
+ * Records reach the sink in publish order.
+ *
+ * If the sink throws, the publisher thread keeps draining (and discarding)
+ * records so the book thread never stalls, and stop() rethrows the error.
+ */
+class AsyncPublisher {
+public:
+    using Sink = std::function<void(std::span<const BinaryTobRecord>)>;
+    
+    /**
+     * @brief Start the publisher thread
+     * @param sink Called on the publisher thread with each batch of records
+     * @param capacity Ring capacity in records (must be power of 2)
+     * @param max_batch Maximum number of records per sink call
+     */
+    explicit AsyncPublisher(Sink sink, size_t capacity = 65536, size_t max_batch = 256);
+    
+    /**
+     * @brief Drain and stop the publisher thread; errors are swallowed
+     */
+    ~AsyncPublisher();
+    
+    AsyncPublisher(const AsyncPublisher&) = delete;
+    AsyncPublisher& operator=(const AsyncPublisher&) = delete;
+    
+    /**
+     * @brief Queue one record (book thread)
+     *
+     * Waits for the publisher thread when the ring is full rather than
+     * dropping the record.
+     */
+    void publish(const BinaryTobRecord& record) noexcept {
+        while (!ring_.try_push(record)) {
+            full_waits_.store(full_waits_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    }
+    
+    /**
+     * @brief Hand every queued record to the sink and join the publisher thread
+     * @throws Whatever the sink threw, if it failed
+     */
+    void stop();
+    
+    /**
+     * @brief Records handed to the sink so far
+     */
+    uint64_t published() const noexcept {
+        return published_.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Sink calls so far
+     */
+    uint64_t batches() const noexcept {
+        return batches_.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Times publish() found the ring full
+     */
+    uint64_t full_waits() const noexcept {
+        return full_waits_.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Ring telemetry
+     */
+    core::RingStats stats() const noexcept {
+        return ring_.stats();
+    }
+
+private:
+    Sink sink_;
+    const size_t max_batch_;
+    core::RingBuffer<BinaryTobRecord> ring_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> full_waits_{0};
+    std::exception_ptr error_;
+    std::thread thread_;
+    
+    void run();
+    size_t drain();
+};
+
+} // namespace publish
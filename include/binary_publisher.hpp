@@ -0,0 +1,217 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "order_book.hpp"
+#include "messages.hpp"
+#include "publisher.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace publish {
+
+static_assert(std::endian::native == std::endian::little, "Binary records are written in host order");
+
+constexpr char BINARY_TOB_MAGIC[8] = {'M', 'F', 'T', 'O', 'B', '\0', '\0', '\0'};
+constexpr uint16_t BINARY_TOB_VERSION = 2;
+
+/**
+ * @brief File header of the binary top-of-book format
+ *
+ * Followed by symbol_count 8-byte symbol names (NUL padded), then records
+ * from offset header_size. record_count is 0 while the file is being written
+ * or when it went to a pipe; readers then read records up to EOF.
+ */
+struct BinaryTobHeader {
+    char magic[8];
+    uint16_t version;
+    uint16_t record_size;   // sizeof(BinaryTobRecord)
+    uint32_t header_size;   // Offset of the first record
+    uint32_t symbol_count;
+    uint32_t reserved;
+    uint64_t record_count;
+};
+
+static_assert(sizeof(BinaryTobHeader) == 32, "BinaryTobHeader is a file format");
+
+/**
+ * @brief One top-of-book update; sizes are 0 for an empty side
+ *
+ * TobRecord with symbol_id in place of the symbol name: the file names each
+ * symbol once in its header instead of in every record.
+ */
+struct BinaryTobRecord {
+    uint64_t ts_us;
+    int64_t bid_px;
+    int64_t ask_px;
+    uint32_t bid_sz;
+    uint32_t ask_sz;
+    uint32_t symbol_id;     // Index into the header's symbol table
+    uint32_t reserved;
+};
+
+static_assert(sizeof(BinaryTobRecord) == 40, "BinaryTobRecord is a file format");
+static_assert(offsetof(BinaryTobRecord, symbol_id) == offsetof(TobRecord, symbol),
+              "BinaryTobRecord and TobRecord differ only in how they name the symbol");
+
+/**
+ * @brief Build a BinaryTobRecord
+ */
+inline BinaryTobRecord make_binary_tob_record(uint64_t timestamp_us, uint32_t symbol_id,
+                                              const book::TopOfBook& tob) noexcept {
+    BinaryTobRecord record;
+    record.ts_us = timestamp_us;
+    record.bid_px = tob.best_bid_px;
+    record.ask_px = tob.best_ask_px;
+    record.bid_sz = tob.bid_sz;
+    record.ask_sz = tob.ask_sz;
+    record.symbol_id = symbol_id;
+    record.reserved = 0;
+    return record;
+}
+
+/**
+ * @brief Top of book carried by a BinaryTobRecord
+ */
+inline book::TopOfBook to_top_of_book(const BinaryTobRecord& record) noexcept {
+    book::TopOfBook tob;
+    tob.best_bid_px = record.bid_px;
+    tob.bid_sz = record.bid_sz;
+    tob.best_ask_px = record.ask_px;
+    tob.ask_sz = record.ask_sz;
+    return tob;
+}
+
+/**
+ * @brief TobRecord with the same fields as a BinaryTobRecord
+ * @param record Record to copy
+ * @param symbol Symbol that record.symbol_id refers to
+ */
+TobRecord to_tob_record(const BinaryTobRecord& record, const feed::Symbol& symbol) noexcept;
+
+/**
+ * @brief Binary publisher for top-of-book data
+ *
+ * Records are copied into a large buffer and written with one write(2) per
+ * buffer, so publishing costs a memcpy instead of price formatting.
+ */
+class BinaryTopOfBookPublisher {
+public:
+    /**
+     * @brief Create the output and write the header
+     * @param path Output file, or "-" for stdout
+     * @param symbols Symbol table; a symbol's id is its index
+     * @param buffer_bytes Write buffer size
+     * @throws std::invalid_argument if the symbol table does not fit the header
+     * @throws std::runtime_error if the file cannot be created
+     */
+    BinaryTopOfBookPublisher(const std::string& path, const std::vector<feed::Symbol>& symbols,
+                             size_t buffer_bytes = 1 << 20);
+    
+    /**
+     * @brief Flush and close (errors are ignored; call close() to see them)
+     */
+    ~BinaryTopOfBookPublisher();
+    
+    BinaryTopOfBookPublisher(const BinaryTopOfBookPublisher&) = delete;
+    BinaryTopOfBookPublisher& operator=(const BinaryTopOfBookPublisher&) = delete;
+    
+    /**
+     * @brief Append one record
+     * @param timestamp_us Timestamp in microseconds
+     * @param symbol_id Index of the symbol in the constructor's table
+     * @param tob Top of book data
+     * @throws std::runtime_error if a buffer flush fails
+     */
+    void publish(uint64_t timestamp_us, uint32_t symbol_id, const book::TopOfBook& tob) {
+        publish(make_binary_tob_record(timestamp_us, symbol_id, tob));
+    }
+    
+    /**
+     * @brief Append one prebuilt record
+     * @throws std::runtime_error if a buffer flush fails
+     */
+    void publish(const BinaryTobRecord& record) {
+        if (used_ + sizeof(BinaryTobRecord) > capacity_) {
+            flush();
+        }
+        std::memcpy(buffer_.get() + used_, &record, sizeof(record));
+        used_ += sizeof(BinaryTobRecord);
+        records_++;
+    }
+    
+    /**
+     * @brief Write buffered records out
+     * @throws std::runtime_error on a write error
+     */
+    void flush();
+    
+    /**
+     * @brief Flush, record the final count in the header (files only) and close
+     * @throws std::runtime_error on a write error
+     */
+    void close();
+    
+    /**
+     * @brief Records published so far
+     */
+    uint64_t published() const noexcept { return records_; }
+
+private:
+    int fd_ = -1;
+    bool owns_fd_ = false;
+    bool patch_count_ = false;  // Output is a file we write from the start
+    std::unique_ptr<char[]> buffer_;
+    size_t capacity_;
+    size_t used_ = 0;
+    uint64_t records_ = 0;
+    
+    void write_all(const char* data, size_t size);
+};
+
+/**
+ * @brief Reader for files written by BinaryTopOfBookPublisher
+ */
+class BinaryTobReader {
+public:
+    /**
+     * @brief Read and check the header and symbol table
+     * @param input Binary stream positioned at the start of the file
+     * @throws std::runtime_error on a bad magic, version or record size
+     */
+    explicit BinaryTobReader(std::istream& input);
+    
+    /**
+     * @brief Read the next record
+     * @param record Destination
+     * @return false at end of data (a truncated final record is ignored)
+     */
+    bool next(BinaryTobRecord& record);
+    
+    /**
+     * @brief Symbol table from the header
+     */
+    const std::vector<feed::Symbol>& symbols() const noexcept { return symbols_; }
+    
+    /**
+     * @brief Record count stored in the header (0 = unknown, read to EOF)
+     */
+    uint64_t record_count() const noexcept { return header_.record_count; }
+
+private:
+    std::istream& input_;
+    BinaryTobHeader header_;
+    std::vector<feed::Symbol> symbols_;
+    uint64_t read_ = 0;
+};
+
+} // namespace publish
@@ -0,0 +1,789 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace book {
+
+/*
+ * Level-store policies
+ *
+ * A level store holds aggregated quantity per price key for one side of the
+ * book. Compare orders keys best-first (std::greater for bids, std::less for
+ * asks). Every store provides:
+ *
+ *   explicit Store(std::pmr::memory_resource*);
+ *   bool can_hold(Key key) const;           // false if the key is out of range
+ *   void add(Key key, uint32_t qty);
+ *   void remove(Key key, uint32_t qty);     // level disappears at zero
+ *   bool empty() const;
+ *   size_t level_count() const;
+ *   Key best_price() const;                 // precondition: !empty()
+ *   uint32_t best_quantity() const;         // precondition: !empty()
+ *   void for_each(fn) const;                // fn(key, qty) -> bool, best first; false stops
+ *   void clear();
+ *
+ * Key is the comparator's argument type (level_key_t<Compare>), so a book
+ * with 32-bit ticks gets 8-byte level entries.
+ */
+
+template<typename Compare>
+struct level_key;
+
+template<typename T>
+struct level_key<std::less<T>> { using type = T; };
+
+template<typename T>
+struct level_key<std::greater<T>> { using type = T; };
+
+template<typename Compare>
+using level_key_t = typename level_key<Compare>::type;
+
+/**
+ * @brief Red-black tree of levels (std::map); O(log n) everywhere
+ */
+template<typename Compare>
+class MapLevels {
+public:
+    using Key = level_key_t<Compare>;
+    
+    explicit MapLevels(std::pmr::memory_resource* resource) : levels_(resource) {}
+    
+    bool can_hold(Key) const { return true; }
+    
+    void add(Key key, uint32_t quantity) {
+        levels_[key] += quantity;
+    }
+    
+    void remove(Key key, uint32_t quantity) {
+        auto it = levels_.find(key);
+        if (it != levels_.end()) {
+            it->second -= quantity;
+            if (it->second == 0) {
+                levels_.erase(it);
+            }
+        }
+    }
+    
+    bool empty() const { return levels_.empty(); }
+    size_t level_count() const { return levels_.size(); }
+    Key best_price() const { return levels_.begin()->first; }
+    uint32_t best_quantity() const { return levels_.begin()->second; }
+    
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const auto& [key, quantity] : levels_) {
+            if (!fn(key, quantity)) {
+                return;
+            }
+        }
+    }
+    
+    void clear() { levels_.clear(); }
+
+private:
+    std::pmr::map<Key, uint32_t, Compare> levels_;
+};
+
+/**
+ * @brief Contiguous sorted vector of levels, best price at the back
+ *
+ * Most activity happens near the top of book, so inserts and erases there
+ * move only a few elements and lookups stay within a couple of cache lines.
+ */
+template<typename Compare>
+class SortedVectorLevels {
+public:
+    using Key = level_key_t<Compare>;
+    
+    explicit SortedVectorLevels(std::pmr::memory_resource* resource) : levels_(resource) {}
+    
+    bool can_hold(Key) const { return true; }
+    
+    void add(Key key, uint32_t quantity) {
+        auto it = lower_bound(key);
+        if (it != levels_.end() && it->first == key) {
+            it->second += quantity;
+        } else {
+            levels_.emplace(it, key, quantity);
+        }
+    }
+    
+    void remove(Key key, uint32_t quantity) {
+        auto it = lower_bound(key);
+        if (it != levels_.end() && it->first == key) {
+            it->second -= quantity;
+            if (it->second == 0) {
+                levels_.erase(it);
+            }
+        }
+    }
+    
+    bool empty() const { return levels_.empty(); }
+    size_t level_count() const { return levels_.size(); }
+    Key best_price() const { return levels_.back().first; }
+    uint32_t best_quantity() const { return levels_.back().second; }
+    
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (auto it = levels_.rbegin(); it != levels_.rend(); ++it) {
+            if (!fn(it->first, it->second)) {
+                return;
+            }
+        }
+    }
+    
+    void clear() { levels_.clear(); }
+
+private:
+    using Level = std::pair<Key, uint32_t>;
+    std::pmr::vector<Level> levels_;  // worst first, best last
+    
+    typename std::pmr::vector<Level>::iterator lower_bound(Key key) {
+        // Element precedes key when key is the better price
+        return std::lower_bound(levels_.begin(), levels_.end(), key,
+                                [](const Level& level, Key k) { return Compare{}(k, level.first); });
+    }
+};
+
+/**
+ * @brief Direct-indexed price ladder: one quantity slot per tick
+ *
+ * Keys must be tick indices (see PriceGrid), not raw nano prices. Lookups are
+ * a single array access. The populated ticks may span at most MAX_SPAN;
+ * keys that would stretch them further are rejected. The allocation is
+ * capped at MAX_SPAN and moves with the populated range, so a book that
+ * drifts keeps accepting prices near its levels.
+ */
+template<typename Compare>
+class FlatLadderLevels {
+public:
+    using Key = level_key_t<Compare>;
+    
+    static constexpr int64_t MAX_SPAN = 1 << 16;
+    
+    explicit FlatLadderLevels(std::pmr::memory_resource* resource) : levels_(resource) {}
+    
+    bool can_hold(Key key) const {
+        if (count_ == 0) {
+            return true;
+        }
+        const int64_t low = std::min<int64_t>(low_ + static_cast<int64_t>(first_), key);
+        const int64_t high = std::max<int64_t>(low_ + static_cast<int64_t>(last_), key);
+        return high - low < MAX_SPAN;
+    }
+    
+    void add(Key key, uint32_t quantity) {
+        if (count_ == 0) {
+            // Re-anchor an empty ladder on the new price (all slots are already zero)
+            if (levels_.empty()) {
+                levels_.resize(INITIAL_SPAN, 0);
+            }
+            low_ = key - static_cast<int64_t>(levels_.size() / 2);
+        }
+        ensure_range(key);
+        
+        const size_t index = static_cast<size_t>(key - low_);
+        if (levels_[index] == 0) {
+            if (count_ == 0) {
+                first_ = last_ = index;
+            } else {
+                first_ = std::min(first_, index);
+                last_ = std::max(last_, index);
+            }
+            count_++;
+        }
+        levels_[index] += quantity;
+    }
+    
+    void remove(Key key, uint32_t quantity) {
+        if (count_ == 0 || key < low_ || key - low_ >= static_cast<int64_t>(levels_.size())) {
+            return;
+        }
+        const size_t index = static_cast<size_t>(key - low_);
+        if (levels_[index] == 0) {
+            return;
+        }
+        levels_[index] -= quantity;
+        if (levels_[index] == 0) {
+            count_--;
+            if (count_ > 0) {
+                // Walk in from an emptied edge to the next populated tick
+                while (levels_[first_] == 0) {
+                    first_++;
+                }
+                while (levels_[last_] == 0) {
+                    last_--;
+                }
+            }
+        }
+    }
+    
+    bool empty() const { return count_ == 0; }
+    size_t level_count() const { return count_; }
+    Key best_price() const { return static_cast<Key>(low_ + static_cast<int64_t>(best())); }
+    uint32_t best_quantity() const { return levels_[best()]; }
+    
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        size_t remaining = count_;
+        for (size_t i = best(); remaining > 0; i = DESCENDING ? i - 1 : i + 1) {
+            if (levels_[i] != 0) {
+                remaining--;
+                if (!fn(static_cast<Key>(low_ + static_cast<int64_t>(i)), levels_[i])) {
+                    return;
+                }
+            }
+        }
+    }
+    
+    void clear() {
+        std::fill(levels_.begin(), levels_.end(), 0);
+        count_ = 0;
+        first_ = last_ = 0;
+    }
+
+private:
+    static constexpr bool DESCENDING = Compare{}(1, 0);
+    static constexpr size_t INITIAL_SPAN = 1024;
+    
+    std::pmr::vector<uint32_t> levels_;
+    int64_t low_ = 0;       // tick of levels_[0]
+    size_t first_ = 0;      // index of the lowest populated tick
+    size_t last_ = 0;       // index of the highest populated tick
+    size_t count_ = 0;      // populated ticks
+    
+    size_t best() const { return DESCENDING ? last_ : first_; }
+    
+    void ensure_range(int64_t key) {
+        if (key >= low_ && key - low_ < static_cast<int64_t>(levels_.size())) {
+            return;
+        }
+        // Cover the populated ticks and key, with the slack split evenly on
+        // both sides: grows up to MAX_SPAN, otherwise just recenters
+        const int64_t low = std::min<int64_t>(low_ + static_cast<int64_t>(first_), key);
+        const int64_t high = std::max<int64_t>(low_ + static_cast<int64_t>(last_), key);
+        const size_t needed = static_cast<size_t>(high - low + 1);
+        const size_t size = std::max(needed, std::min(std::max(levels_.size(), 2 * needed),
+                                                      static_cast<size_t>(MAX_SPAN)));
+        const int64_t new_low = low - static_cast<int64_t>((size - needed) / 2);
+        
+        std::pmr::vector<uint32_t> moved(size, 0, levels_.get_allocator());
+        const size_t shift = static_cast<size_t>(low_ - new_low + static_cast<int64_t>(first_));
+        std::copy(levels_.begin() + static_cast<std::ptrdiff_t>(first_),
+                  levels_.begin() + static_cast<std::ptrdiff_t>(last_) + 1,
+                  moved.begin() + static_cast<std::ptrdiff_t>(shift));
+        last_ = shift + (last_ - first_);
+        first_ = shift;
+        low_ = new_low;
+        levels_.swap(moved);
+    }
+};
+
+/*
+ * Order-index policies
+ *
+ * An order index maps order_id -> V. Every index provides:
+ *
+ *   explicit Index(std::pmr::memory_resource*);
+ *   V* find(uint64_t id);                   // nullptr if absent
+ *   const V* find(uint64_t id) const;
+ *   bool insert(uint64_t id, const V& v);   // false if present or unrepresentable
+ *   void erase(uint64_t id);
+ *   size_t size() const;
+ *   bool empty() const;
+ *   void for_each(fn) const;                // fn(id, const V&), unspecified order
+ *   void clear();
+ */
+
+/**
+ * @brief Node-based hash map (std::unordered_map)
+ */
+template<typename V>
+class HashOrderIndex {
+public:
+    explicit HashOrderIndex(std::pmr::memory_resource* resource) : orders_(resource) {}
+    
+    V* find(uint64_t id) {
+        auto it = orders_.find(id);
+        return it == orders_.end() ? nullptr : &it->second;
+    }
+    
+    const V* find(uint64_t id) const {
+        auto it = orders_.find(id);
+        return it == orders_.end() ? nullptr : &it->second;
+    }
+    
+    bool insert(uint64_t id, const V& value) {
+        return orders_.emplace(id, value).second;
+    }
+    
+    void erase(uint64_t id) { orders_.erase(id); }
+    
+    size_t size() const { return orders_.size(); }
+    bool empty() const { return orders_.empty(); }
+    
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const auto& [id, value] : orders_) {
+            fn(id, value);
+        }
+    }
+    
+    void clear() { orders_.clear(); }
+
+private:
+    std::pmr::unordered_map<uint64_t, V> orders_;
+};
+
+/**
+ * @brief Open-addressing hash table with linear probing
+ *
+ * Slots live in one flat array (no per-order node allocation). Deletion uses
+ * backward shifting, so there are no tombstones. The id UINT64_MAX is
+ * reserved as the empty marker.
+ */
+template<typename V>
+class OpenAddressingOrderIndex {
+public:
+    explicit OpenAddressingOrderIndex(std::pmr::memory_resource* resource) : slots_(resource) {}
+    
+    V* find(uint64_t id) {
+        const size_t index = locate(id);
+        return index == NOT_FOUND ? nullptr : &slots_[index].value;
+    }
+    
+    const V* find(uint64_t id) const {
+        const size_t index = locate(id);
+        return index == NOT_FOUND ? nullptr : &slots_[index].value;
+    }
+    
+    bool insert(uint64_t id, const V& value) {
+        if (id == EMPTY) {
+            return false;
+        }
+        if ((size_ + 1) * 2 > slots_.size()) {
+            rehash(slots_.empty() ? INITIAL_CAPACITY : slots_.size() * 2);
+        }
+        for (size_t i = home(id);; i = (i + 1) & mask_) {
+            if (slots_[i].id == id) {
+                return false;
+            }
+            if (slots_[i].id == EMPTY) {
+                slots_[i].id = id;
+                slots_[i].value = value;
+                size_++;
+                return true;
+            }
+        }
+    }
+    
+    void erase(uint64_t id) {
+        size_t hole = locate(id);
+        if (hole == NOT_FOUND) {
+            return;
+        }
+        // Backward-shift the rest of the probe run into the hole
+        for (size_t i = (hole + 1) & mask_; slots_[i].id != EMPTY; i = (i + 1) & mask_) {
+            const size_t ideal = home(slots_[i].id);
+            if (((i - ideal) & mask_) >= ((i - hole) & mask_)) {
+                slots_[hole] = slots_[i];
+                hole = i;
+            }
+        }
+        slots_[hole].id = EMPTY;
+        size_--;
+    }
+    
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const auto& slot : slots_) {
+            if (slot.id != EMPTY) {
+                fn(slot.id, slot.value);
+            }
+        }
+    }
+    
+    void clear() {
+        for (auto& slot : slots_) {
+            slot.id = EMPTY;
+        }
+        size_ = 0;
+    }
+
+private:
+    static constexpr uint64_t EMPTY = ~uint64_t{0};
+    static constexpr size_t NOT_FOUND = ~size_t{0};
+    static constexpr size_t INITIAL_CAPACITY = 64;
+    
+    struct Slot {
+        uint64_t id = EMPTY;
+        V value{};
+    };
+    
+    std::pmr::vector<Slot> slots_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    int shift_ = 64;
+    
+    size_t home(uint64_t id) const {
+        // Fibonacci hashing spreads sequential ids across the table
+        return static_cast<size_t>((id * 0x9E3779B97F4A7C15ULL) >> shift_);
+    }
+    
+    size_t locate(uint64_t id) const {
+        if (size_ == 0 || id == EMPTY) {
+            return NOT_FOUND;
+        }
+        for (size_t i = home(id);; i = (i + 1) & mask_) {
+            if (slots_[i].id == id) {
+                return i;
+            }
+            if (slots_[i].id == EMPTY) {
+                return NOT_FOUND;
+            }
+        }
+    }
+    
+    void rehash(size_t capacity) {
+        std::pmr::vector<Slot> old(capacity, slots_.get_allocator());
+        old.swap(slots_);
+        mask_ = capacity - 1;
+        shift_ = 64 - std::countr_zero(capacity);
+        size_ = 0;
+        for (const auto& slot : old) {
+            if (slot.id != EMPTY) {
+                insert(slot.id, slot.value);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Segmented vector indexed by order_id - base for dense, increasing ids
+ *
+ * Ids map onto a sliding window of fixed-size segments. A segment at the low
+ * end of the window is retired (and recycled) once every order in it is gone
+ * and newer ids have moved past it. Ids that fall outside the window - below
+ * the base, or more than MAX_JUMP_SEGMENTS ahead of its end - go to a hash
+ * overflow instead, as do the stragglers of the oldest segment when the
+ * window would exceed MAX_SEGMENTS. An empty window moves to the next id
+ * outside it, and a jump moves the window (hashing what it still holds) once
+ * the overflow holds more orders than the window. A lookup in the window is
+ * one bounds check and one slot access; the overflow is only probed while it
+ * is non-empty.
+ */
+template<typename V>
+class DirectOrderIndex {
+public:
+    static constexpr size_t SEGMENT_BITS = 10;
+    static constexpr size_t SEGMENT_SIZE = size_t{1} << SEGMENT_BITS;
+    static constexpr size_t MAX_SEGMENTS = 256;         // window spans 256K ids
+    static constexpr size_t MAX_JUMP_SEGMENTS = 16;     // larger jumps are hashed
+    static constexpr size_t MAX_SPARE_SEGMENTS = 4;
+    
+    explicit DirectOrderIndex(std::pmr::memory_resource* resource)
+        : resource_(resource), segments_(resource), spare_(resource), overflow_(resource) {}
+    
+    DirectOrderIndex(const DirectOrderIndex&) = delete;
+    DirectOrderIndex& operator=(const DirectOrderIndex&) = delete;
+    
+    DirectOrderIndex(DirectOrderIndex&& other) noexcept
+        : resource_(other.resource_), segments_(other.resource_), spare_(other.resource_),
+          overflow_(other.resource_) {
+        swap(other);
+    }
+    
+    DirectOrderIndex& operator=(DirectOrderIndex&& other) noexcept {
+        if (this != &other) {
+            release();
+            if (resource_ == other.resource_) {
+                swap(other);
+            } else {
+                other.for_each([this](uint64_t id, const V& value) { insert(id, value); });
+                other.release();
+            }
+        }
+        return *this;
+    }
+    
+    ~DirectOrderIndex() { release(); }
+    
+    V* find(uint64_t id) {
+        const uint64_t offset = id - base_;  // wraps for ids below the base
+        if (offset < window_size()) {
+            Slot& slot = slot_at(offset);
+            if (slot.live) {
+                return &slot.value;
+            }
+        }
+        if (overflow_.empty()) {
+            return nullptr;
+        }
+        auto it = overflow_.find(id);
+        return it != overflow_.end() ? &it->second : nullptr;
+    }
+    
+    const V* find(uint64_t id) const {
+        return const_cast<DirectOrderIndex*>(this)->find(id);
+    }
+    
+    bool insert(uint64_t id, const V& value) {
+        uint64_t offset = id - base_;
+        if (segment_count() != 0 && offset >= window_size()) {
+            // Move the window to id when nothing in it is live, or on a jump
+            // once it holds fewer orders than the overflow; otherwise an id
+            // sequence that restarted elsewhere would be hashed for good
+            const size_t window_live = size_ - overflow_.size();
+            const bool jump = id >= base_ && (offset >> SEGMENT_BITS) - segment_count() >= MAX_JUMP_SEGMENTS;
+            if (window_live == 0 || (jump && window_live < overflow_.size())) {
+                while (segment_count() > 0) {
+                    evict_front();
+                }
+            }
+        }
+        if (segment_count() == 0) {
+            base_ = id & ~uint64_t{SEGMENT_MASK};
+            append_segment();
+        }
+        
+        offset = id - base_;
+        if (id < base_ || !extend_to(offset)) {
+            return insert_overflow(id, value);
+        }
+        offset = id - base_;  // extend_to() may have retired low segments
+        
+        if (!overflow_.empty() && overflow_.count(id) != 0) {
+            return false;
+        }
+        Segment* segment = segments_[first_ + (offset >> SEGMENT_BITS)];
+        Slot& slot = segment->slots[offset & SEGMENT_MASK];
+        if (slot.live) {
+            return false;
+        }
+        slot.value = value;
+        slot.live = true;
+        segment->live++;
+        size_++;
+        return true;
+    }
+    
+    void erase(uint64_t id) {
+        const uint64_t offset = id - base_;
+        if (offset < window_size()) {
+            Segment* segment = segments_[first_ + (offset >> SEGMENT_BITS)];
+            Slot& slot = segment->slots[offset & SEGMENT_MASK];
+            if (slot.live) {
+                slot.live = false;
+                segment->live--;
+                size_--;
+                retire_front();
+                return;
+            }
+        }
+        if (!overflow_.empty() && overflow_.erase(id) != 0) {
+            size_--;
+        }
+    }
+    
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    /**
+     * @brief Segments currently in the window
+     */
+    size_t segment_count() const { return segments_.size() - first_; }
+    
+    /**
+     * @brief Orders held in the hash overflow
+     */
+    size_t overflow_count() const { return overflow_.size(); }
+    
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (size_t s = first_; s < segments_.size(); ++s) {
+            const Segment* segment = segments_[s];
+            if (segment->live == 0) {
+                continue;
+            }
+            const uint64_t segment_base = base_ + ((s - first_) << SEGMENT_BITS);
+            for (size_t i = 0; i < SEGMENT_SIZE; ++i) {
+                if (segment->slots[i].live) {
+                    fn(segment_base + i, segment->slots[i].value);
+                }
+            }
+        }
+        for (const auto& [id, value] : overflow_) {
+            fn(id, value);
+        }
+    }
+    
+    void clear() {
+        while (segment_count() > 0) {
+            Segment* segment = segments_[first_];
+            for (size_t i = 0; segment->live > 0 && i < SEGMENT_SIZE; ++i) {
+                if (segment->slots[i].live) {
+                    segment->slots[i].live = false;
+                    segment->live--;
+                }
+            }
+            pop_front();
+        }
+        segments_.clear();
+        first_ = 0;
+        base_ = 0;
+        overflow_.clear();
+        size_ = 0;
+    }
+
+private:
+    static constexpr size_t SEGMENT_MASK = SEGMENT_SIZE - 1;
+    
+    struct Slot {
+        V value{};
+        bool live = false;
+    };
+    
+    struct Segment {
+        uint32_t live = 0;
+        Slot slots[SEGMENT_SIZE];
+    };
+    
+    std::pmr::memory_resource* resource_;
+    std::pmr::vector<Segment*> segments_;   // window is [first_, size())
+    std::pmr::vector<Segment*> spare_;      // retired segments kept for reuse
+    std::pmr::unordered_map<uint64_t, V> overflow_;
+    size_t first_ = 0;
+    uint64_t base_ = 0;                     // id of the first slot in the window
+    size_t size_ = 0;
+    
+    uint64_t window_size() const {
+        return static_cast<uint64_t>(segment_count()) << SEGMENT_BITS;
+    }
+    
+    Slot& slot_at(uint64_t offset) {
+        return segments_[first_ + (offset >> SEGMENT_BITS)]->slots[offset & SEGMENT_MASK];
+    }
+    
+    bool insert_overflow(uint64_t id, const V& value) {
+        if (!overflow_.emplace(id, value).second) {
+            return false;
+        }
+        size_++;
+        return true;
+    }
+    
+    // Grow the window so that offset is covered; false if it jumps too far
+    bool extend_to(uint64_t offset) {
+        const uint64_t segment = offset >> SEGMENT_BITS;
+        if (segment < segment_count()) {
+            return true;
+        }
+        if (segment - segment_count() >= MAX_JUMP_SEGMENTS) {
+            return false;
+        }
+        while (segment_count() <= segment) {
+            append_segment();
+        }
+        while (segment_count() > MAX_SEGMENTS) {
+            evict_front();
+        }
+        return true;
+    }
+    
+    void append_segment() {
+        Segment* segment;
+        if (!spare_.empty()) {
+            segment = spare_.back();
+            spare_.pop_back();
+        } else {
+            void* memory = resource_->allocate(sizeof(Segment), alignof(Segment));
+            segment = new (memory) Segment();
+        }
+        segments_.push_back(segment);
+    }
+    
+    // Drop fully retired segments from the low end, keeping the newest one
+    void retire_front() {
+        while (segment_count() > 1 && segments_[first_]->live == 0) {
+            pop_front();
+        }
+    }
+    
+    // Move the oldest segment's remaining orders to the overflow
+    void evict_front() {
+        Segment* segment = segments_[first_];
+        for (size_t i = 0; segment->live > 0 && i < SEGMENT_SIZE; ++i) {
+            if (segment->slots[i].live) {
+                overflow_.emplace(base_ + i, segment->slots[i].value);
+                segment->slots[i].live = false;
+                segment->live--;
+            }
+        }
+        pop_front();
+    }
+    
+    void pop_front() {
+        Segment* segment = segments_[first_];
+        segments_[first_] = nullptr;
+        first_++;
+        base_ += SEGMENT_SIZE;
+        if (spare_.size() < MAX_SPARE_SEGMENTS) {
+            spare_.push_back(segment);
+        } else {
+            destroy(segment);
+        }
+        // Compact the pointer vector once the retired prefix dominates it
+        if (first_ >= 64 && first_ * 2 >= segments_.size()) {
+            segments_.erase(segments_.begin(), segments_.begin() + static_cast<std::ptrdiff_t>(first_));
+            first_ = 0;
+        }
+    }
+    
+    void destroy(Segment* segment) {
+        segment->~Segment();
+        resource_->deallocate(segment, sizeof(Segment), alignof(Segment));
+    }
+    
+    void release() {
+        for (size_t s = first_; s < segments_.size(); ++s) {
+            destroy(segments_[s]);
+        }
+        for (Segment* segment : spare_) {
+            destroy(segment);
+        }
+        segments_.clear();
+        spare_.clear();
+        overflow_.clear();
+        first_ = 0;
+        base_ = 0;
+        size_ = 0;
+    }
+    
+    void swap(DirectOrderIndex& other) noexcept {
+        segments_.swap(other.segments_);
+        spare_.swap(other.spare_);
+        overflow_.swap(other.overflow_);
+        std::swap(first_, other.first_);
+        std::swap(base_, other.base_);
+        std::swap(size_, other.size_);
+    }
+};
+
+} // namespace book
@@ -0,0 +1,211 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <initializer_list>
+
+namespace core {
+
+/**
+ * @brief Single-producer broadcast ring where every consumer sees every element
+ * @tparam T Type of elements stored in the ring
+ *
+ * The producer publishes into one shared array and advances a cursor; each
+ * consumer keeps its own sequence (the number of elements it has released)
+ * and reads the array in place, so nothing is copied per consumer. The
+ * producer only overwrites a slot once every consumer has released it.
+ *
+ * A consumer can depend on other consumers: it then only sees an element
+ * after all of them have released it, which orders pipeline stages (e.g. the
+ * publisher after the book stage) without an extra queue between them.
+ *
+ * Register consumers with add_consumer() before any thread starts using the
+ * ring. Every slot is usable: a ring of capacity N holds N elements.
+ */
+template<typename T>
+class BroadcastRing {
+public:
+    using ConsumerId = size_t;
+
+    /**
+     * @brief Construct ring with given capacity (must be power of 2)
+     * @param capacity Ring capacity (must be power of 2)
+     */
+    explicit BroadcastRing(size_t capacity)
+        : capacity_(capacity), mask_(capacity - 1), buffer_(std::make_unique<T[]>(capacity)) {
+        assert((capacity & (capacity - 1)) == 0 && "Capacity must be power of 2");
+        assert(capacity > 0);
+    }
+
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+    /**
+     * @brief Register a consumer (not thread-safe; call before the ring is used)
+     * @param depends_on Consumers that must release an element before this
+     *        one sees it; empty to read straight behind the producer
+     * @return Id to pass to peek_batch/release
+     */
+    ConsumerId add_consumer(std::initializer_list<ConsumerId> depends_on = {}) {
+        assert(std::all_of(depends_on.begin(), depends_on.end(),
+                           [this](ConsumerId dependency) { return dependency < consumers_.size(); }) &&
+               "Dependencies must be registered first");
+        auto consumer = std::make_unique<Consumer>();
+        consumer->depends_on.assign(depends_on.begin(), depends_on.end());
+        const uint64_t start = cursor_.load(std::memory_order_relaxed);
+        consumer->sequence.store(start, std::memory_order_relaxed);
+        consumer->cached_available = start;
+        consumers_.push_back(std::move(consumer));
+        
+        // Only consumers nobody depends on can be the slowest
+        gating_.clear();
+        for (ConsumerId id = 0; id < consumers_.size(); ++id) {
+            const bool is_dependency = std::any_of(consumers_.begin(), consumers_.end(), [id](const auto& other) {
+                return std::find(other->depends_on.begin(), other->depends_on.end(), id) != other->depends_on.end();
+            });
+            if (!is_dependency) {
+                gating_.push_back(consumers_[id].get());
+            }
+        }
+        cached_gate_ = start;
+        return consumers_.size() - 1;
+    }
+
+    /**
+     * @brief Claim up to max contiguous slots for writing (producer side)
+     *
+     * Never blocks: the span is shorter than max when the slowest consumer
+     * has not released enough slots, and stops at the end of the array.
+     *
+     * @param max Maximum number of slots to claim
+     * @return Claimed slots; empty if the ring is full
+     */
+    std::span<T> claim_batch(size_t max) noexcept {
+        const uint64_t head = next_;
+        if (capacity_ - static_cast<size_t>(head - cached_gate_) < max) {
+            cached_gate_ = slowest_consumer();
+        }
+        const size_t free_slots = capacity_ - static_cast<size_t>(head - cached_gate_);
+        const size_t index = static_cast<size_t>(head) & mask_;
+        const size_t count = std::min({max, free_slots, capacity_ - index});
+        return std::span<T>(&buffer_[index], count);
+    }
+
+    /**
+     * @brief Publish the first count claimed slots to consumers (producer side)
+     * @param count Number of slots to publish
+     */
+    void commit(size_t count = 1) noexcept {
+        next_ += count;
+        cursor_.store(next_, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy one element in and publish it (producer side)
+     * @param item Item to push
+     * @return true if successful, false if the ring is full
+     */
+    bool try_push(const T& item) noexcept {
+        std::span<T> slot = claim_batch(1);
+        if (slot.empty()) {
+            return false;
+        }
+        slot[0] = item;
+        commit(1);
+        return true;
+    }
+
+    /**
+     * @brief View up to max contiguous elements this consumer has not released
+     * @param consumer Consumer id (each id is used by one thread)
+     * @param max Maximum number of elements to view
+     * @return Elements in publish order; empty if none are available yet
+     */
+    std::span<const T> peek_batch(ConsumerId consumer, size_t max) noexcept {
+        Consumer& self = *consumers_[consumer];
+        const uint64_t next = self.sequence.load(std::memory_order_relaxed);
+        if (self.cached_available <= next) {
+            self.cached_available = barrier(self);
+        }
+        const size_t index = static_cast<size_t>(next) & mask_;
+        const size_t count = std::min({max, static_cast<size_t>(self.cached_available - next), capacity_ - index});
+        return std::span<const T>(&buffer_[index], count);
+    }
+
+    /**
+     * @brief Release the first count viewed elements
+     * @param consumer Consumer id
+     * @param count Number of elements to release
+     */
+    void release(ConsumerId consumer, size_t count = 1) noexcept {
+        Consumer& self = *consumers_[consumer];
+        self.sequence.store(self.sequence.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /**
+     * @brief Number of elements published so far
+     */
+    uint64_t cursor() const noexcept {
+        return cursor_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Number of elements a consumer has released so far
+     */
+    uint64_t sequence(ConsumerId consumer) const noexcept {
+        return consumers_[consumer]->sequence.load(std::memory_order_acquire);
+    }
+
+    size_t consumer_count() const noexcept {
+        return consumers_.size();
+    }
+
+    size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+    struct alignas(64) Consumer {
+        std::atomic<uint64_t> sequence{0};
+        uint64_t cached_available = 0;  // Owned by the consumer thread
+        std::vector<ConsumerId> depends_on;
+    };
+    
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> buffer_;
+    std::vector<std::unique_ptr<Consumer>> consumers_;
+    std::vector<const Consumer*> gating_;
+    
+    alignas(64) std::atomic<uint64_t> cursor_{0};  // Published elements
+    alignas(64) uint64_t next_ = 0;                // Producer-owned copy of cursor_
+    uint64_t cached_gate_ = 0;                     // Last seen slowest consumer
+    
+    uint64_t slowest_consumer() const noexcept {
+        uint64_t slowest = next_;
+        for (const Consumer* consumer : gating_) {
+            slowest = std::min(slowest, consumer->sequence.load(std::memory_order_acquire));
+        }
+        return slowest;
+    }
+
+    uint64_t barrier(const Consumer& self) const noexcept {
+        uint64_t available = cursor_.load(std::memory_order_acquire);
+        for (ConsumerId dependency : self.depends_on) {
+            available = std::min(available, consumers_[dependency]->sequence.load(std::memory_order_acquire));
+        }
+        return available;
+    }
+};
+
+} // namespace core
@@ -0,0 +1,229 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "ring_buffer.hpp"
+#include <atomic>
+#include <memory>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace core {
+
+/**
+ * @brief Lock-free single-producer single-consumer ring of variable-length messages
+ *
+ * Messages are stored back to back as frames: a 4-byte length followed by
+ * the payload, padded to 4 bytes. A frame never straddles the end of the
+ * array; when it does not fit, the producer writes a wrap marker in place of
+ * a length and starts the frame at offset 0, so every payload the consumer
+ * sees is contiguous.
+ *
+ * Compared with RingBuffer<feed::Event>, a raw wire message only costs its
+ * own size plus the frame header instead of a full Event slot.
+ */
+class ByteRing {
+public:
+    /**
+     * @brief Construct ring with given size in bytes (must be power of 2)
+     * @param capacity Ring size in bytes (must be power of 2, at least 8)
+     */
+    explicit ByteRing(size_t capacity)
+        : capacity_(capacity), mask_(capacity - 1), buffer_(std::make_unique<char[]>(capacity)) {
+        assert((capacity & (capacity - 1)) == 0 && "Capacity must be power of 2");
+        assert(capacity >= 8);
+    }
+
+    ByteRing(const ByteRing&) = delete;
+    ByteRing& operator=(const ByteRing&) = delete;
+
+    /**
+     * @brief Reserve room for one message (producer side)
+     *
+     * Several messages can be claimed before a single commit() publishes
+     * them all. A frame may take at most half the ring, so a wrapped frame
+     * always fits once the consumer has caught up.
+     *
+     * @param length Payload length in bytes
+     * @return Contiguous space for the payload, or nullptr if the ring is full
+     */
+    char* try_claim(size_t length) noexcept {
+        assert(frame_size(length) <= capacity_ / 2 && "Message too large for ring");
+        const size_t frame = frame_size(length);
+        const size_t offset = claim_ & mask_;
+        const size_t to_end = capacity_ - offset;
+        const size_t needed = frame <= to_end ? frame : to_end + frame;
+        
+        if (claim_ + needed - cached_head_ > capacity_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (claim_ + needed - cached_head_ > capacity_) {
+                count(full_spins_);
+                return nullptr; // Ring is full
+            }
+        }
+        
+        if (frame > to_end) {
+            write_header(offset, WRAP_MARKER);
+            claim_ += to_end;
+        }
+        write_header(claim_ & mask_, static_cast<uint32_t>(length));
+        char* payload = &buffer_[(claim_ & mask_) + HEADER_SIZE];
+        claim_ += frame;
+        claimed_++;
+        return payload;
+    }
+
+    /**
+     * @brief Publish every message claimed since the last commit (producer side)
+     */
+    void commit() noexcept {
+        tail_.store(claim_, std::memory_order_release);
+        count(pushes_, claimed_);
+        claimed_ = 0;
+        // A fresh head: the cached one may be many frames stale
+        cached_head_ = head_.load(std::memory_order_acquire);
+        const size_t occupancy = static_cast<size_t>(claim_ - cached_head_);
+        if (occupancy > high_water_.load(std::memory_order_relaxed)) {
+            high_water_.store(occupancy, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Copy one message in and publish it (producer side)
+     * @param data Message bytes
+     * @param length Message length in bytes
+     * @return true if successful, false if the ring is full
+     */
+    bool try_push(const char* data, size_t length) noexcept {
+        char* payload = try_claim(length);
+        if (payload == nullptr) {
+            return false;
+        }
+        std::memcpy(payload, data, length);
+        commit();
+        return true;
+    }
+
+    /**
+     * @brief View the oldest message without removing it (consumer side)
+     * @return Message payload, valid until release(); empty if the ring is empty
+     */
+    std::span<const char> peek() noexcept {
+        if (read_ == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (read_ == cached_tail_) {
+                count(empty_spins_);
+                return {};
+            }
+        }
+        
+        uint32_t length = read_header(read_ & mask_);
+        if (length == WRAP_MARKER) {
+            // The wrapped frame was committed together with its marker
+            read_ += capacity_ - (read_ & mask_);
+            length = read_header(0);
+        }
+        peeked_frame_ = frame_size(length);
+        return std::span<const char>(&buffer_[(read_ & mask_) + HEADER_SIZE], length);
+    }
+
+    /**
+     * @brief Remove the message returned by the last peek() (consumer side)
+     */
+    void release() noexcept {
+        read_ += peeked_frame_;
+        peeked_frame_ = 0;
+        head_.store(read_, std::memory_order_release);
+        count(pops_);
+    }
+
+    /**
+     * @brief Check if ring is empty (approximate under concurrency)
+     * @return true if empty
+     */
+    bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Bytes currently occupied by frames (approximate under concurrency)
+     */
+    size_t used_bytes() const noexcept {
+        return static_cast<size_t>(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Get ring size in bytes
+     * @return Ring size in bytes
+     */
+    size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    /**
+     * @brief Read the telemetry counters (any thread)
+     * @return Counters since construction; high_water is in bytes
+     */
+    RingStats stats() const noexcept {
+        RingStats stats;
+        stats.pushes = pushes_.load(std::memory_order_relaxed);
+        stats.full_spins = full_spins_.load(std::memory_order_relaxed);
+        stats.high_water = high_water_.load(std::memory_order_relaxed);
+        stats.pops = pops_.load(std::memory_order_relaxed);
+        stats.empty_spins = empty_spins_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /**
+     * @brief Bytes a message of the given length occupies in the ring
+     */
+    static constexpr size_t frame_size(size_t length) noexcept {
+        return (HEADER_SIZE + length + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+private:
+    static constexpr size_t HEADER_SIZE = sizeof(uint32_t);
+    static constexpr size_t ALIGNMENT = 4;
+    static constexpr uint32_t WRAP_MARKER = UINT32_MAX;
+    
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<char[]> buffer_;
+    
+    // Byte counters only ever grow; offsets are counter & mask_
+    alignas(64) std::atomic<uint64_t> head_{0};  // Consumer position
+    alignas(64) std::atomic<uint64_t> tail_{0};  // Producer position
+    alignas(64) uint64_t claim_ = 0;             // Producer: end of claimed frames
+    uint64_t cached_head_ = 0;                   // Producer: last seen head_
+    uint64_t claimed_ = 0;                       // Producer: frames since last commit
+    std::atomic<uint64_t> pushes_{0};
+    std::atomic<uint64_t> full_spins_{0};
+    std::atomic<size_t> high_water_{0};
+    alignas(64) uint64_t read_ = 0;              // Consumer: start of next frame
+    uint64_t cached_tail_ = 0;                   // Consumer: last seen tail_
+    size_t peeked_frame_ = 0;
+    std::atomic<uint64_t> pops_{0};
+    std::atomic<uint64_t> empty_spins_{0};
+    
+    // Single-writer counters: a plain load and store, no read-modify-write
+    static void count(std::atomic<uint64_t>& counter, uint64_t n = 1) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void write_header(size_t offset, uint32_t value) noexcept {
+        std::memcpy(&buffer_[offset], &value, HEADER_SIZE);
+    }
+
+    uint32_t read_header(size_t offset) const noexcept {
+        uint32_t value;
+        std::memcpy(&value, &buffer_[offset], HEADER_SIZE);
+        return value;
+    }
+};
+
+} // namespace core
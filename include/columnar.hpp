@@ -0,0 +1,269 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "messages.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace publish {
+
+/**
+ * Columnar history files
+ *
+ * A file is a 16-byte header, then row groups, then a footer:
+ *
+ *   ColumnarFileHeader
+ *   row group 0: column 0 chunk, column 1 chunk, ...
+ *   row group 1: ...
+ *   footer: ColumnarFooter, ColumnarColumnInfo x columns, 8-byte symbol
+ *           names x symbols, then per row group its row count (uint64) and
+ *           ColumnarChunkInfo x columns
+ *   ColumnarTrailer (footer offset + magic)
+ *
+ * Every chunk is a run of LEB128 varints: zigzag values (VARINT) or zigzag
+ * differences from the previous value in the chunk, starting from 0
+ * (DELTA_VARINT). Chunks decode on their own, so a reader only touches the
+ * bytes of the columns it scans.
+ */
+
+constexpr char COLUMNAR_MAGIC[8] = {'M', 'F', 'C', 'O', 'L', '\0', '\0', '\0'};
+constexpr uint16_t COLUMNAR_VERSION = 1;
+
+enum class ColumnEncoding : uint8_t {
+    VARINT = 0,         // Small or uncorrelated values (sizes, ids)
+    DELTA_VARINT = 1    // Slowly changing values (timestamps, prices)
+};
+
+struct ColumnSpec {
+    std::string name;   // At most 15 characters
+    ColumnEncoding encoding;
+};
+
+struct ColumnarFileHeader {
+    char magic[8];
+    uint16_t version;
+    uint16_t reserved[3];
+};
+
+struct ColumnarFooter {
+    uint32_t column_count;
+    uint32_t symbol_count;
+    uint64_t row_group_count;
+    uint64_t row_count;
+};
+
+struct ColumnarColumnInfo {
+    char name[16];      // NUL padded
+    uint8_t encoding;
+    uint8_t reserved[7];
+};
+
+struct ColumnarChunkInfo {
+    uint64_t offset;    // From the start of the file
+    uint64_t size;      // Encoded bytes
+    int64_t min;
+    int64_t max;
+};
+
+struct ColumnarTrailer {
+    uint64_t footer_offset;
+    char magic[8];
+};
+
+static_assert(sizeof(ColumnarFileHeader) == 16, "ColumnarFileHeader is a file format");
+static_assert(sizeof(ColumnarFooter) == 24, "ColumnarFooter is a file format");
+static_assert(sizeof(ColumnarColumnInfo) == 24, "ColumnarColumnInfo is a file format");
+static_assert(sizeof(ColumnarChunkInfo) == 32, "ColumnarChunkInfo is a file format");
+static_assert(sizeof(ColumnarTrailer) == 16, "ColumnarTrailer is a file format");
+
+inline uint64_t zigzag_encode(int64_t value) noexcept {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t value) noexcept {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/**
+ * @brief Append value as a LEB128 varint (1-10 bytes)
+ */
+inline void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Read one LEB128 varint
+ * @return Position after the varint, or nullptr if it runs past end or is
+ *         longer than 10 bytes
+ */
+inline const uint8_t* get_varint(const uint8_t* data, const uint8_t* end, uint64_t& value) noexcept {
+    value = 0;
+    for (unsigned shift = 0; data < end && shift < 64; shift += 7) {
+        const uint8_t byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return data;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Columns of a top-of-book history: ts_us, symbol_id, bid_px, bid_sz,
+ *        ask_px, ask_sz
+ */
+std::vector<ColumnSpec> columnar_tob_columns();
+
+/**
+ * @brief Columns of a depth history, one row per price level: ts_us,
+ *        symbol_id, side (0 bid, 1 ask), level (0 = best), price, quantity
+ */
+std::vector<ColumnSpec> columnar_depth_columns();
+
+/**
+ * @brief Buffers rows into per-column blocks and writes them as row groups
+ */
+class ColumnarWriter {
+public:
+    /**
+     * @brief Create the file and write its header
+     * @param path Output file
+     * @param columns Schema; every row has one int64 per column
+     * @param symbols Symbol table stored in the footer (symbol_id = index)
+     * @param rows_per_group Rows buffered before a row group is written
+     * @throws std::runtime_error if the file cannot be created
+     * @throws std::invalid_argument on an empty schema or a column name over 15 characters
+     */
+    ColumnarWriter(const std::string& path, std::vector<ColumnSpec> columns, const std::vector<feed::Symbol>& symbols,
+                   size_t rows_per_group = 65536);
+    
+    /**
+     * @brief Close if still open (errors are ignored; call close() to see them)
+     */
+    ~ColumnarWriter();
+    
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+    
+    /**
+     * @brief Buffer one row
+     * @param row One value per column, in schema order
+     * @throws std::runtime_error if a full row group cannot be written
+     */
+    void append(std::span<const int64_t> row) {
+        for (size_t column = 0; column < buffers_.size(); ++column) {
+            buffers_[column].push_back(row[column]);
+        }
+        if (buffers_[0].size() == rows_per_group_) {
+            write_group();
+        }
+    }
+    
+    /**
+     * @brief Write the last row group and the footer, then close the file
+     * @throws std::runtime_error on a write error
+     */
+    void close();
+    
+    /**
+     * @brief Rows appended so far
+     */
+    uint64_t rows() const noexcept { return rows_written_ + buffers_[0].size(); }
+    
+    /**
+     * @brief Row groups written so far
+     */
+    uint64_t row_groups() const noexcept { return group_rows_.size(); }
+    
+    /**
+     * @brief Bytes written so far
+     */
+    uint64_t bytes_written() const noexcept { return offset_; }
+
+private:
+    int fd_ = -1;
+    std::vector<ColumnSpec> columns_;
+    std::vector<feed::Symbol> symbols_;
+    const size_t rows_per_group_;
+    std::vector<std::vector<int64_t>> buffers_;
+    std::vector<uint8_t> encoded_;
+    std::vector<uint64_t> group_rows_;
+    std::vector<ColumnarChunkInfo> chunks_;  // group-major
+    uint64_t rows_written_ = 0;
+    uint64_t offset_ = 0;
+    
+    void write_group();
+    void write_all(const void* data, size_t size);
+};
+
+/**
+ * @brief Memory-maps a columnar file and decodes single columns
+ */
+class ColumnarReader {
+public:
+    /**
+     * @brief Map the file and read its footer
+     * @throws std::runtime_error if the file is missing, truncated or not a columnar file
+     */
+    explicit ColumnarReader(const std::string& path);
+    
+    ~ColumnarReader();
+    
+    ColumnarReader(const ColumnarReader&) = delete;
+    ColumnarReader& operator=(const ColumnarReader&) = delete;
+    
+    const std::vector<ColumnSpec>& columns() const noexcept { return columns_; }
+    const std::vector<feed::Symbol>& symbols() const noexcept { return symbols_; }
+    size_t row_group_count() const noexcept { return group_rows_.size(); }
+    uint64_t row_count() const noexcept { return row_count_; }
+    uint64_t group_rows(size_t group) const noexcept { return group_rows_[group]; }
+    
+    /**
+     * @brief Index of a column by name
+     * @throws std::out_of_range if there is no such column
+     */
+    size_t column_index(const std::string& name) const;
+    
+    /**
+     * @brief Location and min/max of one chunk
+     */
+    const ColumnarChunkInfo& chunk(size_t group, size_t column) const noexcept {
+        return chunks_[group * columns_.size() + column];
+    }
+    
+    /**
+     * @brief Encoded bytes of one chunk, in place
+     */
+    std::span<const uint8_t> chunk_bytes(size_t group, size_t column) const noexcept {
+        const ColumnarChunkInfo& info = chunk(group, column);
+        return std::span<const uint8_t>(data_ + info.offset, info.size);
+    }
+    
+    /**
+     * @brief Decode one chunk
+     * @param out Replaced by the chunk's values
+     * @throws std::runtime_error if the chunk is corrupt
+     */
+    void read_column(size_t group, size_t column, std::vector<int64_t>& out) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<ColumnSpec> columns_;
+    std::vector<feed::Symbol> symbols_;
+    std::vector<uint64_t> group_rows_;
+    std::vector<ColumnarChunkInfo> chunks_;
+    uint64_t row_count_ = 0;
+};
+
+} // namespace publish
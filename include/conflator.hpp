@@ -0,0 +1,116 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "messages.hpp"
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <unordered_map>
+
+namespace feed {
+
+/**
+ * @brief Merges order events into their net effect on the book
+ *
+ * Used when the consumer falls behind: instead of queueing every event, the
+ * producer keeps one entry per order id with at most three pending events -
+ * a DELETE of the resting order, a new ADD, and one net change - and emits
+ * entries in the order they were opened once the ring has room.
+ *
+ * - MODIFY is absolute, so it replaces an earlier MODIFY or EXECUTE; an
+ *   EXECUTE after a MODIFY shrinks it, EXECUTEs in a row are summed.
+ * - DELETE drops the pending ADD and change; an ADD followed by DELETE
+ *   cancels out entirely.
+ * - ADDs are kept verbatim, so the book still rejects a crossing ADD and
+ *   every later change to it, as it would without conflation.
+ *
+ * Merging moves an event forward to its entry's place in the queue, past
+ * the other orders' events in between. The book's crossing checks only
+ * look at the opposite side, so that is safe unless one of those events
+ * touched the order's opposite side (either side while the order's side is
+ * unknown, i.e. no ADD for it was seen). In that case the entry is closed
+ * as it stands and the order's new event opens a fresh entry at the back.
+ *
+ * For events the book accepts, applying the drained events leaves the same
+ * book as applying the originals. Intermediate states no other event could
+ * observe and individual executions are lost by design.
+ */
+class EventConflator {
+public:
+    /**
+     * @brief Merge one decoded event
+     * @param event Valid ADD/MODIFY/EXECUTE/DELETE event
+     */
+    void add(const Event& event);
+    
+    /**
+     * @brief Move up to out.size() net events into out, oldest first
+     * @param out Destination slots (e.g. from RingBuffer::claim_batch)
+     * @return Number of events written
+     */
+    size_t drain(std::span<Event> out);
+    
+    /**
+     * @brief Check whether any net events are pending
+     */
+    bool empty() const noexcept { return live_ == 0; }
+    
+    /**
+     * @brief Number of entries with pending events (an order may have several)
+     */
+    size_t size() const noexcept { return live_; }
+    
+    /**
+     * @brief Events merged in so far
+     */
+    uint64_t events_in() const noexcept { return events_in_; }
+    
+    /**
+     * @brief Net events drained so far
+     */
+    uint64_t events_out() const noexcept { return events_out_; }
+
+private:
+    static constexpr int UNKNOWN_SIDE = -1;
+    
+    struct Pending {
+        uint64_t order_id = 0;
+        uint64_t opened = 0;    // Index of the event that opened the entry
+        uint64_t last = 0;      // Index of the entry's latest event
+        int side = UNKNOWN_SIDE;  // 0 = buy, 1 = sell
+        bool live = false;      // Holds at least one event
+        Event remove;  // DELETE of the order resting in the book, INVALID if none
+        Event add;     // New ADD, INVALID if none
+        Event change;  // Net MODIFY/EXECUTE, INVALID if none
+    };
+    
+    std::deque<Pending> queue_;                         // Drain order; references stay valid
+    std::unordered_map<uint64_t, Pending*> open_;       // Order id -> entry still accepting merges
+    uint64_t event_index_ = 0;
+    uint64_t last_touch_[2] = {0, 0};                   // Index of the latest event per side
+    size_t live_ = 0;
+    uint64_t events_in_ = 0;
+    uint64_t events_out_ = 0;
+    
+    Pending& open(uint64_t order_id, int side);
+    bool touched_since_open(const Pending& pending) const noexcept;
+    void merge(Pending& pending, const Event& event);
+    void on_delete(Pending& pending, const Event& remove);
+    void update_live(Pending& pending) noexcept;
+};
+
+/**
+ * @brief Order id of any order event
+ */
+uint64_t event_order_id(const Event& event) noexcept;
+
+/**
+ * @brief Feed timestamp of any order event (0 for other events)
+ */
+uint64_t event_timestamp(const Event& event) noexcept;
+
+} // namespace feed
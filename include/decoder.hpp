@@ -48,6 +48,14 @@ public:
      */
     size_t size() const noexcept { return file_size_; }
     
+    /**
+     * @brief Get the raw bytes of the mapped file
+     * @return Every byte of the file, valid for the decoder's lifetime
+     */
+    std::span<const char> data() const noexcept {
+        return std::span<const char>(static_cast<const char*>(mapped_data_), file_size_);
+    }
+    
     /**
      * @brief Get current position in file
      * @return Current offset in bytes
@@ -66,10 +74,54 @@ public:
      */
     Event next();
     
+    /**
+     * @brief Decode the next message directly into caller-owned storage
+     *
+     * Lets the producer decode straight into a claimed ring-buffer slot
+     * instead of building an Event on the stack and copying it in.
+     *
+     * @param event Destination; on failure only its type is meaningful
+     * @return true if a valid message was decoded, false on error/EOF
+     */
+    bool next_into(Event& event);
+    
+    /**
+     * @brief Return the next message's wire bytes without decoding them
+     *
+     * Unknown bytes are skipped as in next(); a truncated final message is
+     * skipped to the end of the file. The bytes are not validated, see
+     * decode().
+     *
+     * @return View into the mapped file; empty at EOF
+     */
+    std::span<const char> next_raw() noexcept;
+    
+    /**
+     * @brief Decode and validate one message returned by next_raw()
+     * @param raw Wire bytes of exactly one message
+     * @param event Destination; decode_timestamp_us is left unchanged
+     * @return false if the message is malformed
+     */
+    static bool decode(std::span<const char> raw, Event& event) noexcept;
+    
+    /**
+     * @brief Wire size of a message type
+     * @param type Message type byte ('A', 'U', 'E' or 'D')
+     * @return Size in bytes, or 0 for an unknown type
+     */
+    static size_t message_size(char type) noexcept;
+    
     /**
      * @brief Reset decoder to beginning of file
      */
     void reset() noexcept;
+    
+    /**
+     * @brief Move decoder to an absolute byte offset (e.g. from a checkpoint)
+     * @param offset Offset of the next message; must not exceed size()
+     * @throws std::out_of_range if offset is past the end of the file
+     */
+    void seek(size_t offset);
 
 private:
     void* mapped_data_;
@@ -79,6 +131,9 @@ private:
     
     template<typename T>
     bool read_message(Event& event);
+    
+    template<typename T>
+    static bool decode_message(const char* data, Event& event) noexcept;
 };
 
 } // namespace feed
@@ -0,0 +1,119 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "order_book.hpp"
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <vector>
+
+namespace book {
+
+/**
+ * @brief Immutable full-depth view of one book
+ */
+struct DepthSnapshot {
+    uint64_t version = 0;           // 1 for the first snapshot, then counting up
+    uint64_t ts_us = 0;             // Writer timestamp when the snapshot was taken
+    std::vector<PriceLevel> bids;   // Best (highest) price first
+    std::vector<PriceLevel> asks;   // Best (lowest) price first
+};
+
+/**
+ * @brief Hands full-depth snapshots from the book thread to reader threads
+ *
+ * RCU-style: a reader takes a request() ticket, the book thread builds a
+ * snapshot at its next check and swaps it in with a single atomic store, and
+ * readers take a shared_ptr to whatever is current. A snapshot is immutable once published
+ * and is freed when the last reader drops it, so readers never block the
+ * writer and never see a half-applied update. When nobody asks, the feed
+ * path pays one relaxed load per check.
+ *
+ * Snapshot vectors use the global heap, never the book's arena, because
+ * readers free them on their own threads.
+ */
+class DepthPublisher {
+public:
+    /**
+     * @brief Ask the book thread for a fresh snapshot (any thread)
+     * @return Ticket; ready(ticket) turns true once a snapshot taken after
+     *         this call is published
+     */
+    uint64_t request() noexcept {
+        return requests_.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    
+    /**
+     * @brief Whether the snapshot for a request() ticket is available (any thread)
+     */
+    bool ready(uint64_t ticket) const noexcept {
+        return served_.load(std::memory_order_acquire) >= ticket;
+    }
+    
+    /**
+     * @brief Current snapshot (any thread)
+     * @return Latest published snapshot, or nullptr before the first one
+     */
+    std::shared_ptr<const DepthSnapshot> snapshot() const noexcept {
+        return current_.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Whether a reader is waiting for a snapshot (book thread)
+     */
+    bool wanted() const noexcept {
+        return requests_.load(std::memory_order_relaxed) != served_.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Build and publish a snapshot of book (book thread)
+     * @param book Book to copy
+     * @param ts_us Timestamp stored in the snapshot
+     * @param max_levels Levels per side to copy; 0 = all
+     */
+    template<typename Book>
+    void publish(const Book& book, uint64_t ts_us, size_t max_levels = 0) {
+        // Requests made from here on need a later snapshot
+        const uint64_t requests = requests_.load(std::memory_order_relaxed);
+        
+        auto next = std::make_shared<DepthSnapshot>();
+        next->version = ++version_;
+        next->ts_us = ts_us;
+        auto copy_side = [max_levels](std::vector<PriceLevel>& levels) {
+            return [&levels, max_levels](int64_t price, uint32_t quantity) {
+                levels.emplace_back(price, quantity);
+                return max_levels == 0 || levels.size() < max_levels;
+            };
+        };
+        book.for_each_level(Side::BUY, copy_side(next->bids));
+        book.for_each_level(Side::SELL, copy_side(next->asks));
+        
+        current_.store(std::shared_ptr<const DepthSnapshot>(std::move(next)), std::memory_order_release);
+        served_.store(requests, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Publish only if a reader asked (book thread)
+     * @return true if a snapshot was published
+     */
+    template<typename Book>
+    bool publish_if_wanted(const Book& book, uint64_t ts_us, size_t max_levels = 0) {
+        if (!wanted()) {
+            return false;
+        }
+        publish(book, ts_us, max_levels);
+        return true;
+    }
+
+private:
+    std::atomic<std::shared_ptr<const DepthSnapshot>> current_;
+    alignas(64) std::atomic<uint64_t> served_{0};    // Requests covered by current_
+    uint64_t version_ = 0;                           // Book thread only
+    alignas(64) std::atomic<uint64_t> requests_{0};  // Written by readers
+};
+
+} // namespace book
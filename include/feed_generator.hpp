@@ -0,0 +1,129 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "messages.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace feed {
+
+/**
+ * @brief Shape of a generated feed
+ */
+enum class SimProfile {
+    UNIFORM,    // Symbols equally active, prices uniform within ±5% of $100
+    REALISTIC   // Zipf activity, tick-grid books around a random-walk mid, bursts
+};
+
+/**
+ * @brief Parse a profile name ("uniform" or "realistic")
+ * @return false if the name is unknown
+ */
+bool parse_sim_profile(const std::string& name, SimProfile& profile);
+
+/**
+ * @brief Generator settings
+ */
+struct SimConfig {
+    std::vector<std::string> symbols;
+    uint64_t seed = 1;
+    uint64_t start_us = 34200000000ULL;   // 09:30:00 as microseconds since midnight
+    size_t threads = 1;
+    SimProfile profile = SimProfile::UNIFORM;
+};
+
+/**
+ * @brief Appends messages to a large buffer and writes it out in big chunks
+ */
+class FeedWriter {
+public:
+    /**
+     * @brief Create (or truncate) the output file
+     * @throws std::runtime_error if the file cannot be created
+     */
+    explicit FeedWriter(const std::string& path, size_t buffer_bytes = 8 << 20);
+    ~FeedWriter();
+    
+    FeedWriter(const FeedWriter&) = delete;
+    FeedWriter& operator=(const FeedWriter&) = delete;
+    
+    /**
+     * @brief Append bytes (at most the buffer size at a time)
+     */
+    void append(const char* data, size_t size);
+    
+    /**
+     * @brief Write everything buffered and close the file
+     * @throws std::runtime_error on a write error
+     */
+    void close();
+    
+    uint64_t bytes_written() const { return written_ + used_; }
+
+private:
+    int fd_ = -1;
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    uint64_t written_ = 0;
+    
+    void flush();
+};
+
+class SymbolStream;
+
+/**
+ * @brief Synthetic feed generator
+ *
+ * Every symbol is an independent stream with its own generator, seeded from
+ * the seed and the symbol's index, and its own clock. Streams are generated
+ * in parallel, one window of feed time at a time, and merged into one file
+ * ordered by (ts_us, symbol index). Threads fill window k + 1 while the
+ * calling thread merges window k; symbol i always runs on thread
+ * i % threads, so the file is the same for any thread count.
+ *
+ * Order ids are sequence * symbols + index + 1: unique across streams
+ * without any sharing between threads.
+ */
+class FeedGenerator {
+public:
+    static constexpr uint64_t WINDOW_US = 100000;  // Feed time per merge window
+    
+    /**
+     * @brief Constructor
+     * @throws std::invalid_argument if config has no symbols
+     */
+    explicit FeedGenerator(const SimConfig& config);
+    ~FeedGenerator();
+    
+    FeedGenerator(const FeedGenerator&) = delete;
+    FeedGenerator& operator=(const FeedGenerator&) = delete;
+    
+    /**
+     * @brief Write the next num_messages messages of the merged feed
+     */
+    void generate(FeedWriter& output, uint64_t num_messages);
+
+private:
+    using Window = std::vector<std::vector<char>>;  // Packed messages per symbol
+    
+    size_t threads_;
+    std::vector<std::unique_ptr<SymbolStream>> streams_;
+    Window windows_[2];
+    size_t current_ = 0;            // Window being merged
+    bool current_ready_ = false;
+    bool next_ready_ = false;
+    std::vector<size_t> offsets_;   // Merge position per symbol in the current window
+    uint64_t filled_until_us_;      // End of the last window handed to the threads
+    
+    std::vector<std::thread> start_fill(Window& window);
+    bool merge(FeedWriter& output, uint64_t limit, uint64_t& written);
+};
+
+} // namespace feed
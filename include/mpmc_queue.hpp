@@ -0,0 +1,251 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace core {
+
+/**
+ * @brief Bounded lock-free queue with per-slot sequence numbers
+ * @tparam T Type of elements stored in the queue
+ * @tparam MultiConsumer true for many consumers (MPMC), false for one (MPSC)
+ *
+ * Each slot carries a sequence number that says whose turn it is: a slot at
+ * position p is free for the producer of p when sequence == p, and holds data
+ * for the consumer of p when sequence == p + 1. Producers claim positions
+ * with one CAS on the enqueue counter and then touch only their own slots,
+ * so there is no shared lock or per-element CAS on a common word. With a
+ * single consumer the dequeue counter is a plain owned index.
+ *
+ * Unlike RingBuffer, every slot is usable: a queue of capacity N holds N
+ * elements.
+ */
+template<typename T, bool MultiConsumer>
+class BoundedQueue {
+public:
+    /**
+     * @brief Construct queue with given capacity (must be power of 2)
+     * @param capacity Queue capacity (must be power of 2)
+     */
+    explicit BoundedQueue(size_t capacity)
+        : capacity_(capacity), mask_(capacity - 1), cells_(std::make_unique<Cell[]>(capacity)) {
+        assert((capacity & (capacity - 1)) == 0 && "Capacity must be power of 2");
+        assert(capacity > 0);
+        for (size_t i = 0; i < capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Try to push an element (any producer)
+     * @param item Item to push
+     * @return true if successful, false if queue is full
+     */
+    bool try_push(const T& item) noexcept {
+        return emplace_one([&](T& slot) { slot = item; });
+    }
+
+    /**
+     * @brief Try to push an element using move semantics (any producer)
+     * @param item Item to push
+     * @return true if successful, false if queue is full
+     */
+    bool try_push(T&& item) noexcept {
+        return emplace_one([&](T& slot) { slot = std::move(item); });
+    }
+
+    /**
+     * @brief Push up to count elements with a single position claim
+     *
+     * Elements from one batch occupy consecutive positions, so a consumer sees
+     * them in order and uninterleaved with other producers.
+     *
+     * @param items Items to push
+     * @param count Number of items
+     * @return Number of items pushed (a prefix of items); 0 if queue is full
+     */
+    size_t try_push_batch(const T* items, size_t count) noexcept {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t claimed;
+        for (;;) {
+            // A free slot can only be taken by the producer that claims it,
+            // so the prefix counted here stays free until our CAS
+            claimed = 0;
+            while (claimed < count && claimed < capacity_ &&
+                   cells_[(pos + claimed) & mask_].sequence.load(std::memory_order_acquire) == pos + claimed) {
+                claimed++;
+            }
+            if (claimed == 0) {
+                const size_t seq = cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+                if (static_cast<std::ptrdiff_t>(seq - pos) < 0) {
+                    return 0; // Queue is full
+                }
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        
+        for (size_t i = 0; i < claimed; ++i) {
+            Cell& cell = cells_[(pos + i) & mask_];
+            cell.data = items[i];
+            cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    /**
+     * @brief Try to pop an element (consumer side)
+     * @param item Reference to store the popped item
+     * @return true if successful, false if queue is empty
+     */
+    bool try_pop(T& item) noexcept {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if constexpr (MultiConsumer) {
+                    if (!dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        continue;
+                    }
+                } else {
+                    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+                }
+                item = std::move(cell.data);
+                cell.sequence.store(pos + capacity_, std::memory_order_release);
+                return true;
+            }
+            if (diff < 0) {
+                return false; // Queue is empty
+            }
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Pop up to max elements with a single position claim
+     * @param items Destination for popped items
+     * @param max Maximum number of items to pop
+     * @return Number of items popped; 0 if queue is empty
+     */
+    size_t try_pop_batch(T* items, size_t max) noexcept {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t claimed;
+        for (;;) {
+            claimed = 0;
+            while (claimed < max && claimed < capacity_ &&
+                   cells_[(pos + claimed) & mask_].sequence.load(std::memory_order_acquire) == pos + claimed + 1) {
+                claimed++;
+            }
+            if (claimed == 0) {
+                return 0; // Queue is empty (or the next slot is still being written)
+            }
+            if constexpr (MultiConsumer) {
+                if (!dequeue_pos_.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) {
+                    continue;
+                }
+            } else {
+                dequeue_pos_.store(pos + claimed, std::memory_order_relaxed);
+            }
+            break;
+        }
+        
+        for (size_t i = 0; i < claimed; ++i) {
+            Cell& cell = cells_[(pos + i) & mask_];
+            items[i] = std::move(cell.data);
+            cell.sequence.store(pos + i + capacity_, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    /**
+     * @brief Check if queue is empty (approximate under concurrency)
+     * @return true if empty
+     */
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Get approximate number of elements
+     * @return Approximate number of elements
+     */
+    size_t size() const noexcept {
+        const size_t enqueued = enqueue_pos_.load(std::memory_order_acquire);
+        const size_t dequeued = dequeue_pos_.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(enqueued - dequeued);
+        return diff > 0 ? static_cast<size_t>(diff) : 0;
+    }
+
+    /**
+     * @brief Get queue capacity
+     * @return Queue capacity
+     */
+    size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T data{};
+    };
+    
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};  // Next producer position
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};  // Next consumer position
+    
+    template<typename Fill>
+    bool emplace_one(Fill&& fill) noexcept {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fill(cell.data);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Queue is full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Bounded multi-producer multi-consumer queue
+ */
+template<typename T>
+using MpmcQueue = BoundedQueue<T, true>;
+
+/**
+ * @brief Bounded multi-producer single-consumer queue, e.g. several feed
+ *        decoders merging into one book thread
+ */
+template<typename T>
+using MpscQueue = BoundedQueue<T, false>;
+
+} // namespace core
@@ -6,8 +6,10 @@
 #pragma once
 
 #include "messages.hpp"
+#include "book_policies.hpp"
 #include <map>
 #include <unordered_map>
+#include <memory_resource>
 #include <cstdint>
 #include <optional>
 
@@ -35,13 +37,87 @@ struct PriceLevel {
  * @brief Order information
  */
 struct OrderInfo {
-    Side side;
-    int64_t price;
-    uint32_t quantity;
+    Side side = Side::BUY;
+    int64_t price = 0;
+    uint32_t quantity = 0;
     
+    OrderInfo() = default;
     OrderInfo(Side s, int64_t p, uint32_t q) : side(s), price(p), quantity(q) {}
 };
 
+/*
+ * Order records
+ *
+ * The record is how a book stores one resting order internally, with the
+ * price already converted to PriceGrid ticks. Every record provides:
+ *
+ *   using Tick = ...;                       // level-store key type
+ *   static bool fits(int64_t ticks);        // false if ticks are unrepresentable
+ *   Record(Side side, Tick ticks, uint32_t quantity);
+ *   Side side() const;
+ *   Tick ticks() const;
+ *   uint32_t quantity() const;
+ *   void set_ticks(Tick ticks);
+ *   void set_quantity(uint32_t quantity);
+ */
+
+/**
+ * @brief 64-bit ticks, any grid offset (16 bytes)
+ */
+class WideOrder {
+public:
+    using Tick = int64_t;
+    
+    static constexpr bool fits(int64_t) { return true; }
+    
+    WideOrder() = default;
+    WideOrder(Side side, Tick ticks, uint32_t quantity)
+        : ticks_(ticks), quantity_(quantity), side_(side) {}
+    
+    Side side() const { return side_; }
+    Tick ticks() const { return ticks_; }
+    uint32_t quantity() const { return quantity_; }
+    void set_ticks(Tick ticks) { ticks_ = ticks; }
+    void set_quantity(uint32_t quantity) { quantity_ = quantity; }
+
+private:
+    int64_t ticks_ = 0;
+    uint32_t quantity_ = 0;
+    Side side_ = Side::BUY;
+};
+
+/**
+ * @brief 31-bit tick offset with the side in the top bit, 32-bit quantity (8 bytes)
+ *
+ * Ticks are offsets from the grid base, so a hash node (id + record) is 16
+ * bytes and level entries key on 32-bit ticks. Prices below the base or more
+ * than 2^31 - 1 ticks above it are rejected.
+ */
+class PackedOrder {
+public:
+    using Tick = int32_t;
+    
+    static constexpr uint32_t SELL_BIT = uint32_t{1} << 31;
+    
+    static constexpr bool fits(int64_t ticks) { return ticks >= 0 && ticks < int64_t{SELL_BIT}; }
+    
+    PackedOrder() = default;
+    PackedOrder(Side side, Tick ticks, uint32_t quantity)
+        : word_(static_cast<uint32_t>(ticks) | (side == Side::SELL ? SELL_BIT : 0)), quantity_(quantity) {}
+    
+    Side side() const { return (word_ & SELL_BIT) != 0 ? Side::SELL : Side::BUY; }
+    Tick ticks() const { return static_cast<Tick>(word_ & ~SELL_BIT); }
+    uint32_t quantity() const { return quantity_; }
+    void set_ticks(Tick ticks) { word_ = (word_ & SELL_BIT) | static_cast<uint32_t>(ticks); }
+    void set_quantity(uint32_t quantity) { quantity_ = quantity; }
+
+private:
+    uint32_t word_ = 0;
+    uint32_t quantity_ = 0;
+};
+
+static_assert(sizeof(PackedOrder) == 8, "PackedOrder must stay 8 bytes");
+
 /**
  * @brief Top of book snapshot
  */
@@ -56,14 +132,81 @@ struct TopOfBook {
 };
 
 /**
- * @brief Limit order book implementation
+ * @brief Signals derived from book state (see BasicOrderBook::analytics())
  */
-class OrderBook {
+struct BookAnalytics {
+    double microprice = 0.0;        // Nano-units; 0 unless both sides are quoted
+    double imbalance = 0.0;         // (bid - ask) / (bid + ask) over the top levels, in [-1, 1]
+    uint64_t bid_depth = 0;         // Quantity in the top analytics levels
+    uint64_t ask_depth = 0;
+    uint64_t bid_band_depth = 0;    // Quantity priced within the band of the best bid
+    uint64_t ask_band_depth = 0;    // Quantity priced within the band of the best ask
+};
+
+/**
+ * @brief Per-symbol price grid: price = base_px + ticks * tick_px
+ *
+ * The default grid (base 0, tick 1 nano) is the identity, so any nano price
+ * is accepted. Level stores that index by tick (FlatLadderLevels) need a
+ * real tick size.
+ */
+struct PriceGrid {
+    int64_t base_px = 0;
+    int64_t tick_px = 1;
+    
+    /**
+     * @brief Convert a nano price to a tick index
+     * @param price Price in nano-units
+     * @param ticks Receives the tick index
+     * @return false if the price is not on the grid
+     */
+    bool to_ticks(int64_t price, int64_t& ticks) const {
+        const int64_t offset = price - base_px;
+        if (tick_px == 1) {
+            ticks = offset;
+            return true;
+        }
+        ticks = offset / tick_px;
+        return offset % tick_px == 0;
+    }
+    
+    /**
+     * @brief Convert a tick index back to a nano price
+     */
+    int64_t to_price(int64_t ticks) const { return base_px + ticks * tick_px; }
+};
+
+/**
+ * @brief Limit order book over a level-store and an order-index policy
+ * @tparam LevelStore Level store template (see book_policies.hpp), instantiated
+ *         with std::greater for bids and std::less for asks
+ * @tparam OrderIndex Order index template, instantiated with Record
+ * @tparam Record Internal order record (WideOrder or PackedOrder)
+ *
+ * Prices cross the public interface in nano-units and are stored internally
+ * as PriceGrid ticks. Member functions are defined in order_book.cpp and
+ * explicitly instantiated for every policy combination declared below.
+ */
+template<template<typename> class LevelStore, template<typename> class OrderIndex,
+         typename Record = WideOrder>
+class BasicOrderBook {
 public:
     /**
      * @brief Constructor
+     * @param resource Memory resource for level and order nodes (e.g. a
+     *        core::ArenaResource owned per book or shard); must outlive the book
+     */
+    explicit BasicOrderBook(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : BasicOrderBook(PriceGrid{}, resource) {}
+    
+    /**
+     * @brief Constructor with a price grid
+     * @param grid Tick size and base price for this symbol
+     * @param resource Memory resource for level and order nodes
      */
-    OrderBook() = default;
+    explicit BasicOrderBook(PriceGrid grid,
+                            std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : grid_(grid), bids_(resource), asks_(resource), orders_(resource), resource_(resource) {}
     
     /**
      * @brief Add a new order to the book
@@ -92,6 +235,15 @@ public:
      */
     bool on_execute(uint64_t order_id, uint32_t exec_quantity);
     
+    /**
+     * @brief Execute an order and report the resting order that traded
+     * @param order_id Order identifier
+     * @param exec_quantity Quantity to execute
+     * @param resting Set to the order's side, price and quantity before the fill
+     * @return true if successful; resting is unchanged on failure
+     */
+    bool on_execute(uint64_t order_id, uint32_t exec_quantity, OrderInfo& resting);
+    
     /**
      * @brief Delete an order from the book
      * @param order_id Order identifier
@@ -105,31 +257,195 @@ public:
      */
     TopOfBook top_of_book() const;
     
+    /**
+     * @brief Maintain top-level and band depth as levels change
+     * @param levels Levels per side counted by depth() and imbalance(); 0
+     *        turns the analytics off (the default), leaving level updates as
+     *        they were
+     * @param band_bps Width of the band_depth() band in basis points of each
+     *        side's best price
+     */
+    void enable_analytics(size_t levels, uint32_t band_bps);
+    
+    /**
+     * @brief Size-weighted mid: (bid_px * ask_sz + ask_px * bid_sz) / (bid_sz + ask_sz)
+     * @return Nano-units; 0 unless both sides are quoted. Needs no analytics.
+     */
+    double microprice() const;
+    
+    /**
+     * @brief Quantity resting in the best analytics levels of one side
+     *
+     * The running sums are adjusted on every level change and rebuilt only
+     * after a change to the set of counted levels, so reads are O(1) apart
+     * from the first one after such a change. Returns 0 with analytics off.
+     */
+    uint64_t depth(Side side) const;
+    
+    /**
+     * @brief Quantity priced within band_bps of the side's best price
+     *        (bids at or above best * (1 - bps), asks at or below best * (1 + bps))
+     */
+    uint64_t band_depth(Side side) const;
+    
+    /**
+     * @brief Top-level volume imbalance: (bid - ask) / (bid + ask), 0 for an empty book
+     */
+    double imbalance() const;
+    
+    /**
+     * @brief All analytics at once
+     */
+    BookAnalytics analytics() const;
+    
     /**
      * @brief Get number of orders in the book
      * @return Total number of orders
      */
     size_t order_count() const { return orders_.size(); }
     
+    /**
+     * @brief Adds and modifies rejected for their price
+     * @return Count of prices off the grid or outside the record's or level
+     *         store's range since construction (not reset by clear())
+     */
+    uint64_t price_rejects() const { return price_rejects_; }
+    
     /**
      * @brief Check if book is empty
      * @return true if no orders
      */
     bool empty() const { return orders_.empty(); }
 
+    /**
+     * @brief Get the memory resource backing this book
+     * @return Memory resource passed at construction
+     */
+    std::pmr::memory_resource* resource() const { return resource_; }
+    
+    /**
+     * @brief Get the price grid
+     * @return Grid passed at construction
+     */
+    const PriceGrid& grid() const { return grid_; }
+    
+    /**
+     * @brief Remove all orders and price levels
+     */
+    void clear();
+    
+    /**
+     * @brief Visit the price levels of one side, best first
+     * @param side BUY for bids, SELL for asks
+     * @param fn Callable invoked as fn(price, quantity) -> bool, price in
+     *        nano-units; returning false stops the walk
+     */
+    template<typename Fn>
+    void for_each_level(Side side, Fn&& fn) const {
+        auto visit = [&](Tick ticks, uint32_t quantity) { return fn(grid_.to_price(ticks), quantity); };
+        if (side == Side::BUY) {
+            bids_.for_each(visit);
+        } else {
+            asks_.for_each(visit);
+        }
+    }
+    
+    /**
+     * @brief Visit every resting order (unspecified order)
+     * @param fn Callable invoked as fn(order_id, const OrderInfo&), price in nano-units
+     */
+    template<typename Fn>
+    void for_each_order(Fn&& fn) const {
+        orders_.for_each([&](uint64_t order_id, const Record& order) {
+            fn(order_id, OrderInfo(order.side(), grid_.to_price(order.ticks()), order.quantity()));
+        });
+    }
+
 private:
-    // Bids: higher price first (descending)
-    std::map<int64_t, uint32_t, std::greater<int64_t>> bids_;
+    using Tick = typename Record::Tick;
+    using Bids = LevelStore<std::greater<Tick>>;
+    using Asks = LevelStore<std::less<Tick>>;
+    
+    PriceGrid grid_;
     
-    // Asks: lower price first (ascending)  
-    std::map<int64_t, uint32_t> asks_;
+    // Bids: higher price first (descending), keyed by tick
+    Bids bids_;
+    
+    // Asks: lower price first (ascending), keyed by tick
+    Asks asks_;
     
     // Order tracking
-    std::unordered_map<uint64_t, OrderInfo> orders_;
+    OrderIndex<Record> orders_;
+    
+    std::pmr::memory_resource* resource_;
+    
+    uint64_t price_rejects_ = 0;
     
-    void add_to_level(Side side, int64_t price, uint32_t quantity);
-    void remove_from_level(Side side, int64_t price, uint32_t quantity);
-    bool has_crossing(Side side, int64_t price) const;
+    // Running analytics of one side, rebuilt from the levels when dirty
+    struct SideAnalytics {
+        uint64_t depth = 0;         // Sum over the best analytics_levels_ levels
+        uint64_t band_depth = 0;    // Sum over levels priced within band_limit
+        Tick boundary{};            // Worst level counted in depth
+        int64_t band_limit = 0;     // Worst price counted in band_depth
+        bool dirty = true;
+    };
+    
+    size_t analytics_levels_ = 0;   // 0 = analytics off
+    uint32_t band_bps_ = 0;
+    mutable SideAnalytics bid_analytics_;
+    mutable SideAnalytics ask_analytics_;
+    
+    bool to_ticks(Side side, int64_t price, Tick& ticks) const;
+    void add_to_level(Side side, Tick ticks, uint32_t quantity);
+    void remove_from_level(Side side, Tick ticks, uint32_t quantity);
+    template<typename Levels>
+    void track_level_change(Side side, const Levels& levels, SideAnalytics& stats, Tick ticks, int64_t delta,
+                            size_t count_before) noexcept;
+    template<typename Levels>
+    void refresh(Side side, const Levels& levels, SideAnalytics& stats) const;
+    const SideAnalytics& side_analytics(Side side) const;
+    bool has_crossing(Side side, Tick ticks) const;
 };
 
+/**
+ * @brief Default book: std::map levels and an std::unordered_map order index
+ */
+using OrderBook = BasicOrderBook<MapLevels, HashOrderIndex>;
+
+/**
+ * @brief Book for venues with dense, monotonic order ids: segmented direct index
+ */
+using DenseOrderBook = BasicOrderBook<MapLevels, DirectOrderIndex>;
+
+/**
+ * @brief Default book with 8-byte packed order records; needs a PriceGrid
+ *        whose ticks fit in 31 bits
+ */
+using PackedOrderBook = BasicOrderBook<MapLevels, HashOrderIndex, PackedOrder>;
+
+/**
+ * @brief Dense book with packed order records
+ */
+using DensePackedOrderBook = BasicOrderBook<MapLevels, DirectOrderIndex, PackedOrder>;
+
+// Instantiated in order_book.cpp
+extern template class BasicOrderBook<MapLevels, HashOrderIndex>;
+extern template class BasicOrderBook<MapLevels, OpenAddressingOrderIndex>;
+extern template class BasicOrderBook<MapLevels, DirectOrderIndex>;
+extern template class BasicOrderBook<SortedVectorLevels, HashOrderIndex>;
+extern template class BasicOrderBook<SortedVectorLevels, OpenAddressingOrderIndex>;
+extern template class BasicOrderBook<SortedVectorLevels, DirectOrderIndex>;
+extern template class BasicOrderBook<FlatLadderLevels, HashOrderIndex>;
+extern template class BasicOrderBook<FlatLadderLevels, OpenAddressingOrderIndex>;
+extern template class BasicOrderBook<FlatLadderLevels, DirectOrderIndex>;
+extern template class BasicOrderBook<MapLevels, HashOrderIndex, PackedOrder>;
+extern template class BasicOrderBook<MapLevels, OpenAddressingOrderIndex, PackedOrder>;
+extern template class BasicOrderBook<MapLevels, DirectOrderIndex, PackedOrder>;
+extern template class BasicOrderBook<SortedVectorLevels, HashOrderIndex, PackedOrder>;
+extern template class BasicOrderBook<SortedVectorLevels, OpenAddressingOrderIndex, PackedOrder>;
+extern template class BasicOrderBook<SortedVectorLevels, DirectOrderIndex, PackedOrder>;
+extern template class BasicOrderBook<FlatLadderLevels, HashOrderIndex, PackedOrder>;
+extern template class BasicOrderBook<FlatLadderLevels, OpenAddressingOrderIndex, PackedOrder>;
+extern template class BasicOrderBook<FlatLadderLevels, DirectOrderIndex, PackedOrder>;
+
 } // namespace book
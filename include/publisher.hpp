@@ -12,6 +12,35 @@
 
 namespace publish {
 
+/**
+ * @brief Fixed-size top-of-book record for binary consumers
+ *
+ * symbol is the feed symbol with trailing spaces replaced by NULs. Sizes are
+ * 0 for an empty side, matching TopOfBook. This is the shared-memory and UDP
+ * record: readers of those attach mid-stream with no symbol table, so every
+ * record names its symbol. Files use BinaryTobRecord, which has the same
+ * layout with an index into the file's symbol table in place of the name.
+ */
+struct TobRecord {
+    uint64_t ts_us;
+    int64_t bid_px;
+    int64_t ask_px;
+    uint32_t bid_sz;
+    uint32_t ask_sz;
+    char symbol[8];
+};
+
+static_assert(sizeof(TobRecord) == 40, "TobRecord layout is shared with other processes");
+
+/**
+ * @brief Build a TobRecord
+ * @param timestamp_us Timestamp in microseconds
+ * @param symbol Symbol
+ * @param tob Top of book data
+ * @return Record
+ */
+TobRecord make_tob_record(uint64_t timestamp_us, const feed::Symbol& symbol, const book::TopOfBook& tob);
+
 /**
  * @brief CSV publisher for top-of-book data
  */
@@ -20,8 +49,10 @@ public:
     /**
      * @brief Constructor
      * @param output Output stream (default: std::cout)
+     * @param flush_each_row Flush after every row; batching callers pass
+     *        false and call flush() themselves
      */
-    explicit TopOfBookPublisher(std::ostream& output = std::cout);
+    explicit TopOfBookPublisher(std::ostream& output = std::cout, bool flush_each_row = true);
     
     /**
      * @brief Publish top of book data in CSV format
@@ -35,10 +66,16 @@ public:
      * @brief Print CSV header
      */
     void print_header();
+    
+    /**
+     * @brief Flush the output stream
+     */
+    void flush();
 
 private:
     std::ostream& output_;
     bool header_printed_;
+    bool flush_each_row_;
     
     std::string format_price(int64_t price_nano) const;
 };
@@ -5,15 +5,39 @@
 
 #pragma once
 
+#include "page_memory.hpp"
 #include <atomic>
 #include <memory>
 #include <cassert>
+#include <cstdint>
+#include <span>
+#include <algorithm>
+#include <type_traits>
 
 namespace core {
 
+/**
+ * @brief Ring buffer telemetry snapshot
+ *
+ * A spin is a push or claim that found the buffer full (producer) or a pop
+ * or peek that found it empty (consumer). high_water is the highest
+ * occupancy the producer has seen after a commit.
+ */
+struct RingStats {
+    uint64_t pushes = 0;
+    uint64_t pops = 0;
+    uint64_t full_spins = 0;
+    uint64_t empty_spins = 0;
+    size_t high_water = 0;
+};
+
 /**
  * @brief Lock-free single-producer single-consumer ring buffer
  * @tparam T Type of elements stored in the buffer
+ *
+ * Telemetry counters live in one cache line per side and are only written
+ * by that side's thread, so counting adds no cross-core traffic to the hot
+ * path; stats() can be read from any thread.
  */
 template<typename T>
 class RingBuffer {
@@ -23,10 +47,47 @@ public:
      * @param capacity Buffer capacity (must be power of 2)
      */
     explicit RingBuffer(size_t capacity) 
-        : capacity_(capacity), mask_(capacity - 1), buffer_(std::make_unique<T[]>(capacity)) {
+        : capacity_(capacity), mask_(capacity - 1), heap_(std::make_unique<T[]>(capacity)) {
         assert((capacity & (capacity - 1)) == 0 && "Capacity must be power of 2");
         assert(capacity > 0);
+        buffer_ = heap_.get();
     }
+    
+    /**
+     * @brief Construct ring buffer in its own mapping (huge pages, NUMA node, prefault)
+     *
+     * Trivially copyable, trivially destructible elements are not constructed:
+     * the zeroed mapping already holds them and the producer writes each slot
+     * before publishing it, so only options.prefault touches the pages and
+     * first-touch placement follows the thread that fills the ring. Other
+     * types are value-constructed after the mapping is bound and prefaulted.
+     *
+     * @param capacity Buffer capacity (must be power of 2)
+     * @param options Page mode, NUMA node and prefault
+     * @throws std::runtime_error if the memory cannot be mapped
+     */
+    RingBuffer(size_t capacity, const PageOptions& options)
+        : capacity_(capacity), mask_(capacity - 1),
+          region_(MappedRegion::map(capacity * sizeof(T), options)) {
+        static_assert(alignof(T) <= 4096, "Mapped storage is page aligned");
+        assert((capacity & (capacity - 1)) == 0 && "Capacity must be power of 2");
+        assert(capacity > 0);
+        buffer_ = static_cast<T*>(region_.data());
+        if constexpr (!IN_PLACE_STORAGE) {
+            std::uninitialized_value_construct_n(buffer_, capacity_);
+        }
+    }
+    
+    ~RingBuffer() {
+        if constexpr (!IN_PLACE_STORAGE) {
+            if (!heap_) {
+                std::destroy_n(buffer_, capacity_);
+            }
+        }
+    }
+    
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
 
     /**
      * @brief Try to push an element (producer side)
@@ -37,12 +98,15 @@ public:
         const size_t current_tail = tail_.load(std::memory_order_relaxed);
         const size_t next_tail = (current_tail + 1) & mask_;
         
-        if (next_tail == head_.load(std::memory_order_acquire)) {
+        const size_t current_head = head_.load(std::memory_order_acquire);
+        if (next_tail == current_head) {
+            count(producer_stats_.full_spins);
             return false; // Buffer is full
         }
         
         buffer_[current_tail] = item;
         tail_.store(next_tail, std::memory_order_release);
+        on_pushed(current_head, next_tail, 1);
         return true;
     }
 
@@ -55,12 +119,15 @@ public:
         const size_t current_tail = tail_.load(std::memory_order_relaxed);
         const size_t next_tail = (current_tail + 1) & mask_;
         
-        if (next_tail == head_.load(std::memory_order_acquire)) {
+        const size_t current_head = head_.load(std::memory_order_acquire);
+        if (next_tail == current_head) {
+            count(producer_stats_.full_spins);
             return false; // Buffer is full
         }
         
         buffer_[current_tail] = std::move(item);
         tail_.store(next_tail, std::memory_order_release);
+        on_pushed(current_head, next_tail, 1);
         return true;
     }
 
@@ -73,13 +140,103 @@ public:
         const size_t current_head = head_.load(std::memory_order_relaxed);
         
         if (current_head == tail_.load(std::memory_order_acquire)) {
+            count(consumer_stats_.empty_spins);
             return false; // Buffer is empty
         }
         
         item = std::move(buffer_[current_head]);
         head_.store((current_head + 1) & mask_, std::memory_order_release);
+        count(consumer_stats_.pops);
         return true;
     }
+    
+    /**
+     * @brief Claim the next free slot for in-place construction (producer side)
+     *
+     * The slot holds whatever was last stored there; the producer overwrites
+     * it and then calls commit(). Claiming again before committing returns
+     * the same slot.
+     *
+     * @return Pointer to the slot, or nullptr if buffer is full
+     */
+    T* try_claim() noexcept {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        if (((current_tail + 1) & mask_) == head_.load(std::memory_order_acquire)) {
+            count(producer_stats_.full_spins);
+            return nullptr; // Buffer is full
+        }
+        return &buffer_[current_tail];
+    }
+    
+    /**
+     * @brief Claim up to max contiguous free slots (producer side)
+     * @param max Maximum number of slots wanted
+     * @return Claimed slots; shorter than max when the buffer is nearly full
+     *         or the free space wraps, empty if the buffer is full
+     */
+    std::span<T> claim_batch(size_t max) noexcept {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        const size_t current_head = head_.load(std::memory_order_acquire);
+        const size_t free_slots = (current_head - current_tail - 1) & mask_;
+        const size_t claimed = std::min({max, free_slots, capacity_ - current_tail});
+        if (claimed == 0 && max > 0) {
+            count(producer_stats_.full_spins);
+        }
+        return std::span<T>(&buffer_[current_tail], claimed);
+    }
+    
+    /**
+     * @brief Publish claimed slots to the consumer (producer side)
+     * @param count Number of slots to publish, at most the number claimed
+     */
+    void commit(size_t count = 1) noexcept {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        const size_t next_tail = (current_tail + count) & mask_;
+        tail_.store(next_tail, std::memory_order_release);
+        // A fresh head: the consumer may have drained a lot since the claim
+        on_pushed(head_.load(std::memory_order_acquire), next_tail, count);
+    }
+    
+    /**
+     * @brief Access the oldest element in place (consumer side)
+     *
+     * The element stays valid until release() is called.
+     *
+     * @return Pointer to the element, or nullptr if buffer is empty
+     */
+    T* peek() noexcept {
+        const size_t current_head = head_.load(std::memory_order_relaxed);
+        if (current_head == tail_.load(std::memory_order_acquire)) {
+            count(consumer_stats_.empty_spins);
+            return nullptr; // Buffer is empty
+        }
+        return &buffer_[current_head];
+    }
+    
+    /**
+     * @brief Access up to max contiguous elements in place (consumer side)
+     * @param max Maximum number of elements wanted
+     * @return Readable elements, oldest first; empty if buffer is empty
+     */
+    std::span<T> peek_batch(size_t max) noexcept {
+        const size_t current_head = head_.load(std::memory_order_relaxed);
+        const size_t available = (tail_.load(std::memory_order_acquire) - current_head) & mask_;
+        const size_t readable = std::min({max, available, capacity_ - current_head});
+        if (readable == 0 && max > 0) {
+            count(consumer_stats_.empty_spins);
+        }
+        return std::span<T>(&buffer_[current_head], readable);
+    }
+    
+    /**
+     * @brief Return consumed slots to the producer (consumer side)
+     * @param count Number of elements to release, at most the number peeked
+     */
+    void release(size_t count = 1) noexcept {
+        const size_t current_head = head_.load(std::memory_order_relaxed);
+        head_.store((current_head + count) & mask_, std::memory_order_release);
+        RingBuffer::count(consumer_stats_.pops, count);
+    }
 
     /**
      * @brief Check if buffer is empty
@@ -107,13 +264,67 @@ public:
         return capacity_;
     }
 
+    /**
+     * @brief Mapping behind a buffer built with PageOptions (empty otherwise)
+     */
+    const MappedRegion& region() const noexcept {
+        return region_;
+    }
+    
+    /**
+     * @brief Read the telemetry counters (any thread; each field is exact,
+     *        the set is not a consistent snapshot)
+     * @return Counters since construction
+     */
+    RingStats stats() const noexcept {
+        RingStats stats;
+        stats.pushes = producer_stats_.pushes.load(std::memory_order_relaxed);
+        stats.full_spins = producer_stats_.full_spins.load(std::memory_order_relaxed);
+        stats.high_water = producer_stats_.high_water.load(std::memory_order_relaxed);
+        stats.pops = consumer_stats_.pops.load(std::memory_order_relaxed);
+        stats.empty_spins = consumer_stats_.empty_spins.load(std::memory_order_relaxed);
+        return stats;
+    }
+
 private:
+    // Mapped slots of these types need no construction or destruction
+    static constexpr bool IN_PLACE_STORAGE =
+        std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+    
+    struct alignas(64) ProducerStats {
+        std::atomic<uint64_t> pushes{0};
+        std::atomic<uint64_t> full_spins{0};
+        std::atomic<size_t> high_water{0};
+    };
+    
+    struct alignas(64) ConsumerStats {
+        std::atomic<uint64_t> pops{0};
+        std::atomic<uint64_t> empty_spins{0};
+    };
+    
     const size_t capacity_;
     const size_t mask_;
-    std::unique_ptr<T[]> buffer_;
+    std::unique_ptr<T[]> heap_;  // Default storage
+    MappedRegion region_;        // Storage when built with PageOptions
+    T* buffer_ = nullptr;
     
     alignas(64) std::atomic<size_t> head_{0};  // Consumer index
     alignas(64) std::atomic<size_t> tail_{0};  // Producer index
+    ProducerStats producer_stats_;
+    ConsumerStats consumer_stats_;
+    
+    // Single-writer counters: a plain load and store, no read-modify-write
+    static void count(std::atomic<uint64_t>& counter, uint64_t n = 1) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    
+    void on_pushed(size_t head, size_t next_tail, size_t n) noexcept {
+        count(producer_stats_.pushes, n);
+        const size_t occupancy = (next_tail - head) & mask_;
+        if (occupancy > producer_stats_.high_water.load(std::memory_order_relaxed)) {
+            producer_stats_.high_water.store(occupancy, std::memory_order_relaxed);
+        }
+    }
 };
 
 } // namespace core
@@ -0,0 +1,52 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "publisher.hpp"
+#include "shm_ring.hpp"
+#include <string>
+
+namespace publish {
+
+/**
+ * @brief Publishes TobRecords into a shared-memory ring
+ *
+ * Consumers in other processes attach with
+ * core::ShmRingConsumer<publish::TobRecord> (see tools/shmtail).
+ */
+class ShmTopOfBookPublisher {
+public:
+    /**
+     * @brief Create or reattach to the named ring
+     * @param name Segment name, e.g. "/market-feed"
+     * @param capacity Number of slots (must be power of 2)
+     * @throws std::runtime_error if the ring cannot be set up
+     */
+    ShmTopOfBookPublisher(const std::string& name, size_t capacity);
+    
+    /**
+     * @brief Publish top of book data as one record
+     * @param timestamp_us Timestamp in microseconds
+     * @param symbol Symbol
+     * @param tob Top of book data
+     */
+    void publish(uint64_t timestamp_us, const feed::Symbol& symbol, const book::TopOfBook& tob);
+    
+    /**
+     * @brief Publish one prebuilt record
+     */
+    void publish(const TobRecord& record) { ring_.publish(record); }
+    
+    /**
+     * @brief Records published to the ring, including earlier producer runs
+     */
+    uint64_t published() const { return ring_.published(); }
+
+private:
+    core::ShmRingProducer<TobRecord> ring_;
+};
+
+} // namespace publish
@@ -0,0 +1,351 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+namespace core {
+
+inline constexpr uint64_t SHM_RING_MAGIC = 0x0042524D48534D46ULL;  // "FMSHMRB\0" little-endian
+inline constexpr uint32_t SHM_RING_VERSION = 1;
+
+/**
+ * @brief Header at offset 0 of a shared-memory ring segment
+ *
+ * magic is stored last (release) when a segment is created, so a consumer
+ * that sees it also sees the rest of the header.
+ */
+struct ShmRingHeader {
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t header_size;           // sizeof(ShmRingHeader)
+    uint64_t capacity;              // slots, power of 2
+    uint32_t slot_size;             // sizeof(ShmRingSlot<T>)
+    uint32_t record_size;           // sizeof(T)
+    std::atomic<uint64_t> epoch;    // incremented every time a producer attaches
+    std::atomic<int32_t> producer_pid;  // 0 when no producer is attached
+    
+    alignas(64) std::atomic<uint64_t> write_seq;  // records fully published
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+
+/**
+ * @brief One ring slot: stamp == 2 * seq + 2 once record seq is complete,
+ *        2 * seq + 1 while it is being written
+ */
+template<typename T>
+struct alignas(64) ShmRingSlot {
+    std::atomic<uint64_t> stamp;
+    T value;
+};
+
+/**
+ * @brief Named POSIX shared-memory mapping (shm_open + mmap)
+ */
+class ShmSegment {
+public:
+    /**
+     * @brief Create (or truncate) a segment read-write
+     * @param name Segment name, e.g. "/market-feed"
+     * @param size Size in bytes
+     * @throws std::runtime_error on failure
+     */
+    static ShmSegment create(const std::string& name, size_t size);
+    
+    /**
+     * @brief Map an existing segment
+     * @param name Segment name
+     * @param writable Map read-write instead of read-only
+     * @throws std::runtime_error if the segment does not exist or cannot be mapped
+     */
+    static ShmSegment open(const std::string& name, bool writable);
+    
+    /**
+     * @brief Remove a segment name; existing mappings stay valid
+     * @return false if the segment did not exist
+     */
+    static bool unlink(const std::string& name) noexcept;
+    
+    ShmSegment(ShmSegment&& other) noexcept;
+    ShmSegment& operator=(ShmSegment&& other) noexcept;
+    ShmSegment(const ShmSegment&) = delete;
+    ShmSegment& operator=(const ShmSegment&) = delete;
+    ~ShmSegment();
+    
+    void* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+
+private:
+    ShmSegment(void* data, size_t size) noexcept : data_(data), size_(size) {}
+    
+    void* data_;
+    size_t size_;
+};
+
+/**
+ * @brief Check whether a producer process is still running
+ */
+bool shm_process_alive(int32_t pid) noexcept;
+
+/**
+ * @brief Current process id, as stored in ShmRingHeader::producer_pid
+ */
+int32_t shm_current_pid() noexcept;
+
+/**
+ * @brief Single-producer broadcast ring in shared memory
+ * @tparam T Trivially copyable record type
+ *
+ * The producer never waits for consumers: it overwrites the oldest slot, and
+ * consumers that fall a full ring behind detect it from the slot stamp.
+ * Crash safety: write_seq only advances after a record is complete, so a
+ * producer that dies mid-write leaves at most one torn slot, which no
+ * consumer will accept. A restarted producer reattaches to the segment,
+ * bumps the epoch and overwrites that slot.
+ */
+template<typename T>
+class ShmRingProducer {
+    static_assert(std::is_trivially_copyable_v<T>, "shared-memory records must be trivially copyable");
+
+public:
+    /**
+     * @brief Attach to (or create) the named ring
+     *
+     * An existing segment with the same version and geometry is reused and
+     * its sequence continued; otherwise it is recreated.
+     *
+     * @param name Segment name, e.g. "/market-feed"
+     * @param capacity Number of slots (must be power of 2)
+     * @throws std::runtime_error on failure or if another live producer owns the ring
+     */
+    ShmRingProducer(const std::string& name, size_t capacity)
+        : name_(name), segment_(attach(name, capacity)) {
+        header_ = static_cast<ShmRingHeader*>(segment_.data());
+        slots_ = reinterpret_cast<ShmRingSlot<T>*>(static_cast<char*>(segment_.data()) + HEADER_BYTES);
+        mask_ = capacity - 1;
+        header_->producer_pid.store(shm_current_pid(), std::memory_order_release);
+        header_->epoch.fetch_add(1, std::memory_order_acq_rel);
+        next_seq_ = header_->write_seq.load(std::memory_order_acquire);
+    }
+    
+    ShmRingProducer(const ShmRingProducer&) = delete;
+    ShmRingProducer& operator=(const ShmRingProducer&) = delete;
+    
+    /**
+     * @brief Detach; the segment stays for consumers (see ShmSegment::unlink)
+     */
+    ~ShmRingProducer() {
+        header_->producer_pid.store(0, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Publish one record (never blocks)
+     * @param value Record to publish
+     */
+    void publish(const T& value) noexcept {
+        const uint64_t seq = next_seq_;
+        ShmRingSlot<T>& slot = slots_[seq & mask_];
+        slot.stamp.store(2 * seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(static_cast<void*>(&slot.value), &value, sizeof(T));
+        slot.stamp.store(2 * seq + 2, std::memory_order_release);
+        header_->write_seq.store(seq + 1, std::memory_order_release);
+        next_seq_ = seq + 1;
+    }
+    
+    /**
+     * @brief Records published over the lifetime of the segment
+     */
+    uint64_t published() const noexcept { return next_seq_; }
+    
+    /**
+     * @brief Producer incarnation (1 for a fresh segment)
+     */
+    uint64_t epoch() const noexcept { return header_->epoch.load(std::memory_order_acquire); }
+    
+    size_t capacity() const noexcept { return mask_ + 1; }
+    const std::string& name() const noexcept { return name_; }
+
+private:
+    static constexpr size_t HEADER_BYTES = 4096;
+    static_assert(sizeof(ShmRingHeader) <= HEADER_BYTES);
+    
+    std::string name_;
+    ShmSegment segment_;
+    ShmRingHeader* header_ = nullptr;
+    ShmRingSlot<T>* slots_ = nullptr;
+    size_t mask_ = 0;
+    uint64_t next_seq_ = 0;
+    
+    static ShmSegment attach(const std::string& name, size_t capacity) {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("Shared-memory ring capacity must be a power of 2");
+        }
+        const size_t bytes = HEADER_BYTES + capacity * sizeof(ShmRingSlot<T>);
+        
+        std::optional<ShmSegment> existing;
+        try {
+            existing.emplace(ShmSegment::open(name, true));
+        } catch (const std::runtime_error&) {
+            // No segment yet; create one below
+        }
+        if (existing && existing->size() >= HEADER_BYTES) {
+            const auto* header = static_cast<const ShmRingHeader*>(existing->data());
+            if (header->magic.load(std::memory_order_acquire) == SHM_RING_MAGIC) {
+                const int32_t owner = header->producer_pid.load(std::memory_order_acquire);
+                if (owner != 0 && owner != shm_current_pid() && shm_process_alive(owner)) {
+                    throw std::runtime_error("Shared-memory ring already has a live producer: " + name);
+                }
+                // Reattach after a restart if the layout still matches
+                if (existing->size() == bytes && header->version == SHM_RING_VERSION &&
+                    header->header_size == sizeof(ShmRingHeader) && header->capacity == capacity &&
+                    header->slot_size == sizeof(ShmRingSlot<T>) && header->record_size == sizeof(T)) {
+                    return std::move(*existing);
+                }
+            }
+        }
+        
+        ShmSegment::unlink(name);
+        ShmSegment segment = ShmSegment::create(name, bytes);
+        auto* header = new (segment.data()) ShmRingHeader{};
+        header->version = SHM_RING_VERSION;
+        header->header_size = sizeof(ShmRingHeader);
+        header->capacity = capacity;
+        header->slot_size = sizeof(ShmRingSlot<T>);
+        header->record_size = sizeof(T);
+        auto* slots = reinterpret_cast<ShmRingSlot<T>*>(static_cast<char*>(segment.data()) + HEADER_BYTES);
+        for (size_t i = 0; i < capacity; ++i) {
+            new (&slots[i]) ShmRingSlot<T>{};
+        }
+        header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+        return segment;
+    }
+};
+
+/**
+ * @brief Read-only client for a ShmRingProducer segment
+ * @tparam T Record type; must match the producer's
+ *
+ * Consumers keep their own read position and never write to the segment,
+ * so any number of processes can attach.
+ */
+template<typename T>
+class ShmRingConsumer {
+    static_assert(std::is_trivially_copyable_v<T>, "shared-memory records must be trivially copyable");
+
+public:
+    /**
+     * @brief Attach to a ring
+     * @param name Segment name used by the producer
+     * @param from_start Replay every record still in the ring instead of
+     *        starting at the newest
+     * @throws std::runtime_error if the segment is missing or its version or
+     *         record layout does not match
+     */
+    explicit ShmRingConsumer(const std::string& name, bool from_start = false)
+        : segment_(ShmSegment::open(name, false)) {
+        if (segment_.size() < HEADER_BYTES) {
+            throw std::runtime_error("Shared-memory ring is truncated: " + name);
+        }
+        header_ = static_cast<const ShmRingHeader*>(segment_.data());
+        if (header_->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC) {
+            throw std::runtime_error("Not a shared-memory ring: " + name);
+        }
+        if (header_->version != SHM_RING_VERSION || header_->header_size != sizeof(ShmRingHeader)) {
+            throw std::runtime_error("Unsupported shared-memory ring version: " + name);
+        }
+        if (header_->slot_size != sizeof(ShmRingSlot<T>) || header_->record_size != sizeof(T) ||
+            segment_.size() != HEADER_BYTES + header_->capacity * sizeof(ShmRingSlot<T>)) {
+            throw std::runtime_error("Shared-memory ring record layout mismatch: " + name);
+        }
+        slots_ = reinterpret_cast<const ShmRingSlot<T>*>(static_cast<const char*>(segment_.data()) + HEADER_BYTES);
+        capacity_ = header_->capacity;
+        
+        const uint64_t head = header_->write_seq.load(std::memory_order_acquire);
+        next_seq_ = !from_start ? head : (head > capacity_ ? head - capacity_ : 0);
+    }
+    
+    /**
+     * @brief Read the next record
+     * @param value Receives the record
+     * @return false if no new record is available
+     */
+    bool try_read(T& value) noexcept {
+        for (;;) {
+            const uint64_t head = header_->write_seq.load(std::memory_order_acquire);
+            if (next_seq_ >= head) {
+                return false;
+            }
+            if (head - next_seq_ > capacity_) {
+                skip_to(head - capacity_);
+            }
+            
+            const ShmRingSlot<T>& slot = slots_[next_seq_ & (capacity_ - 1)];
+            const uint64_t expected = 2 * next_seq_ + 2;
+            if (slot.stamp.load(std::memory_order_acquire) == expected) {
+                std::memcpy(&value, static_cast<const void*>(&slot.value), sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.stamp.load(std::memory_order_relaxed) == expected) {
+                    next_seq_++;
+                    return true;
+                }
+            }
+            
+            // Overwritten while we looked: the producer lapped us
+            const uint64_t latest = header_->write_seq.load(std::memory_order_acquire);
+            skip_to(std::max(next_seq_ + 1, latest > capacity_ ? latest - capacity_ + 1 : 0));
+        }
+    }
+    
+    /**
+     * @brief Records skipped because the producer overwrote them first
+     */
+    uint64_t dropped() const noexcept { return dropped_; }
+    
+    /**
+     * @brief Sequence number of the next record to read
+     */
+    uint64_t position() const noexcept { return next_seq_; }
+    
+    /**
+     * @brief Producer incarnation; changes when the producer restarts
+     */
+    uint64_t epoch() const noexcept { return header_->epoch.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Whether a producer is attached and its process is running
+     */
+    bool producer_alive() const noexcept {
+        const int32_t pid = header_->producer_pid.load(std::memory_order_acquire);
+        return pid != 0 && shm_process_alive(pid);
+    }
+
+private:
+    static constexpr size_t HEADER_BYTES = 4096;
+    
+    ShmSegment segment_;
+    const ShmRingHeader* header_ = nullptr;
+    const ShmRingSlot<T>* slots_ = nullptr;
+    uint64_t capacity_ = 0;
+    uint64_t next_seq_ = 0;
+    uint64_t dropped_ = 0;
+    
+    void skip_to(uint64_t seq) noexcept {
+        dropped_ += seq - next_seq_;
+        next_seq_ = seq;
+    }
+};
+
+} // namespace core
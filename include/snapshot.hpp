@@ -0,0 +1,125 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "order_book.hpp"
+#include "messages.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+namespace book {
+
+#pragma pack(push, 1)
+
+/**
+ * @brief On-disk checkpoint header
+ *
+ * The checksum covers every byte that follows the header.
+ */
+struct SnapshotHeader {
+    char magic[8];              // "MFSNAP\0\0"
+    uint32_t version;
+    uint32_t header_size;       // sizeof(SnapshotHeader)
+    uint64_t feed_offset;       // Decoder position of the next unapplied message
+    uint64_t message_count;     // Messages consumed up to feed_offset
+    uint64_t feed_checksum;     // FNV-1a 64 of the feed bytes before feed_offset
+    uint32_t book_count;
+    uint32_t reserved;
+    uint64_t order_count;
+    uint64_t payload_size;      // Bytes after the header
+    uint64_t checksum;          // FNV-1a 64 of the payload
+};
+
+/**
+ * @brief Per-book section header, followed by order_count SnapshotOrder records
+ */
+struct SnapshotBook {
+    char symbol[6];             // space-padded ASCII
+    uint16_t reserved;
+    uint64_t order_count;
+};
+
+/**
+ * @brief Resting order record
+ */
+struct SnapshotOrder {
+    uint64_t order_id;
+    int64_t price;              // price in nano-units
+    uint32_t quantity;
+    char side;                  // 'B' or 'S'
+    char reserved[3];
+};
+
+#pragma pack(pop)
+
+inline constexpr char SNAPSHOT_MAGIC[8] = {'M', 'F', 'S', 'N', 'A', 'P', '\0', '\0'};
+inline constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+/**
+ * @brief Feed position recorded alongside the books
+ */
+struct SnapshotPosition {
+    uint64_t feed_offset = 0;
+    uint64_t message_count = 0;
+    uint64_t feed_checksum = 0;   // snapshot_checksum() of the feed before feed_offset
+};
+
+/**
+ * @brief Write a checkpoint of all books to a file
+ *
+ * The file is written to "<filename>.tmp" and renamed into place, so a crash
+ * never leaves a truncated checkpoint behind.
+ *
+ * Instantiated for OrderBook, DenseOrderBook, PackedOrderBook and
+ * DensePackedOrderBook.
+ *
+ * @param filename Checkpoint path
+ * @param books Order books keyed by symbol
+ * @param position Feed position the books correspond to
+ * @throws std::runtime_error on I/O failure
+ */
+template<typename Book>
+void save_snapshot(const std::string& filename,
+                   const std::unordered_map<feed::Symbol, Book>& books,
+                   const SnapshotPosition& position);
+
+/**
+ * @brief Restore books from a checkpoint file (memory-mapped)
+ *
+ * Books present in the checkpoint but missing from @p books are skipped;
+ * books that are restored are cleared first.
+ *
+ * @param filename Checkpoint path
+ * @param books Order books keyed by symbol
+ * @return Feed position to resume replay from
+ * @throws std::runtime_error if the file is missing, truncated, of an
+ *         unsupported version or fails checksum verification
+ */
+template<typename Book>
+SnapshotPosition load_snapshot(const std::string& filename,
+                               std::unordered_map<feed::Symbol, Book>& books);
+
+/**
+ * @brief FNV-1a 64-bit checksum
+ */
+uint64_t snapshot_checksum(const void* data, size_t size) noexcept;
+
+/**
+ * @brief Check that a checkpoint was taken on this feed
+ *
+ * The feed may have grown since; only the bytes the checkpoint covers must
+ * match.
+ *
+ * @param position Position returned by load_snapshot()
+ * @param feed Bytes of the feed to resume
+ * @throws std::runtime_error if the feed is shorter than feed_offset or its
+ *         bytes before feed_offset differ from the checkpointed feed's
+ */
+void verify_snapshot_feed(const SnapshotPosition& position, std::span<const char> feed);
+
+} // namespace book
@@ -0,0 +1,210 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "publisher.hpp"
+#include "binary_publisher.hpp"
+#include "shm_publisher.hpp"
+#include "udp_publisher.hpp"
+#include "columnar.hpp"
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace publish {
+
+/**
+ * @brief Destination for top-of-book records
+ *
+ * write() takes one record (symbol_id is the caller's symbol index) together
+ * with its symbol; end_round() follows the last record of a publish round
+ * and is where batching sinks push data out. Sinks are plain types called
+ * directly, so a pipeline templated on its sink pays no virtual calls; pick
+ * one at startup by visiting a std::variant of sinks outside the hot loop.
+ */
+template<typename S>
+concept TopOfBookSink = std::copy_constructible<S> &&
+    requires(S& sink, const BinaryTobRecord& record, const feed::Symbol& symbol) {
+        sink.write(record, symbol);
+        sink.end_round();
+    };
+
+/**
+ * @brief CSV rows through a TopOfBookPublisher, flushed once per round
+ */
+class CsvSink {
+public:
+    explicit CsvSink(TopOfBookPublisher& publisher) noexcept : publisher_(&publisher) {}
+    
+    void write(const BinaryTobRecord& record, const feed::Symbol& symbol) {
+        publisher_->publish(record.ts_us, symbol, to_top_of_book(record));
+    }
+    
+    void end_round() {
+        publisher_->flush();
+    }
+
+private:
+    TopOfBookPublisher* publisher_;
+};
+
+/**
+ * @brief Fixed binary records; the publisher's write buffer does the batching
+ */
+class BinarySink {
+public:
+    explicit BinarySink(BinaryTopOfBookPublisher& publisher) noexcept : publisher_(&publisher) {}
+    
+    void write(const BinaryTobRecord& record, const feed::Symbol&) {
+        publisher_->publish(record);
+    }
+    
+    void end_round() noexcept {}
+
+private:
+    BinaryTopOfBookPublisher* publisher_;
+};
+
+/**
+ * @brief Records into a shared-memory ring, visible to readers immediately
+ */
+class ShmSink {
+public:
+    explicit ShmSink(ShmTopOfBookPublisher& publisher) noexcept : publisher_(&publisher) {}
+    
+    void write(const BinaryTobRecord& record, const feed::Symbol& symbol) {
+        publisher_->publish(to_tob_record(record, symbol));
+    }
+    
+    void end_round() noexcept {}
+
+private:
+    ShmTopOfBookPublisher* publisher_;
+};
+
+/**
+ * @brief Multicast datagrams, sent at the end of every round
+ */
+class UdpSink {
+public:
+    explicit UdpSink(UdpTopOfBookPublisher& publisher) noexcept : publisher_(&publisher) {}
+    
+    void write(const BinaryTobRecord& record, const feed::Symbol& symbol) {
+        publisher_->publish(to_tob_record(record, symbol));
+    }
+    
+    void end_round() {
+        publisher_->flush();
+    }
+
+private:
+    UdpTopOfBookPublisher* publisher_;
+};
+
+/**
+ * @brief Rows of a columnar top-of-book history (columnar_tob_columns())
+ */
+class ColumnarSink {
+public:
+    explicit ColumnarSink(ColumnarWriter& writer) noexcept : writer_(&writer) {}
+    
+    void write(const BinaryTobRecord& record, const feed::Symbol&) {
+        const int64_t row[] = {static_cast<int64_t>(record.ts_us), record.symbol_id, record.bid_px,
+                               record.bid_sz, record.ask_px, record.ask_sz};
+        writer_->append(row);
+    }
+    
+    void end_round() noexcept {}
+
+private:
+    ColumnarWriter* writer_;
+};
+
+/**
+ * @brief Discards everything; for measuring the pipeline without I/O
+ */
+class NullSink {
+public:
+    void write(const BinaryTobRecord&, const feed::Symbol&) noexcept {
+        records_++;
+    }
+    
+    void end_round() noexcept {
+        rounds_++;
+    }
+    
+    uint64_t records() const noexcept { return records_; }
+    uint64_t rounds() const noexcept { return rounds_; }
+
+private:
+    uint64_t records_ = 0;
+    uint64_t rounds_ = 0;
+};
+
+/**
+ * @brief A sink that may or may not be configured
+ */
+template<TopOfBookSink S>
+class OptionalSink {
+public:
+    OptionalSink() = default;
+    explicit OptionalSink(S sink) : sink_(std::move(sink)) {}
+    
+    void write(const BinaryTobRecord& record, const feed::Symbol& symbol) {
+        if (sink_) {
+            sink_->write(record, symbol);
+        }
+    }
+    
+    void end_round() {
+        if (sink_) {
+            sink_->end_round();
+        }
+    }
+    
+    bool has_value() const noexcept { return sink_.has_value(); }
+
+private:
+    std::optional<S> sink_;
+};
+
+/**
+ * @brief Hands every record to each of several sinks, in order
+ */
+template<TopOfBookSink... Sinks>
+class FanOutSink {
+public:
+    explicit FanOutSink(Sinks... sinks) : sinks_(std::move(sinks)...) {}
+    
+    void write(const BinaryTobRecord& record, const feed::Symbol& symbol) {
+        std::apply([&](auto&... sink) { (sink.write(record, symbol), ...); }, sinks_);
+    }
+    
+    void end_round() {
+        std::apply([](auto&... sink) { (sink.end_round(), ...); }, sinks_);
+    }
+    
+    /**
+     * @brief Access one of the sinks
+     */
+    template<size_t I>
+    auto& get() noexcept { return std::get<I>(sinks_); }
+
+private:
+    std::tuple<Sinks...> sinks_;
+};
+
+static_assert(TopOfBookSink<CsvSink>);
+static_assert(TopOfBookSink<BinarySink>);
+static_assert(TopOfBookSink<ShmSink>);
+static_assert(TopOfBookSink<UdpSink>);
+static_assert(TopOfBookSink<ColumnarSink>);
+static_assert(TopOfBookSink<NullSink>);
+static_assert(TopOfBookSink<FanOutSink<CsvSink, OptionalSink<UdpSink>>>);
+
+} // namespace publish
@@ -0,0 +1,161 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "order_book.hpp"
+#include "messages.hpp"
+#include <atomic>
+#include <memory>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace book {
+
+/**
+ * @brief Consistent read of one TopOfBookTable entry
+ */
+struct Quote {
+    TopOfBook tob;
+    uint64_t ts_us = 0;    // Writer timestamp of the update
+    uint64_t version = 0;  // Number of updates so far (0 = never written)
+};
+
+/**
+ * @brief Per-symbol top of book, written by the book thread and readable from any thread
+ *
+ * Each entry is a seqlock in its own cache line: the writer makes the
+ * sequence odd, stores the fields and makes it even again; a reader retries
+ * if the sequence was odd or changed while it copied the fields. Readers
+ * never write shared memory, so any number of them cost the writer nothing
+ * beyond the cache line they pull, and the writer never waits for them.
+ *
+ * Register every symbol with add_symbol() before any thread reads the table.
+ */
+class TopOfBookTable {
+public:
+    /**
+     * @brief Construct a table with room for capacity symbols
+     */
+    explicit TopOfBookTable(size_t capacity)
+        : capacity_(capacity), entries_(std::make_unique<Entry[]>(capacity)) {}
+    
+    TopOfBookTable(const TopOfBookTable&) = delete;
+    TopOfBookTable& operator=(const TopOfBookTable&) = delete;
+    
+    /**
+     * @brief Register a symbol (not thread-safe; call before the table is shared)
+     * @return Entry index for update() and read()
+     */
+    size_t add_symbol(const feed::Symbol& symbol) {
+        assert(symbols_.size() < capacity_ && "TopOfBookTable is full");
+        symbols_.push_back(symbol);
+        last_.emplace_back();
+        return symbols_.size() - 1;
+    }
+    
+    /**
+     * @brief Look up a registered symbol
+     * @return Entry index, or nullopt if the symbol was never added
+     */
+    std::optional<size_t> find(const feed::Symbol& symbol) const noexcept {
+        for (size_t index = 0; index < symbols_.size(); ++index) {
+            if (symbols_[index] == symbol) {
+                return index;
+            }
+        }
+        return std::nullopt;
+    }
+    
+    /**
+     * @brief Publish a new top of book if it differs from the last one (single writer)
+     * @param index Entry index from add_symbol()
+     * @param tob Current top of book
+     * @param ts_us Timestamp stored with the update
+     * @return true if the entry was written
+     */
+    bool update(size_t index, const TopOfBook& tob, uint64_t ts_us) noexcept {
+        TopOfBook& last = last_[index];
+        if (tob.best_bid_px == last.best_bid_px && tob.bid_sz == last.bid_sz &&
+            tob.best_ask_px == last.best_ask_px && tob.ask_sz == last.ask_sz) {
+            return false;
+        }
+        last = tob;
+        
+        Entry& entry = entries_[index];
+        const uint64_t sequence = entry.sequence.load(std::memory_order_relaxed);
+        entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.bid_px.store(tob.best_bid_px, std::memory_order_relaxed);
+        entry.ask_px.store(tob.best_ask_px, std::memory_order_relaxed);
+        entry.sizes.store((static_cast<uint64_t>(tob.bid_sz) << 32) | tob.ask_sz, std::memory_order_relaxed);
+        entry.ts_us.store(ts_us, std::memory_order_relaxed);
+        entry.sequence.store(sequence + 2, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Read an entry without locking (any thread)
+     *
+     * Spins only while the writer is inside update(), which is a handful of
+     * stores.
+     *
+     * @param index Entry index from add_symbol() or find()
+     * @return Fields from a single update
+     */
+    Quote read(size_t index) const noexcept {
+        const Entry& entry = entries_[index];
+        Quote quote;
+        for (;;) {
+            const uint64_t before = entry.sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;  // Writer in progress
+            }
+            quote.tob.best_bid_px = entry.bid_px.load(std::memory_order_relaxed);
+            quote.tob.best_ask_px = entry.ask_px.load(std::memory_order_relaxed);
+            const uint64_t sizes = entry.sizes.load(std::memory_order_relaxed);
+            quote.ts_us = entry.ts_us.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (entry.sequence.load(std::memory_order_relaxed) == before) {
+                quote.tob.bid_sz = static_cast<uint32_t>(sizes >> 32);
+                quote.tob.ask_sz = static_cast<uint32_t>(sizes);
+                quote.version = before / 2;
+                return quote;
+            }
+        }
+    }
+    
+    /**
+     * @brief Symbol registered at an index
+     */
+    const feed::Symbol& symbol(size_t index) const noexcept {
+        return symbols_[index];
+    }
+    
+    /**
+     * @brief Number of registered symbols
+     */
+    size_t size() const noexcept {
+        return symbols_.size();
+    }
+
+private:
+    struct alignas(64) Entry {
+        std::atomic<uint64_t> sequence{0};  // Odd while an update is in progress
+        std::atomic<int64_t> bid_px{0};
+        std::atomic<int64_t> ask_px{0};
+        std::atomic<uint64_t> sizes{0};     // bid_sz << 32 | ask_sz
+        std::atomic<uint64_t> ts_us{0};
+    };
+    
+    const size_t capacity_;
+    std::unique_ptr<Entry[]> entries_;
+    std::vector<feed::Symbol> symbols_;
+    std::vector<TopOfBook> last_;  // Writer-only copy of each entry
+};
+
+} // namespace book
@@ -0,0 +1,68 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "trades.hpp"
+#include "messages.hpp"
+#include <iostream>
+
+namespace publish {
+
+/**
+ * @brief CSV publisher for trades
+ *
+ * Rows are ts_us,symbol,order_id,side,price,quantity where side is the
+ * resting order's side (B or S). Output is buffered; call flush() to push it.
+ */
+class TradePublisher {
+public:
+    explicit TradePublisher(std::ostream& output);
+    
+    /**
+     * @brief Write one trade (and the header before the first one)
+     */
+    void publish(const feed::Symbol& symbol, const book::Trade& trade);
+    
+    void flush();
+    
+    /**
+     * @brief Trades written so far
+     */
+    uint64_t published() const noexcept { return published_; }
+
+private:
+    std::ostream& output_;
+    uint64_t published_ = 0;
+};
+
+/**
+ * @brief CSV publisher for OHLCV bars
+ *
+ * Rows are start_us,interval_us,symbol,open,high,low,close,volume,trades,vwap
+ * with prices in decimal units. Output is buffered; call flush() to push it.
+ */
+class BarPublisher {
+public:
+    explicit BarPublisher(std::ostream& output);
+    
+    /**
+     * @brief Write one bar (and the header before the first one)
+     */
+    void publish(const feed::Symbol& symbol, const book::Bar& bar);
+    
+    void flush();
+    
+    /**
+     * @brief Bars written so far
+     */
+    uint64_t published() const noexcept { return published_; }
+
+private:
+    std::ostream& output_;
+    uint64_t published_ = 0;
+};
+
+} // namespace publish
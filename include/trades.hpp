@@ -0,0 +1,147 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "order_book.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace book {
+
+/**
+ * @brief One fill, derived from an EXECUTE message
+ *
+ * price and side are those of the resting order that traded; the feed's
+ * execute message carries neither.
+ */
+struct Trade {
+    uint64_t ts_us = 0;         // Feed timestamp of the execute message
+    uint64_t order_id = 0;      // Resting order
+    int64_t price = 0;          // Nano-units
+    uint32_t quantity = 0;
+    Side resting_side = Side::BUY;
+};
+
+/**
+ * @brief Open/high/low/close, volume and VWAP over one interval
+ */
+struct Bar {
+    uint64_t start_us = 0;      // Interval start, a multiple of the interval
+    uint64_t interval_us = 0;
+    int64_t open = 0;
+    int64_t high = 0;
+    int64_t low = 0;
+    int64_t close = 0;
+    uint64_t volume = 0;
+    uint64_t trades = 0;
+    double notional = 0.0;      // Sum of price * quantity, in nano-units
+    
+    uint64_t end_us() const noexcept { return start_us + interval_us; }
+    
+    /**
+     * @brief Volume-weighted average price in nano-units (0 for an empty bar)
+     */
+    double vwap() const noexcept { return volume == 0 ? 0.0 : notional / static_cast<double>(volume); }
+};
+
+/**
+ * @brief Builds bars of one interval from a stream of trades
+ *
+ * Bars are aligned to multiples of the interval in feed time and cover
+ * [start_us, start_us + interval_us). Intervals without trades produce no
+ * bar. A trade stamped before the open bar's start (out-of-order feed) is
+ * added to the open bar rather than reopening a closed one.
+ */
+class BarAggregator {
+public:
+    /**
+     * @brief Constructor
+     * @param interval_us Bar length in microseconds (at least 1)
+     * @throws std::invalid_argument if interval_us is 0
+     */
+    explicit BarAggregator(uint64_t interval_us) : interval_us_(interval_us) {
+        if (interval_us == 0) {
+            throw std::invalid_argument("Bar interval must be at least 1us");
+        }
+    }
+    
+    /**
+     * @brief Add one trade
+     * @param trade Trade to add
+     * @param completed Set to the previous bar if this trade closed it
+     * @return true if completed was set
+     */
+    bool on_trade(const Trade& trade, Bar& completed) noexcept {
+        if (open_ && trade.ts_us < current_.end_us()) {
+            add(trade);
+            return false;
+        }
+        const bool closed = open_;
+        if (closed) {
+            completed = current_;
+        }
+        start(trade);
+        return closed;
+    }
+    
+    /**
+     * @brief Close the open bar if feed time has passed its end
+     * @param now_us Current feed time
+     * @param completed Set to the closed bar
+     * @return true if a bar was closed
+     */
+    bool close_if_due(uint64_t now_us, Bar& completed) noexcept {
+        if (!open_ || now_us < current_.end_us()) {
+            return false;
+        }
+        completed = current_;
+        open_ = false;
+        return true;
+    }
+    
+    /**
+     * @brief Close the open bar regardless of time, e.g. at the end of the feed
+     * @return true if there was an open bar
+     */
+    bool finish(Bar& completed) noexcept {
+        if (!open_) {
+            return false;
+        }
+        completed = current_;
+        open_ = false;
+        return true;
+    }
+    
+    bool has_open_bar() const noexcept { return open_; }
+    const Bar& current() const noexcept { return current_; }
+    uint64_t interval_us() const noexcept { return interval_us_; }
+
+private:
+    uint64_t interval_us_;
+    Bar current_;
+    bool open_ = false;
+    
+    void start(const Trade& trade) noexcept {
+        current_ = Bar();
+        current_.start_us = trade.ts_us - trade.ts_us % interval_us_;
+        current_.interval_us = interval_us_;
+        current_.open = current_.high = current_.low = trade.price;
+        open_ = true;
+        add(trade);
+    }
+    
+    void add(const Trade& trade) noexcept {
+        current_.high = std::max(current_.high, trade.price);
+        current_.low = std::min(current_.low, trade.price);
+        current_.close = trade.price;
+        current_.volume += trade.quantity;
+        current_.trades++;
+        current_.notional += static_cast<double>(trade.price) * trade.quantity;
+    }
+};
+
+} // namespace book
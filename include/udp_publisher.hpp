@@ -0,0 +1,223 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+#include "publisher.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace publish {
+
+constexpr char UDP_TOB_MAGIC[4] = {'M', 'F', 'T', 'U'};
+constexpr uint16_t UDP_TOB_VERSION = 1;
+
+/**
+ * @brief Header of one top-of-book datagram
+ *
+ * Followed by record_count TobRecords. sequence counts datagrams from 1 per
+ * session; a publisher picks a new session id each time it starts, so
+ * receivers can tell a restart from a gap.
+ */
+struct UdpTobHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t record_count;
+    uint32_t session;
+    uint32_t reserved;
+    uint64_t sequence;
+};
+
+static_assert(sizeof(UdpTobHeader) == 24, "UdpTobHeader is a wire format");
+
+// Largest datagram we send: fits an Ethernet frame after the IP and UDP headers
+constexpr size_t UDP_TOB_MAX_DATAGRAM = 1472;
+constexpr size_t UDP_TOB_MAX_RECORDS = (UDP_TOB_MAX_DATAGRAM - sizeof(UdpTobHeader)) / sizeof(TobRecord);
+
+/**
+ * @brief Write one datagram
+ * @param header Header to write; record_count is taken from records
+ * @param records At most UDP_TOB_MAX_RECORDS records
+ * @param out Destination, at least UDP_TOB_MAX_DATAGRAM bytes
+ * @return Datagram size in bytes
+ */
+size_t encode_udp_datagram(const UdpTobHeader& header, std::span<const TobRecord> records, char* out) noexcept;
+
+/**
+ * @brief Parse one datagram
+ * @param datagram Received bytes
+ * @param header Destination header
+ * @param records Records are appended here
+ * @return false (and nothing appended) on a bad magic, version or length
+ */
+bool decode_udp_datagram(std::span<const char> datagram, UdpTobHeader& header, std::vector<TobRecord>& records);
+
+/**
+ * @brief Gap statistics for one stream of datagram sequence numbers
+ *
+ * Datagrams that arrive below the expected sequence (duplicates or
+ * reordered) are counted as late; they do not reduce missing.
+ */
+class UdpSequenceTracker {
+public:
+    /**
+     * @brief Account for one received datagram
+     */
+    void on_datagram(const UdpTobHeader& header) noexcept;
+    
+    uint64_t datagrams() const noexcept { return datagrams_; }
+    uint64_t gaps() const noexcept { return gaps_; }
+    uint64_t missing() const noexcept { return missing_; }
+    uint64_t late() const noexcept { return late_; }
+    uint64_t sessions() const noexcept { return sessions_; }
+
+private:
+    uint32_t session_ = 0;
+    uint64_t expected_ = 0;
+    uint64_t datagrams_ = 0;
+    uint64_t gaps_ = 0;
+    uint64_t missing_ = 0;
+    uint64_t late_ = 0;
+    uint64_t sessions_ = 0;
+};
+
+/**
+ * @brief Publishes TobRecords to a UDP multicast group
+ *
+ * Records are packed into datagrams of up to records_per_datagram records;
+ * full datagrams are queued and handed to the kernel batch_datagrams at a
+ * time with one sendmmsg() call. flush() sends whatever is queued, so call it
+ * once per publish round. The TTL is 0: datagrams never leave the host.
+ */
+class UdpTopOfBookPublisher {
+public:
+    /**
+     * @brief Open the sending socket
+     * @param group Multicast group, e.g. "239.255.0.1"
+     * @param port Destination port
+     * @param interface Address of the sending interface (default: loopback)
+     * @param batch_datagrams Datagrams per sendmmsg() call
+     * @param records_per_datagram At most UDP_TOB_MAX_RECORDS
+     * @throws std::runtime_error if the socket cannot be set up
+     */
+    UdpTopOfBookPublisher(const std::string& group, uint16_t port, const std::string& interface = "127.0.0.1",
+                          size_t batch_datagrams = 32, size_t records_per_datagram = UDP_TOB_MAX_RECORDS);
+    
+    /**
+     * @brief Flush and close (send errors are ignored)
+     */
+    ~UdpTopOfBookPublisher();
+    
+    UdpTopOfBookPublisher(const UdpTopOfBookPublisher&) = delete;
+    UdpTopOfBookPublisher& operator=(const UdpTopOfBookPublisher&) = delete;
+    
+    /**
+     * @brief Queue one record
+     * @throws std::runtime_error if a full batch cannot be sent
+     */
+    void publish(uint64_t timestamp_us, const feed::Symbol& symbol, const book::TopOfBook& tob);
+    
+    /**
+     * @brief Queue one prebuilt record
+     * @throws std::runtime_error if a full batch cannot be sent
+     */
+    void publish(const TobRecord& record);
+    
+    /**
+     * @brief Close the current datagram and send every queued one
+     * @throws std::runtime_error on a send error
+     */
+    void flush();
+    
+    /**
+     * @brief Records sent so far
+     */
+    uint64_t published() const noexcept { return records_sent_; }
+    
+    /**
+     * @brief Datagrams sent so far
+     */
+    uint64_t datagrams() const noexcept { return next_sequence_ - 1 - queued_; }
+    
+    /**
+     * @brief sendmmsg() calls so far
+     */
+    uint64_t send_calls() const noexcept { return send_calls_; }
+    
+    /**
+     * @brief Session id carried in every datagram header
+     */
+    uint32_t session() const noexcept { return session_; }
+
+private:
+    int fd_ = -1;
+    const size_t batch_;
+    const size_t records_per_datagram_;
+    uint32_t session_;
+    uint64_t next_sequence_ = 1;
+    std::vector<char> buffers_;      // batch_ datagrams of UDP_TOB_MAX_DATAGRAM bytes
+    std::vector<TobRecord> current_; // Records of the datagram being filled
+    std::vector<iovec> iov_;
+    std::vector<mmsghdr> messages_;
+    size_t queued_ = 0;              // Sealed datagrams not yet sent
+    uint64_t records_sent_ = 0;
+    uint64_t records_queued_ = 0;
+    uint64_t send_calls_ = 0;
+    
+    void seal();
+    void send();
+};
+
+/**
+ * @brief Joins a multicast group and receives datagrams in batches
+ */
+class UdpTobReceiver {
+public:
+    /**
+     * @brief Bind to port and join group on the given interface
+     * @throws std::runtime_error if the socket cannot be set up
+     */
+    UdpTobReceiver(const std::string& group, uint16_t port, const std::string& interface = "127.0.0.1",
+                   size_t batch_datagrams = 32);
+    
+    ~UdpTobReceiver();
+    
+    UdpTobReceiver(const UdpTobReceiver&) = delete;
+    UdpTobReceiver& operator=(const UdpTobReceiver&) = delete;
+    
+    /**
+     * @brief Wait for datagrams and read as many as are ready (one recvmmsg())
+     * @param timeout_ms How long to wait for the first one; -1 waits forever
+     * @return Number of datagrams received; 0 on timeout or EINTR
+     * @throws std::runtime_error on a receive error
+     */
+    size_t receive(int timeout_ms);
+    
+    /**
+     * @brief One datagram from the last receive()
+     */
+    std::span<const char> datagram(size_t index) const noexcept {
+        return std::span<const char>(&buffers_[index * UDP_TOB_MAX_DATAGRAM], messages_[index].msg_len);
+    }
+
+private:
+    int fd_ = -1;
+    std::vector<char> buffers_;
+    std::vector<iovec> iov_;
+    std::vector<mmsghdr> messages_;
+};
+
+/**
+ * @brief Split "GROUP:PORT" into its parts
+ * @throws std::invalid_argument if there is no valid port
+ */
+std::pair<std::string, uint16_t> parse_udp_endpoint(const std::string& endpoint);
+
+} // namespace publish
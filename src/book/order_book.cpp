@@ -8,29 +8,40 @@
 
 namespace book {
 
-bool OrderBook::on_add(uint64_t order_id, Side side, int64_t price, uint32_t quantity) {
+template<template<typename> class L, template<typename> class I, typename R>
+bool BasicOrderBook<L, I, R>::on_add(uint64_t order_id, Side side, int64_t price, uint32_t quantity) {
     // Check if order already exists
-    if (orders_.find(order_id) != orders_.end()) {
+    if (orders_.find(order_id) != nullptr) {
+        return false;
+    }
+    
+    // Price must be representable by this book
+    Tick ticks;
+    if (!to_ticks(side, price, ticks)) {
+        ++price_rejects_;
         return false;
     }
     
     // Check for crossing (would create invalid book state)
-    if (has_crossing(side, price)) {
+    if (has_crossing(side, ticks)) {
         return false;
     }
     
-    // Add to orders map
-    orders_.emplace(order_id, OrderInfo(side, price, quantity));
+    // Add to orders index
+    if (!orders_.insert(order_id, R(side, ticks, quantity))) {
+        return false;
+    }
     
     // Add to price level
-    add_to_level(side, price, quantity);
+    add_to_level(side, ticks, quantity);
     
     return true;
 }
 
-bool OrderBook::on_modify(uint64_t order_id, int64_t new_price, uint32_t new_quantity) {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
+template<template<typename> class L, template<typename> class I, typename R>
+bool BasicOrderBook<L, I, R>::on_modify(uint64_t order_id, int64_t new_price, uint32_t new_quantity) {
+    R* order = orders_.find(order_id);
+    if (order == nullptr) {
         return false;
     }
     
@@ -38,129 +49,303 @@ bool OrderBook::on_modify(uint64_t order_id, int64_t new_price, uint32_t new_qua
         return false;
     }
     
-    OrderInfo& order = it->second;
+    Tick new_ticks;
+    if (!to_ticks(order->side(), new_price, new_ticks)) {
+        ++price_rejects_;
+        return false;
+    }
     
     // Check for crossing with new price
-    if (has_crossing(order.side, new_price)) {
+    if (has_crossing(order->side(), new_ticks)) {
         return false;
     }
     
     // Remove old quantity from old price level
-    remove_from_level(order.side, order.price, order.quantity);
+    remove_from_level(order->side(), order->ticks(), order->quantity());
     
     // Update order
-    order.price = new_price;
-    order.quantity = new_quantity;
+    order->set_ticks(new_ticks);
+    order->set_quantity(new_quantity);
     
     // Add new quantity to new price level
-    add_to_level(order.side, new_price, new_quantity);
+    add_to_level(order->side(), new_ticks, new_quantity);
     
     return true;
 }
 
-bool OrderBook::on_execute(uint64_t order_id, uint32_t exec_quantity) {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
+template<template<typename> class L, template<typename> class I, typename R>
+bool BasicOrderBook<L, I, R>::on_execute(uint64_t order_id, uint32_t exec_quantity) {
+    OrderInfo resting;
+    return on_execute(order_id, exec_quantity, resting);
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+bool BasicOrderBook<L, I, R>::on_execute(uint64_t order_id, uint32_t exec_quantity, OrderInfo& resting) {
+    R* order = orders_.find(order_id);
+    if (order == nullptr) {
         return false;
     }
     
-    OrderInfo& order = it->second;
-    if (exec_quantity > order.quantity) {
+    if (exec_quantity > order->quantity()) {
         return false; // Cannot execute more than available
     }
+    resting = OrderInfo(order->side(), grid_.to_price(order->ticks()), order->quantity());
     
     // Remove executed quantity from price level
-    remove_from_level(order.side, order.price, exec_quantity);
+    remove_from_level(order->side(), order->ticks(), exec_quantity);
     
     // Update order quantity
-    order.quantity -= exec_quantity;
+    order->set_quantity(order->quantity() - exec_quantity);
     
     // If fully executed, remove order
-    if (order.quantity == 0) {
-        orders_.erase(it);
+    if (order->quantity() == 0) {
+        orders_.erase(order_id);
     }
     
     return true;
 }
 
-bool OrderBook::on_delete(uint64_t order_id) {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
+template<template<typename> class L, template<typename> class I, typename R>
+bool BasicOrderBook<L, I, R>::on_delete(uint64_t order_id) {
+    const R* order = orders_.find(order_id);
+    if (order == nullptr) {
         return false;
     }
     
-    const OrderInfo& order = it->second;
-    
     // Remove from price level
-    remove_from_level(order.side, order.price, order.quantity);
+    remove_from_level(order->side(), order->ticks(), order->quantity());
     
-    // Remove from orders map
-    orders_.erase(it);
+    // Remove from orders index
+    orders_.erase(order_id);
     
     return true;
 }
 
-TopOfBook OrderBook::top_of_book() const {
+template<template<typename> class L, template<typename> class I, typename R>
+void BasicOrderBook<L, I, R>::clear() {
+    bids_.clear();
+    asks_.clear();
+    orders_.clear();
+    bid_analytics_.dirty = true;
+    ask_analytics_.dirty = true;
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+void BasicOrderBook<L, I, R>::enable_analytics(size_t levels, uint32_t band_bps) {
+    analytics_levels_ = levels;
+    band_bps_ = band_bps;
+    bid_analytics_.dirty = true;
+    ask_analytics_.dirty = true;
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+double BasicOrderBook<L, I, R>::microprice() const {
+    if (bids_.empty() || asks_.empty()) {
+        return 0.0;
+    }
+    const double bid_px = static_cast<double>(grid_.to_price(bids_.best_price()));
+    const double ask_px = static_cast<double>(grid_.to_price(asks_.best_price()));
+    const double bid_sz = bids_.best_quantity();
+    const double ask_sz = asks_.best_quantity();
+    return (bid_px * ask_sz + ask_px * bid_sz) / (bid_sz + ask_sz);
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+uint64_t BasicOrderBook<L, I, R>::depth(Side side) const {
+    return analytics_levels_ == 0 ? 0 : side_analytics(side).depth;
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+uint64_t BasicOrderBook<L, I, R>::band_depth(Side side) const {
+    return analytics_levels_ == 0 ? 0 : side_analytics(side).band_depth;
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+double BasicOrderBook<L, I, R>::imbalance() const {
+    const double bid = static_cast<double>(depth(Side::BUY));
+    const double ask = static_cast<double>(depth(Side::SELL));
+    return bid + ask == 0.0 ? 0.0 : (bid - ask) / (bid + ask);
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+BookAnalytics BasicOrderBook<L, I, R>::analytics() const {
+    BookAnalytics result;
+    result.microprice = microprice();
+    result.imbalance = imbalance();
+    result.bid_depth = depth(Side::BUY);
+    result.ask_depth = depth(Side::SELL);
+    result.bid_band_depth = band_depth(Side::BUY);
+    result.ask_band_depth = band_depth(Side::SELL);
+    return result;
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+TopOfBook BasicOrderBook<L, I, R>::top_of_book() const {
     TopOfBook tob;
     
     // Get best bid (highest price)
     if (!bids_.empty()) {
-        auto best_bid = bids_.begin();
-        tob.best_bid_px = best_bid->first;
-        tob.bid_sz = best_bid->second;
+        tob.best_bid_px = grid_.to_price(bids_.best_price());
+        tob.bid_sz = bids_.best_quantity();
     }
     
     // Get best ask (lowest price)
     if (!asks_.empty()) {
-        auto best_ask = asks_.begin();
-        tob.best_ask_px = best_ask->first;
-        tob.ask_sz = best_ask->second;
+        tob.best_ask_px = grid_.to_price(asks_.best_price());
+        tob.ask_sz = asks_.best_quantity();
     }
     
     return tob;
 }
 
-void OrderBook::add_to_level(Side side, int64_t price, uint32_t quantity) {
+template<template<typename> class L, template<typename> class I, typename R>
+bool BasicOrderBook<L, I, R>::to_ticks(Side side, int64_t price, Tick& ticks) const {
+    // Convert at the book boundary: on the grid, storable in the record and
+    // within the level store's range
+    int64_t grid_ticks;
+    if (!grid_.to_ticks(price, grid_ticks) || !R::fits(grid_ticks)) {
+        return false;
+    }
+    ticks = static_cast<Tick>(grid_ticks);
+    return side == Side::BUY ? bids_.can_hold(ticks) : asks_.can_hold(ticks);
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+void BasicOrderBook<L, I, R>::add_to_level(Side side, Tick ticks, uint32_t quantity) {
     if (side == Side::BUY) {
-        bids_[price] += quantity;
+        const size_t count = bids_.level_count();
+        bids_.add(ticks, quantity);
+        if (analytics_levels_ != 0) {
+            track_level_change(side, bids_, bid_analytics_, ticks, quantity, count);
+        }
     } else {
-        asks_[price] += quantity;
+        const size_t count = asks_.level_count();
+        asks_.add(ticks, quantity);
+        if (analytics_levels_ != 0) {
+            track_level_change(side, asks_, ask_analytics_, ticks, quantity, count);
+        }
     }
 }
 
-void OrderBook::remove_from_level(Side side, int64_t price, uint32_t quantity) {
+template<template<typename> class L, template<typename> class I, typename R>
+void BasicOrderBook<L, I, R>::remove_from_level(Side side, Tick ticks, uint32_t quantity) {
     if (side == Side::BUY) {
-        auto it = bids_.find(price);
-        if (it != bids_.end()) {
-            it->second -= quantity;
-            if (it->second == 0) {
-                bids_.erase(it);
-            }
+        const size_t count = bids_.level_count();
+        bids_.remove(ticks, quantity);
+        if (analytics_levels_ != 0) {
+            track_level_change(side, bids_, bid_analytics_, ticks, -int64_t{quantity}, count);
         }
     } else {
-        auto it = asks_.find(price);
-        if (it != asks_.end()) {
-            it->second -= quantity;
-            if (it->second == 0) {
-                asks_.erase(it);
-            }
+        const size_t count = asks_.level_count();
+        asks_.remove(ticks, quantity);
+        if (analytics_levels_ != 0) {
+            track_level_change(side, asks_, ask_analytics_, ticks, -int64_t{quantity}, count);
+        }
+    }
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+template<typename Levels>
+void BasicOrderBook<L, I, R>::track_level_change(Side side, const Levels& levels, SideAnalytics& stats, Tick ticks,
+                                                 int64_t delta, size_t count_before) noexcept {
+    if (stats.dirty) {
+        return;
+    }
+    const bool buy = side == Side::BUY;
+    const bool below_boundary = buy ? ticks < stats.boundary : ticks > stats.boundary;
+    if (levels.level_count() != count_before) {
+        // A level appeared or vanished. Below a full set of counted levels
+        // that moves neither the counted levels nor the best price (and so
+        // not the band); anywhere else, rebuild on the next read
+        if (!below_boundary || count_before < analytics_levels_) {
+            stats.dirty = true;
+            return;
+        }
+    } else if (!below_boundary) {
+        stats.depth += delta;
+    }
+    const int64_t price = grid_.to_price(ticks);
+    if (buy ? price >= stats.band_limit : price <= stats.band_limit) {
+        stats.band_depth += delta;
+    }
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+template<typename Levels>
+void BasicOrderBook<L, I, R>::refresh(Side side, const Levels& levels, SideAnalytics& stats) const {
+    stats = SideAnalytics();
+    stats.dirty = false;
+    if (levels.empty()) {
+        return;
+    }
+    const bool buy = side == Side::BUY;
+    const int64_t best = grid_.to_price(levels.best_price());
+    const int64_t band = static_cast<int64_t>(static_cast<double>(best) * band_bps_ / 10000.0);
+    stats.band_limit = buy ? best - band : best + band;
+    size_t counted = 0;
+    levels.for_each([&](Tick ticks, uint32_t quantity) {
+        if (counted < analytics_levels_) {
+            stats.depth += quantity;
+            stats.boundary = ticks;
+            counted++;
+        }
+        const int64_t price = grid_.to_price(ticks);
+        const bool in_band = buy ? price >= stats.band_limit : price <= stats.band_limit;
+        if (in_band) {
+            stats.band_depth += quantity;
         }
+        return counted < analytics_levels_ || in_band;
+    });
+}
+
+template<template<typename> class L, template<typename> class I, typename R>
+const typename BasicOrderBook<L, I, R>::SideAnalytics& BasicOrderBook<L, I, R>::side_analytics(Side side) const {
+    if (side == Side::BUY) {
+        if (bid_analytics_.dirty) {
+            refresh(side, bids_, bid_analytics_);
+        }
+        return bid_analytics_;
+    }
+    if (ask_analytics_.dirty) {
+        refresh(side, asks_, ask_analytics_);
     }
+    return ask_analytics_;
 }
 
-bool OrderBook::has_crossing(Side side, int64_t price) const {
+template<template<typename> class L, template<typename> class I, typename R>
+bool BasicOrderBook<L, I, R>::has_crossing(Side side, Tick ticks) const {
     if (side == Side::BUY) {
         // Buy order crosses if price >= best ask
         if (!asks_.empty()) {
-            return price >= asks_.begin()->first;
+            return ticks >= asks_.best_price();
         }
     } else {
         // Sell order crosses if price <= best bid
         if (!bids_.empty()) {
-            return price <= bids_.begin()->first;
+            return ticks <= bids_.best_price();
         }
     }
     return false;
 }
 
+// Every supported policy combination
+template class BasicOrderBook<MapLevels, HashOrderIndex>;
+template class BasicOrderBook<MapLevels, OpenAddressingOrderIndex>;
+template class BasicOrderBook<MapLevels, DirectOrderIndex>;
+template class BasicOrderBook<SortedVectorLevels, HashOrderIndex>;
+template class BasicOrderBook<SortedVectorLevels, OpenAddressingOrderIndex>;
+template class BasicOrderBook<SortedVectorLevels, DirectOrderIndex>;
+template class BasicOrderBook<FlatLadderLevels, HashOrderIndex>;
+template class BasicOrderBook<FlatLadderLevels, OpenAddressingOrderIndex>;
+template class BasicOrderBook<FlatLadderLevels, DirectOrderIndex>;
+template class BasicOrderBook<MapLevels, HashOrderIndex, PackedOrder>;
+template class BasicOrderBook<MapLevels, OpenAddressingOrderIndex, PackedOrder>;
+template class BasicOrderBook<MapLevels, DirectOrderIndex, PackedOrder>;
+template class BasicOrderBook<SortedVectorLevels, HashOrderIndex, PackedOrder>;
+template class BasicOrderBook<SortedVectorLevels, OpenAddressingOrderIndex, PackedOrder>;
+template class BasicOrderBook<SortedVectorLevels, DirectOrderIndex, PackedOrder>;
+template class BasicOrderBook<FlatLadderLevels, HashOrderIndex, PackedOrder>;
+template class BasicOrderBook<FlatLadderLevels, OpenAddressingOrderIndex, PackedOrder>;
+template class BasicOrderBook<FlatLadderLevels, DirectOrderIndex, PackedOrder>;
+
 } // namespace book
@@ -0,0 +1,225 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "snapshot.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace book {
+
+namespace {
+
+template<typename T>
+void append(std::vector<char>& buffer, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void write_all(int fd, const char* data, size_t size, const std::string& filename) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write snapshot: " + filename);
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+} // anonymous namespace
+
+uint64_t snapshot_checksum(const void* data, size_t size) noexcept {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void verify_snapshot_feed(const SnapshotPosition& position, std::span<const char> feed) {
+    if (position.feed_offset > feed.size() ||
+        snapshot_checksum(feed.data(), position.feed_offset) != position.feed_checksum) {
+        throw std::runtime_error("Checkpoint was taken on a different feed");
+    }
+}
+
+template<typename Book>
+void save_snapshot(const std::string& filename,
+                   const std::unordered_map<feed::Symbol, Book>& books,
+                   const SnapshotPosition& position) {
+    // Serialise the payload first so the header can carry its checksum
+    std::vector<char> payload;
+    uint64_t total_orders = 0;
+    for (const auto& [symbol, order_book] : books) {
+        total_orders += order_book.order_count();
+    }
+    payload.reserve(books.size() * sizeof(SnapshotBook) + total_orders * sizeof(SnapshotOrder));
+    
+    for (const auto& [symbol, order_book] : books) {
+        SnapshotBook section{};
+        std::memcpy(section.symbol, symbol.data, sizeof(section.symbol));
+        section.order_count = order_book.order_count();
+        append(payload, section);
+        
+        order_book.for_each_order([&](uint64_t order_id, const OrderInfo& info) {
+            SnapshotOrder record{};
+            record.order_id = order_id;
+            record.price = info.price;
+            record.quantity = info.quantity;
+            record.side = static_cast<char>(info.side);
+            append(payload, record);
+        });
+    }
+    
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.header_size = sizeof(SnapshotHeader);
+    header.feed_offset = position.feed_offset;
+    header.message_count = position.message_count;
+    header.feed_checksum = position.feed_checksum;
+    header.book_count = static_cast<uint32_t>(books.size());
+    header.order_count = total_orders;
+    header.payload_size = payload.size();
+    header.checksum = snapshot_checksum(payload.data(), payload.size());
+    
+    // Write to a temporary file and rename so readers never see a partial checkpoint
+    const std::string temp_filename = filename + ".tmp";
+    int fd = ::open(temp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        throw std::runtime_error("Failed to create snapshot: " + temp_filename);
+    }
+    
+    try {
+        write_all(fd, reinterpret_cast<const char*>(&header), sizeof(header), temp_filename);
+        write_all(fd, payload.data(), payload.size(), temp_filename);
+        if (::fsync(fd) == -1) {
+            throw std::runtime_error("Failed to sync snapshot: " + temp_filename);
+        }
+    } catch (...) {
+        ::close(fd);
+        ::unlink(temp_filename.c_str());
+        throw;
+    }
+    ::close(fd);
+    
+    if (::rename(temp_filename.c_str(), filename.c_str()) == -1) {
+        ::unlink(temp_filename.c_str());
+        throw std::runtime_error("Failed to rename snapshot into place: " + filename);
+    }
+}
+
+template<typename Book>
+SnapshotPosition load_snapshot(const std::string& filename,
+                               std::unordered_map<feed::Symbol, Book>& books) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Failed to open snapshot: " + filename);
+    }
+    
+    struct stat sb;
+    if (fstat(fd, &sb) == -1) {
+        ::close(fd);
+        throw std::runtime_error("Failed to get snapshot size: " + filename);
+    }
+    
+    const size_t file_size = static_cast<size_t>(sb.st_size);
+    if (file_size < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Snapshot is truncated: " + filename);
+    }
+    
+    void* mapped = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to memory map snapshot: " + filename);
+    }
+    
+    // Unmap on every exit path
+    struct Unmapper {
+        void* data;
+        size_t size;
+        ~Unmapper() { munmap(data, size); }
+    } unmapper{mapped, file_size};
+    
+    const char* data = static_cast<const char*>(mapped);
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a snapshot file: " + filename);
+    }
+    if (header.version != SNAPSHOT_VERSION || header.header_size != sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Unsupported snapshot version: " + filename);
+    }
+    if (header.payload_size != file_size - sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Snapshot is truncated: " + filename);
+    }
+    
+    const char* payload = data + sizeof(SnapshotHeader);
+    if (snapshot_checksum(payload, header.payload_size) != header.checksum) {
+        throw std::runtime_error("Snapshot checksum mismatch: " + filename);
+    }
+    
+    const char* cursor = payload;
+    const char* end = payload + header.payload_size;
+    for (uint32_t b = 0; b < header.book_count; ++b) {
+        if (static_cast<size_t>(end - cursor) < sizeof(SnapshotBook)) {
+            throw std::runtime_error("Snapshot is corrupt: " + filename);
+        }
+        SnapshotBook section;
+        std::memcpy(&section, cursor, sizeof(section));
+        cursor += sizeof(section);
+        
+        if (section.order_count > static_cast<size_t>(end - cursor) / sizeof(SnapshotOrder)) {
+            throw std::runtime_error("Snapshot is corrupt: " + filename);
+        }
+        const size_t section_bytes = section.order_count * sizeof(SnapshotOrder);
+        
+        feed::Symbol symbol;
+        std::memcpy(symbol.data, section.symbol, sizeof(symbol.data));
+        auto it = books.find(symbol);
+        if (it != books.end()) {
+            Book& order_book = it->second;
+            order_book.clear();
+            for (uint64_t i = 0; i < section.order_count; ++i) {
+                SnapshotOrder record;
+                std::memcpy(&record, cursor + i * sizeof(SnapshotOrder), sizeof(record));
+                Side side = (record.side == 'B') ? Side::BUY : Side::SELL;
+                order_book.on_add(record.order_id, side, record.price, record.quantity);
+            }
+        }
+        cursor += section_bytes;
+    }
+    
+    return SnapshotPosition{header.feed_offset, header.message_count, header.feed_checksum};
+}
+
+// Every book type the feed handler can run with
+template void save_snapshot(const std::string&, const std::unordered_map<feed::Symbol, OrderBook>&,
+                            const SnapshotPosition&);
+template void save_snapshot(const std::string&, const std::unordered_map<feed::Symbol, DenseOrderBook>&,
+                            const SnapshotPosition&);
+template void save_snapshot(const std::string&, const std::unordered_map<feed::Symbol, PackedOrderBook>&,
+                            const SnapshotPosition&);
+template void save_snapshot(const std::string&, const std::unordered_map<feed::Symbol, DensePackedOrderBook>&,
+                            const SnapshotPosition&);
+template SnapshotPosition load_snapshot(const std::string&, std::unordered_map<feed::Symbol, OrderBook>&);
+template SnapshotPosition load_snapshot(const std::string&, std::unordered_map<feed::Symbol, DenseOrderBook>&);
+template SnapshotPosition load_snapshot(const std::string&, std::unordered_map<feed::Symbol, PackedOrderBook>&);
+template SnapshotPosition load_snapshot(const std::string&, std::unordered_map<feed::Symbol, DensePackedOrderBook>&);
+
+} // namespace book
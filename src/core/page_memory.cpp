@@ -0,0 +1,136 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "page_memory.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace core {
+
+namespace {
+
+constexpr size_t SMALL_PAGE = 4096;
+constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;
+constexpr int MPOL_BIND_MODE = 2;  // MPOL_BIND from <linux/mempolicy.h>
+
+size_t round_up(size_t bytes, size_t page) noexcept {
+    return (bytes + page - 1) & ~(page - 1);
+}
+
+bool bind_to_node(void* data, size_t size, int node) noexcept {
+#ifdef SYS_mbind
+    if (node < 0 || node >= 64) {
+        return false;
+    }
+    const unsigned long nodemask = 1UL << node;
+    return ::syscall(SYS_mbind, data, size, MPOL_BIND_MODE, &nodemask, 64UL, 0U) == 0;
+#else
+    (void)data;
+    (void)size;
+    (void)node;
+    return false;
+#endif
+}
+
+} // anonymous namespace
+
+MappedRegion MappedRegion::map(size_t bytes, const PageOptions& options) {
+    MappedRegion region;
+    const int prot = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    
+    if (options.pages == PageMode::HUGETLB) {
+        const size_t size = round_up(bytes, HUGE_PAGE);
+        void* data = ::mmap(nullptr, size, prot, flags | MAP_HUGETLB, -1, 0);
+        if (data != MAP_FAILED) {
+            region.data_ = data;
+            region.size_ = size;
+            region.pages_ = PageMode::HUGETLB;
+        }
+    }
+    
+    if (region.data_ == nullptr) {
+        const bool huge = options.pages != PageMode::SMALL;
+        const size_t size = round_up(bytes, huge ? HUGE_PAGE : SMALL_PAGE);
+        void* data = ::mmap(nullptr, size, prot, flags, -1, 0);
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("Cannot map " + std::to_string(size) + " bytes: " + std::strerror(errno));
+        }
+        region.data_ = data;
+        region.size_ = size;
+        // Best effort: THP may be disabled, the mapping still works with small pages
+        if (huge && ::madvise(data, size, MADV_HUGEPAGE) == 0) {
+            region.pages_ = PageMode::TRANSPARENT;
+        }
+    }
+    
+    // Bind before the first touch so the pages are allocated on the node
+    if (options.numa_node >= 0) {
+        region.numa_bound_ = bind_to_node(region.data_, region.size_, options.numa_node);
+    }
+    
+    if (options.prefault) {
+        // THP may still hand out small pages, so only hugetlb can skip ahead
+        const size_t stride = region.pages_ == PageMode::HUGETLB ? HUGE_PAGE : SMALL_PAGE;
+        volatile char* memory = static_cast<char*>(region.data_);
+        for (size_t offset = 0; offset < region.size_; offset += stride) {
+            memory[offset] = 0;
+        }
+    }
+    return region;
+}
+
+MappedRegion::MappedRegion(MappedRegion&& other) noexcept
+    : data_(other.data_), size_(other.size_), pages_(other.pages_), numa_bound_(other.numa_bound_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedRegion& MappedRegion::operator=(MappedRegion&& other) noexcept {
+    if (this != &other) {
+        if (data_ != nullptr) {
+            ::munmap(data_, size_);
+        }
+        data_ = other.data_;
+        size_ = other.size_;
+        pages_ = other.pages_;
+        numa_bound_ = other.numa_bound_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+MappedRegion::~MappedRegion() {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+    }
+}
+
+int current_numa_node() noexcept {
+#ifdef SYS_getcpu
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+        return static_cast<int>(node);
+    }
+#endif
+    return 0;
+}
+
+const char* page_mode_name(PageMode mode) noexcept {
+    switch (mode) {
+        case PageMode::TRANSPARENT: return "thp";
+        case PageMode::HUGETLB: return "hugetlb";
+        default: return "4k";
+    }
+}
+
+} // namespace core
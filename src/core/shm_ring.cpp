@@ -0,0 +1,97 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "shm_ring.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace core {
+
+namespace {
+
+std::runtime_error shm_error(const std::string& what, const std::string& name) {
+    return std::runtime_error(what + " " + name + ": " + std::strerror(errno));
+}
+
+} // anonymous namespace
+
+ShmSegment ShmSegment::create(const std::string& name, size_t size) {
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        throw shm_error("Cannot create shared memory", name);
+    }
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        throw shm_error("Cannot size shared memory", name);
+    }
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw shm_error("Cannot map shared memory", name);
+    }
+    return ShmSegment(data, size);
+}
+
+ShmSegment ShmSegment::open(const std::string& name, bool writable) {
+    const int fd = ::shm_open(name.c_str(), writable ? O_RDWR : O_RDONLY, 0);
+    if (fd < 0) {
+        throw shm_error("Cannot open shared memory", name);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        throw shm_error("Cannot stat shared memory", name);
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* data = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw shm_error("Cannot map shared memory", name);
+    }
+    return ShmSegment(data, size);
+}
+
+bool ShmSegment::unlink(const std::string& name) noexcept {
+    return ::shm_unlink(name.c_str()) == 0;
+}
+
+ShmSegment::ShmSegment(ShmSegment&& other) noexcept
+    : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+ShmSegment& ShmSegment::operator=(ShmSegment&& other) noexcept {
+    if (this != &other) {
+        if (data_ != nullptr) {
+            ::munmap(data_, size_);
+        }
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+ShmSegment::~ShmSegment() {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+    }
+}
+
+bool shm_process_alive(int32_t pid) noexcept {
+    return pid > 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+}
+
+int32_t shm_current_pid() noexcept {
+    return static_cast<int32_t>(::getpid());
+}
+
+} // namespace core
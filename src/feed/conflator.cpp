@@ -0,0 +1,211 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "conflator.hpp"
+
+namespace feed {
+
+namespace {
+
+void set_timestamp(Event& event, uint64_t ts_us) noexcept {
+    switch (event.type) {
+        case EventType::ADD_ORDER: event.payload.add.ts_us = ts_us; break;
+        case EventType::MODIFY_ORDER: event.payload.modify.ts_us = ts_us; break;
+        case EventType::EXECUTE_ORDER: event.payload.execute.ts_us = ts_us; break;
+        case EventType::DELETE_ORDER: event.payload.delete_order.ts_us = ts_us; break;
+        default: break;
+    }
+}
+
+Event make_delete(const Event& from, uint64_t order_id) noexcept {
+    Event event;
+    event.type = EventType::DELETE_ORDER;
+    event.payload.delete_order = DeleteOrderMsg{};
+    event.payload.delete_order.ts_us = event_timestamp(from);
+    event.payload.delete_order.order_id = order_id;
+    event.decode_timestamp_us = from.decode_timestamp_us;
+    return event;
+}
+
+} // anonymous namespace
+
+uint64_t event_timestamp(const Event& event) noexcept {
+    switch (event.type) {
+        case EventType::ADD_ORDER: return event.payload.add.ts_us;
+        case EventType::MODIFY_ORDER: return event.payload.modify.ts_us;
+        case EventType::EXECUTE_ORDER: return event.payload.execute.ts_us;
+        case EventType::DELETE_ORDER: return event.payload.delete_order.ts_us;
+        default: return 0;
+    }
+}
+
+uint64_t event_order_id(const Event& event) noexcept {
+    switch (event.type) {
+        case EventType::ADD_ORDER: return event.payload.add.order_id;
+        case EventType::MODIFY_ORDER: return event.payload.modify.order_id;
+        case EventType::EXECUTE_ORDER: return event.payload.execute.order_id;
+        case EventType::DELETE_ORDER: return event.payload.delete_order.order_id;
+        default: return 0;
+    }
+}
+
+void EventConflator::add(const Event& event) {
+    events_in_++;
+    const uint64_t index = ++event_index_;
+    const uint64_t order_id = event_order_id(event);
+    
+    auto it = open_.find(order_id);
+    Pending* pending = it != open_.end() ? it->second : nullptr;
+    if (pending == nullptr) {
+        pending = &open(order_id, UNKNOWN_SIDE);
+    } else if (touched_since_open(*pending)) {
+        // Another order's event may have depended on this order's current
+        // state: leave the entry as it is and start a new one behind it
+        pending = &open(order_id, pending->side);
+    }
+    if (event.type == EventType::ADD_ORDER) {
+        pending->side = event.payload.add.side == 'B' ? 0 : 1;
+    }
+    
+    merge(*pending, event);
+    update_live(*pending);
+    
+    pending->last = index;
+    if (pending->side == UNKNOWN_SIDE) {
+        last_touch_[0] = last_touch_[1] = index;
+    } else {
+        last_touch_[pending->side] = index;
+    }
+    if (live_ == 0) {
+        // Everything cancelled out
+        queue_.clear();
+        open_.clear();
+    }
+}
+
+size_t EventConflator::drain(std::span<Event> out) {
+    size_t written = 0;
+    while (written < out.size() && !queue_.empty()) {
+        // Emit delete, add, change in turn; a partly drained entry stays at the front
+        Pending& pending = queue_.front();
+        if (pending.remove.type != EventType::INVALID) {
+            out[written++] = pending.remove;
+            pending.remove.type = EventType::INVALID;
+        } else if (pending.add.type != EventType::INVALID) {
+            out[written++] = pending.add;
+            pending.add.type = EventType::INVALID;
+        } else {
+            if (pending.change.type != EventType::INVALID) {
+                out[written++] = pending.change;
+                pending.change.type = EventType::INVALID;
+            }
+            update_live(pending);
+            auto it = open_.find(pending.order_id);
+            if (it != open_.end() && it->second == &pending) {
+                open_.erase(it);
+            }
+            queue_.pop_front();
+        }
+    }
+    events_out_ += written;
+    return written;
+}
+
+EventConflator::Pending& EventConflator::open(uint64_t order_id, int side) {
+    Pending& pending = queue_.emplace_back();
+    pending.order_id = order_id;
+    pending.opened = event_index_;
+    pending.side = side;
+    open_[order_id] = &pending;
+    return pending;
+}
+
+bool EventConflator::touched_since_open(const Pending& pending) const noexcept {
+    if (pending.side != UNKNOWN_SIDE) {
+        // Only this order's own side is marked by its own events
+        return last_touch_[1 - pending.side] > pending.opened;
+    }
+    // Both sides carry this order's own marks; any other later mark is foreign
+    for (const uint64_t touched : last_touch_) {
+        if (touched > pending.opened && touched != pending.last) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void EventConflator::merge(Pending& pending, const Event& event) {
+    Event& change = pending.change;
+    
+    switch (event.type) {
+        case EventType::ADD_ORDER:
+            // Only valid for an id that is not (or no longer) in the book
+            if (pending.add.type == EventType::INVALID && change.type == EventType::INVALID) {
+                pending.add = event;
+            }
+            break;
+        
+        case EventType::MODIFY_ORDER:
+        case EventType::EXECUTE_ORDER: {
+            if (pending.remove.type != EventType::INVALID && pending.add.type == EventType::INVALID) {
+                break;  // Change to a deleted order is rejected by the book
+            }
+            if (change.type == EventType::INVALID || event.type == EventType::MODIFY_ORDER) {
+                // Absolute price and size replace any earlier change
+                const uint64_t decoded = change.type == EventType::INVALID ? event.decode_timestamp_us
+                                                                          : change.decode_timestamp_us;
+                change = event;
+                change.decode_timestamp_us = decoded;
+                break;
+            }
+            
+            const uint32_t exec_qty = event.payload.execute.exec_qty;
+            if (change.type == EventType::EXECUTE_ORDER) {
+                change.payload.execute.exec_qty += exec_qty;
+            } else if (exec_qty < change.payload.modify.new_qty) {
+                change.payload.modify.new_qty -= exec_qty;
+            } else if (exec_qty == change.payload.modify.new_qty) {
+                on_delete(pending, make_delete(event, pending.order_id));  // Fully executed after the modify
+                break;
+            } else {
+                break;  // Over-execution is rejected by the book
+            }
+            set_timestamp(change, event_timestamp(event));
+            break;
+        }
+        
+        case EventType::DELETE_ORDER:
+            on_delete(pending, event);
+            break;
+        
+        default:
+            break;
+    }
+}
+
+void EventConflator::on_delete(Pending& pending, const Event& remove) {
+    if (pending.remove.type == EventType::INVALID && pending.add.type != EventType::INVALID) {
+        // Added and removed within one entry: nothing to send
+        pending.add.type = EventType::INVALID;
+        pending.change.type = EventType::INVALID;
+        return;
+    }
+    if (pending.remove.type == EventType::INVALID) {
+        pending.remove = remove;
+    }
+    pending.add.type = EventType::INVALID;
+    pending.change.type = EventType::INVALID;
+}
+
+void EventConflator::update_live(Pending& pending) noexcept {
+    const bool live = pending.remove.type != EventType::INVALID || pending.add.type != EventType::INVALID ||
+                      pending.change.type != EventType::INVALID;
+    if (live != pending.live) {
+        live ? live_++ : live_--;
+        pending.live = live;
+    }
+}
+
+} // namespace feed
@@ -92,55 +92,117 @@ bool Decoder::has_next() const noexcept {
 }
 
 Event Decoder::next() {
-    if (!has_next()) {
-        return Event(); // Invalid event
+    Event event;
+    next_into(event);
+    return event;
+}
+
+bool Decoder::next_into(Event& event) {
+    const char* data = static_cast<const char*>(mapped_data_);
+    
+    while (has_next()) {
+        event.decode_timestamp_us = core::Clock::now_us();
+        
+        switch (data[current_pos_]) {
+            case 'A':
+                if (read_message<AddOrderMsg>(event)) {
+                    event.type = EventType::ADD_ORDER;
+                    return true;
+                }
+                break;
+            case 'U':
+                if (read_message<ModifyOrderMsg>(event)) {
+                    event.type = EventType::MODIFY_ORDER;
+                    return true;
+                }
+                break;
+            case 'E':
+                if (read_message<ExecuteOrderMsg>(event)) {
+                    event.type = EventType::EXECUTE_ORDER;
+                    return true;
+                }
+                break;
+            case 'D':
+                if (read_message<DeleteOrderMsg>(event)) {
+                    event.type = EventType::DELETE_ORDER;
+                    return true;
+                }
+                break;
+            default:
+                // Skip unknown message type
+                current_pos_++;
+                continue;
+        }
+        break;
     }
     
-    const char* data = static_cast<const char*>(mapped_data_);
-    if (current_pos_ >= file_size_) {
-        return Event(); // Invalid event
+    event.type = EventType::INVALID;
+    return false;
+}
+
+void Decoder::reset() noexcept {
+    current_pos_ = 0;
+}
+
+void Decoder::seek(size_t offset) {
+    if (offset > file_size_) {
+        throw std::out_of_range("Seek offset beyond end of file");
     }
+    current_pos_ = offset;
+}
+
+std::span<const char> Decoder::next_raw() noexcept {
+    const char* data = static_cast<const char*>(mapped_data_);
     
-    char msg_type = data[current_pos_];
-    Event event;
-    event.decode_timestamp_us = core::Clock::now_us();
+    while (has_next()) {
+        const size_t length = message_size(data[current_pos_]);
+        if (length == 0) {
+            // Skip unknown message type
+            current_pos_++;
+            continue;
+        }
+        if (current_pos_ + length > file_size_) {
+            current_pos_ = file_size_;  // Truncated final message
+            break;
+        }
+        std::span<const char> raw(data + current_pos_, length);
+        current_pos_ += length;
+        return raw;
+    }
+    return {};
+}
+
+bool Decoder::decode(std::span<const char> raw, Event& event) noexcept {
+    if (raw.empty() || raw.size() != message_size(raw[0])) {
+        return false;
+    }
     
-    switch (msg_type) {
+    switch (raw[0]) {
         case 'A':
-            if (read_message<AddOrderMsg>(event)) {
-                event.type = EventType::ADD_ORDER;
-                return event;
-            }
-            break;
+            event.type = EventType::ADD_ORDER;
+            return decode_message<AddOrderMsg>(raw.data(), event);
         case 'U':
-            if (read_message<ModifyOrderMsg>(event)) {
-                event.type = EventType::MODIFY_ORDER;
-                return event;
-            }
-            break;
+            event.type = EventType::MODIFY_ORDER;
+            return decode_message<ModifyOrderMsg>(raw.data(), event);
         case 'E':
-            if (read_message<ExecuteOrderMsg>(event)) {
-                event.type = EventType::EXECUTE_ORDER;
-                return event;
-            }
-            break;
+            event.type = EventType::EXECUTE_ORDER;
+            return decode_message<ExecuteOrderMsg>(raw.data(), event);
         case 'D':
-            if (read_message<DeleteOrderMsg>(event)) {
-                event.type = EventType::DELETE_ORDER;
-                return event;
-            }
-            break;
+            event.type = EventType::DELETE_ORDER;
+            return decode_message<DeleteOrderMsg>(raw.data(), event);
         default:
-            // Skip unknown message type
-            current_pos_++;
-            return next();
+            return false;
     }
-    
-    return Event(); // Invalid event
 }
 
-void Decoder::reset() noexcept {
-    current_pos_ = 0;
+size_t Decoder::message_size(char type) noexcept {
+    switch (type) {
+        case 'A': return sizeof(AddOrderMsg);
+        case 'U': return sizeof(ModifyOrderMsg);
+        case 'E': return sizeof(ExecuteOrderMsg);
+        case 'D': return sizeof(DeleteOrderMsg);
+        default: return 0;
+    }
 }
 
 template<typename T>
@@ -150,7 +212,17 @@ bool Decoder::read_message(Event& event) {
     }
     
     const char* data = static_cast<const char*>(mapped_data_);
-    const T* msg = reinterpret_cast<const T*>(data + current_pos_);
+    if (!decode_message<T>(data + current_pos_, event)) {
+        return false;
+    }
+    
+    current_pos_ += sizeof(T);
+    return true;
+}
+
+template<typename T>
+bool Decoder::decode_message(const char* data, Event& event) noexcept {
+    const T* msg = reinterpret_cast<const T*>(data);
     
     // Validate message
     if constexpr (std::is_same_v<T, AddOrderMsg>) {
@@ -174,8 +246,6 @@ bool Decoder::read_message(Event& event) {
     } else if constexpr (std::is_same_v<T, DeleteOrderMsg>) {
         event.payload.delete_order = *msg;
     }
-    
-    current_pos_ += sizeof(T);
     return true;
 }
 
@@ -0,0 +1,776 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "feed_generator.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <queue>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace feed {
+
+namespace {
+
+/**
+ * @brief SplitMix64; expands one seed into well-mixed generator state
+ */
+class SplitMix64 {
+public:
+    explicit SplitMix64(uint64_t seed) : state_(seed) {}
+    
+    uint64_t next() {
+        uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t state_;
+};
+
+/**
+ * @brief xoshiro256++ generator with its own uniform helpers
+ *
+ * std::uniform_*_distribution output differs between standard libraries, so
+ * the generator maps raw bits itself: the same seed gives the same file on
+ * any platform.
+ */
+class Rng {
+public:
+    explicit Rng(uint64_t seed) {
+        SplitMix64 mix(seed);
+        for (uint64_t& word : s_) {
+            word = mix.next();
+        }
+    }
+    
+    uint64_t next() {
+        const uint64_t result = rotl(s_[0] + s_[3], 23) + s_[0];
+        const uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+    
+    /**
+     * @brief Uniform double in [0, 1)
+     */
+    double uniform() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+    
+    /**
+     * @brief Uniform integer in [0, n) by multiply-shift (n > 0)
+     */
+    uint64_t below(uint64_t n) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(next()) * n) >> 64);
+    }
+    
+    /**
+     * @brief Failures before the first success with probability p, capped
+     */
+    uint64_t geometric(double p, uint64_t cap) {
+        const double draws = std::floor(std::log1p(-uniform()) / std::log1p(-p));
+        return std::min(static_cast<uint64_t>(draws), cap);
+    }
+    
+    /**
+     * @brief Exponential draw with the given mean
+     */
+    double exponential(double mean) {
+        return -std::log1p(-uniform()) * mean;
+    }
+
+private:
+    uint64_t s_[4];
+    
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+size_t message_size(char type) {
+    switch (type) {
+        case 'A': return sizeof(AddOrderMsg);
+        case 'U': return sizeof(ModifyOrderMsg);
+        case 'E': return sizeof(ExecuteOrderMsg);
+        default: return sizeof(DeleteOrderMsg);
+    }
+}
+
+// Every message type is packed with ts_us right after the type byte
+uint64_t message_timestamp(const char* message) {
+    uint64_t ts_us;
+    std::memcpy(&ts_us, message + offsetof(AddOrderMsg, ts_us), sizeof(ts_us));
+    return ts_us;
+}
+
+} // anonymous namespace
+
+bool parse_sim_profile(const std::string& name, SimProfile& profile) {
+    if (name == "uniform") {
+        profile = SimProfile::UNIFORM;
+    } else if (name == "realistic") {
+        profile = SimProfile::REALISTIC;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+FeedWriter::FeedWriter(const std::string& path, size_t buffer_bytes) : buffer_(buffer_bytes) {
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot create output file " + path + ": " + std::strerror(errno));
+    }
+}
+
+FeedWriter::~FeedWriter() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void FeedWriter::append(const char* data, size_t size) {
+    if (buffer_.size() - used_ < size) {
+        flush();
+    }
+    std::memcpy(buffer_.data() + used_, data, size);
+    used_ += size;
+}
+
+void FeedWriter::close() {
+    flush();
+    const int fd = fd_;
+    fd_ = -1;
+    if (::close(fd) != 0) {
+        throw std::runtime_error(std::string("Cannot close output file: ") + std::strerror(errno));
+    }
+}
+
+void FeedWriter::flush() {
+    const char* data = buffer_.data();
+    size_t remaining = used_;
+    while (remaining > 0) {
+        const ssize_t n = ::write(fd_, data, remaining);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("Cannot write output file: ") + std::strerror(errno));
+        }
+        data += n;
+        remaining -= static_cast<size_t>(n);
+    }
+    written_ += used_;
+    used_ = 0;
+}
+
+/**
+ * @brief Message stream of one symbol, with its own RNG
+ *
+ * A stream's messages depend only on the seed, its symbol index and the
+ * symbol count, never on how the stream is cut into windows or which thread
+ * runs it.
+ */
+class SymbolStream {
+public:
+    SymbolStream(const std::string& symbol, size_t index, size_t symbol_count, uint64_t seed)
+        : rng_(stream_seed(seed, index)), index_(index), symbol_count_(symbol_count) {
+        // Space-padded feed symbol, copied into every add message
+        std::memset(name_, ' ', sizeof(name_));
+        std::memcpy(name_, symbol.data(), std::min(symbol.size(), sizeof(name_)));
+    }
+    
+    virtual ~SymbolStream() = default;
+    
+    /**
+     * @brief Append this symbol's messages stamped before end_us
+     * @param end_us Window end (exclusive)
+     * @param output Receives packed messages in time order
+     */
+    virtual void generate_until(uint64_t end_us, std::vector<char>& output) = 0;
+
+protected:
+    Rng rng_;
+    const size_t index_;
+    const size_t symbol_count_;
+    char name_[6];
+    
+    uint64_t next_order_id() {
+        return next_sequence_++ * symbol_count_ + index_ + 1;
+    }
+    
+    template<typename Msg>
+    static void put(std::vector<char>& output, const Msg& msg) {
+        const char* bytes = reinterpret_cast<const char*>(&msg);
+        output.insert(output.end(), bytes, bytes + sizeof(msg));
+    }
+
+private:
+    uint64_t next_sequence_ = 0;
+    
+    static uint64_t stream_seed(uint64_t seed, size_t index) {
+        SplitMix64 mix(seed ^ (0x9e3779b97f4a7c15ULL * (index + 1)));
+        return mix.next();
+    }
+};
+
+namespace {
+
+/**
+ * @brief Every symbol equally active; prices uniform within ±5% of $100
+ *
+ * Gaps between a symbol's messages are 0 to 10 * symbol_count - 1 µs, which
+ * keeps the merged feed at the same average rate whatever the number of
+ * symbols.
+ */
+class UniformStream : public SymbolStream {
+public:
+    UniformStream(const std::string& symbol, size_t index, size_t symbol_count, uint64_t seed, uint64_t start_us)
+        : SymbolStream(symbol, index, symbol_count, seed), max_gap_us_(10 * symbol_count) {
+        next_time_us_ = start_us + rng_.below(max_gap_us_);
+    }
+    
+    void generate_until(uint64_t end_us, std::vector<char>& output) override {
+        while (next_time_us_ < end_us) {
+            const uint64_t current_time_us = next_time_us_;
+            
+            // Decide message type based on current state
+            double msg_type_rand = rng_.uniform();
+            
+            if (orders_.empty() || msg_type_rand < 0.4) {
+                // 40% chance to add order (or forced if no active orders)
+                generate_add_order(output, current_time_us);
+            } else if (msg_type_rand < 0.6) {
+                // 20% chance to modify order
+                generate_modify_order(output, current_time_us);
+            } else if (msg_type_rand < 0.8) {
+                // 20% chance to execute order
+                generate_execute_order(output, current_time_us);
+            } else {
+                // 20% chance to delete order
+                generate_delete_order(output, current_time_us);
+            }
+            next_time_us_ += rng_.below(max_gap_us_);
+        }
+    }
+
+private:
+    struct OrderInfo {
+        uint64_t order_id;
+        char side;
+        int64_t price;
+        uint32_t quantity;
+    };
+    
+    static constexpr int64_t BASE_PRICE = 100'000'000'000LL; // $100.00
+    
+    const uint64_t max_gap_us_;
+    uint64_t next_time_us_;
+    std::vector<OrderInfo> orders_;  // Live orders, unordered
+    
+    // O(1) removal: the last order takes the removed one's slot
+    void remove_order(size_t index) {
+        orders_[index] = orders_.back();
+        orders_.pop_back();
+    }
+    
+    void generate_add_order(std::vector<char>& output, uint64_t timestamp_us) {
+        AddOrderMsg msg;
+        msg.type = 'A';
+        msg.ts_us = timestamp_us;
+        msg.order_id = next_order_id();
+        std::memcpy(msg.symbol, name_, sizeof(msg.symbol));
+        
+        // Random side
+        msg.side = (rng_.uniform() < 0.5) ? 'B' : 'S';
+        
+        // Price within ±5% of base price
+        double price_factor = 0.95 + rng_.uniform() * 0.1; // 0.95 to 1.05
+        msg.px_nano = static_cast<int64_t>(BASE_PRICE * price_factor);
+        
+        // Random quantity (100 to 10000)
+        msg.qty = 100 + static_cast<uint32_t>(rng_.uniform() * 9900);
+        
+        put(output, msg);
+        
+        // Track active order
+        orders_.push_back({msg.order_id, msg.side, msg.px_nano, msg.qty});
+    }
+    
+    void generate_modify_order(std::vector<char>& output, uint64_t timestamp_us) {
+        if (orders_.empty()) return;
+        
+        // Pick random order
+        OrderInfo& order = orders_[rng_.below(orders_.size())];
+        
+        ModifyOrderMsg msg;
+        msg.type = 'U';
+        msg.ts_us = timestamp_us;
+        msg.order_id = order.order_id;
+        
+        // Modify price slightly (±1%)
+        double price_factor = 0.99 + rng_.uniform() * 0.02;
+        msg.new_px_nano = static_cast<int64_t>(order.price * price_factor);
+        
+        // Modify quantity slightly
+        double qty_factor = 0.5 + rng_.uniform() * 1.0; // 0.5 to 1.5
+        msg.new_qty = std::max(1U, static_cast<uint32_t>(order.quantity * qty_factor));
+        
+        put(output, msg);
+        
+        // Update tracked order
+        order.price = msg.new_px_nano;
+        order.quantity = msg.new_qty;
+    }
+    
+    void generate_execute_order(std::vector<char>& output, uint64_t timestamp_us) {
+        if (orders_.empty()) return;
+        
+        // Pick random order
+        size_t index = rng_.below(orders_.size());
+        OrderInfo& order = orders_[index];
+        
+        ExecuteOrderMsg msg;
+        msg.type = 'E';
+        msg.ts_us = timestamp_us;
+        msg.order_id = order.order_id;
+        
+        // Execute 10% to 100% of remaining quantity
+        uint32_t max_exec = order.quantity;
+        msg.exec_qty = std::max(1U, static_cast<uint32_t>(max_exec * (0.1 + rng_.uniform() * 0.9)));
+        msg.exec_qty = std::min(msg.exec_qty, max_exec);
+        
+        put(output, msg);
+        
+        // Update tracked order
+        order.quantity -= msg.exec_qty;
+        if (order.quantity == 0) {
+            remove_order(index);
+        }
+    }
+    
+    void generate_delete_order(std::vector<char>& output, uint64_t timestamp_us) {
+        if (orders_.empty()) return;
+        
+        // Pick random order
+        size_t index = rng_.below(orders_.size());
+        
+        DeleteOrderMsg msg;
+        msg.type = 'D';
+        msg.ts_us = timestamp_us;
+        msg.order_id = orders_[index].order_id;
+        
+        put(output, msg);
+        
+        // Remove tracked order
+        remove_order(index);
+    }
+};
+
+/**
+ * @brief Production-shaped stream: a book on a one-cent tick grid
+ *
+ * - Activity is Zipf: symbol i gets a share proportional to 1 / (i + 1) of
+ *   the messages, with exponential gaps between them.
+ * - The rate follows the session: up to 1 + BURST_PEAK times the base
+ *   rate right after the open and before the close, decaying over
+ *   BURST_TAU_US.
+ * - A fair value walks one tick at a time and stays between the touches.
+ *   Adds are placed a geometric number of ticks behind it, so depth
+ *   clusters near the touch and queues get long.
+ * - Executions take the oldest order at the touch; emptying the touch moves
+ *   the fair value through it.
+ * - The live order count reverts to TARGET_ORDERS, and now and then a
+ *   cancel storm pulls orders from anywhere on one side.
+ *
+ * The generator tracks the book it writes, so no add or modify ever crosses
+ * it and every execute, modify and delete names a live order. Uses std::log
+ * and std::exp, so files are byte-stable per platform rather than across
+ * math libraries.
+ */
+class RealisticStream : public SymbolStream {
+public:
+    static constexpr int64_t TICK_NANO = 10'000'000;           // $0.01
+    static constexpr size_t TARGET_ORDERS = 2000;
+    static constexpr double BASE_GAP_US = 4.5;                 // Whole feed, mid-session
+    static constexpr double BURST_PEAK = 4.0;
+    static constexpr double BURST_TAU_US = 15 * 60e6;
+    static constexpr uint64_t OPEN_US = 34200000000ULL;        // 09:30
+    static constexpr uint64_t CLOSE_US = 57600000000ULL;       // 16:00
+    static constexpr double OFF_HOURS_INTENSITY = 0.2;
+    static constexpr double STORM_PROBABILITY = 0.0005;
+    
+    RealisticStream(const std::string& symbol, size_t index, size_t symbol_count, uint64_t seed,
+                    uint64_t start_us)
+        : SymbolStream(symbol, index, symbol_count, seed) {
+        // Share of symbol i is (1 / (i + 1)) / H(symbol_count)
+        double harmonic = 0.0;
+        for (size_t i = 1; i <= symbol_count; ++i) {
+            harmonic += 1.0 / static_cast<double>(i);
+        }
+        mean_gap_us_ = BASE_GAP_US * harmonic * static_cast<double>(index + 1);
+        
+        // $10 to $500, on the tick grid
+        fair_ticks_ = 1000 + static_cast<int64_t>(rng_.below(49000));
+        clock_us_ = static_cast<double>(start_us);
+        advance_clock();
+    }
+    
+    void generate_until(uint64_t end_us, std::vector<char>& output) override {
+        while (next_time_us_ < end_us) {
+            const uint64_t timestamp_us = next_time_us_;
+            
+            if (rng_.uniform() < 0.01) {
+                walk_fair_value(rng_.uniform() < 0.5 ? -1 : 1);
+            }
+            
+            if (storm_remaining_ == 0 && live_ > 0 && rng_.uniform() < STORM_PROBABILITY) {
+                storm_remaining_ = 20 + rng_.below(200);
+                storm_side_ = rng_.below(2);
+            }
+            
+            if (storm_remaining_ > 0 && !levels_[storm_side_].empty()) {
+                storm_remaining_--;
+                generate_delete(output, timestamp_us, storm_side_, levels_[storm_side_].size());
+            } else {
+                storm_remaining_ = 0;
+                const double p_add = live_ < TARGET_ORDERS ? 0.5 : 0.3;
+                const double choice = rng_.uniform();
+                if (live_ == 0 || choice < p_add) {
+                    generate_add(output, timestamp_us);
+                } else if (choice < p_add + 0.08) {
+                    generate_execute(output, timestamp_us);
+                } else if (choice < p_add + 0.2) {
+                    generate_modify(output, timestamp_us);
+                } else {
+                    generate_delete(output, timestamp_us, rng_.below(2), 0);
+                }
+            }
+            advance_clock();
+        }
+    }
+
+private:
+    struct Order {
+        uint64_t order_id;
+        uint32_t quantity;
+    };
+    
+    // Levels keyed by distance-ordered price: -ticks for bids, ticks for
+    // asks, so begin() is the touch on both sides
+    using Levels = std::map<int64_t, std::vector<Order>>;
+    
+    Levels levels_[2];          // 0 = bids, 1 = asks
+    size_t live_ = 0;
+    int64_t fair_ticks_;
+    double mean_gap_us_;
+    double clock_us_;
+    uint64_t next_time_us_ = 0;
+    uint64_t storm_remaining_ = 0;
+    size_t storm_side_ = 0;
+    
+    static int64_t key(size_t side, int64_t ticks) { return side == 0 ? -ticks : ticks; }
+    static int64_t ticks_of(size_t side, int64_t key) { return side == 0 ? -key : key; }
+    static char side_char(size_t side) { return side == 0 ? 'B' : 'S'; }
+    
+    double intensity(double ts_us) const {
+        if (ts_us < OPEN_US || ts_us >= CLOSE_US) {
+            return OFF_HOURS_INTENSITY;
+        }
+        return 1.0 + BURST_PEAK * std::exp(-(ts_us - OPEN_US) / BURST_TAU_US)
+                   + BURST_PEAK * std::exp(-(CLOSE_US - ts_us) / BURST_TAU_US);
+    }
+    
+    void advance_clock() {
+        clock_us_ += rng_.exponential(mean_gap_us_ / intensity(clock_us_));
+        next_time_us_ = static_cast<uint64_t>(clock_us_);
+    }
+    
+    bool touch(size_t side, int64_t& ticks) const {
+        if (levels_[side].empty()) {
+            return false;
+        }
+        ticks = ticks_of(side, levels_[side].begin()->first);
+        return true;
+    }
+    
+    // Keep the fair value between the touches
+    void walk_fair_value(int64_t step) {
+        fair_ticks_ = std::max<int64_t>(fair_ticks_ + step, 2);
+        int64_t bid, ask;
+        if (touch(0, bid)) {
+            fair_ticks_ = std::max(fair_ticks_, bid);
+        }
+        if (touch(1, ask)) {
+            fair_ticks_ = std::min(fair_ticks_, ask);
+        }
+    }
+    
+    // Clamp a price to the side's passive range; false if none is left
+    bool passive_price(size_t side, int64_t& ticks) const {
+        int64_t opposite;
+        if (side == 0) {
+            if (touch(1, opposite)) {
+                ticks = std::min(ticks, opposite - 1);
+            }
+            return ticks >= 1;
+        }
+        if (touch(0, opposite)) {
+            ticks = std::max(ticks, opposite + 1);
+        }
+        return true;
+    }
+    
+    uint32_t draw_quantity() {
+        if (rng_.uniform() < 0.1) {
+            return 1 + static_cast<uint32_t>(rng_.below(99));  // Odd lot
+        }
+        return 100 * (1 + static_cast<uint32_t>(rng_.geometric(0.35, 49)));
+    }
+    
+    // Level depth_limit levels from the touch at most (0 = geometric pick)
+    Levels::iterator pick_level(size_t side, size_t depth_limit) {
+        Levels& levels = levels_[side];
+        const size_t depth = depth_limit > 0 ? rng_.below(depth_limit)
+                                             : rng_.geometric(0.15, levels.size() - 1);
+        auto level = levels.begin();
+        std::advance(level, std::min(depth, levels.size() - 1));
+        return level;
+    }
+    
+    void remove_from_level(size_t side, Levels::iterator level, size_t position) {
+        std::vector<Order>& queue = level->second;
+        queue.erase(queue.begin() + static_cast<ptrdiff_t>(position));
+        if (queue.empty()) {
+            levels_[side].erase(level);
+        }
+        live_--;
+    }
+    
+    void generate_add(std::vector<char>& output, uint64_t timestamp_us) {
+        const size_t side = rng_.below(2);
+        const int64_t distance = 1 + static_cast<int64_t>(rng_.geometric(0.15, 200));
+        int64_t ticks = side == 0 ? fair_ticks_ - distance : fair_ticks_ + distance;
+        if (!passive_price(side, ticks)) {
+            return;
+        }
+        
+        AddOrderMsg msg;
+        msg.type = 'A';
+        msg.ts_us = timestamp_us;
+        msg.order_id = next_order_id();
+        std::memcpy(msg.symbol, name_, sizeof(msg.symbol));
+        msg.side = side_char(side);
+        msg.px_nano = ticks * TICK_NANO;
+        msg.qty = draw_quantity();
+        put(output, msg);
+        
+        levels_[side][key(side, ticks)].push_back({msg.order_id, msg.qty});
+        live_++;
+    }
+    
+    void generate_execute(std::vector<char>& output, uint64_t timestamp_us) {
+        size_t side = rng_.below(2);
+        if (levels_[side].empty()) {
+            side ^= 1;
+        }
+        auto level = levels_[side].begin();
+        Order& order = level->second.front();
+        
+        ExecuteOrderMsg msg;
+        msg.type = 'E';
+        msg.ts_us = timestamp_us;
+        msg.order_id = order.order_id;
+        msg.exec_qty = std::min(order.quantity, 100 * (1 + static_cast<uint32_t>(rng_.below(5))));
+        put(output, msg);
+        
+        order.quantity -= msg.exec_qty;
+        if (order.quantity == 0) {
+            const bool level_emptied = level->second.size() == 1;
+            remove_from_level(side, level, 0);
+            if (level_emptied) {
+                // Price impact: the touch was taken out
+                walk_fair_value(side == 0 ? -1 : 1);
+            }
+        }
+    }
+    
+    void generate_modify(std::vector<char>& output, uint64_t timestamp_us) {
+        size_t side = rng_.below(2);
+        if (levels_[side].empty()) {
+            side ^= 1;
+        }
+        auto level = pick_level(side, 0);
+        const size_t position = rng_.below(level->second.size());
+        Order order = level->second[position];
+        const int64_t old_ticks = ticks_of(side, level->first);
+        
+        int64_t new_ticks = old_ticks;
+        uint32_t new_quantity = order.quantity;
+        if (rng_.uniform() < 0.7) {
+            // Size down
+            new_quantity = std::max(1U, static_cast<uint32_t>(order.quantity * (0.3 + rng_.uniform() * 0.65)));
+        } else {
+            // Reprice by up to two ticks either way
+            new_ticks += static_cast<int64_t>(rng_.below(5)) - 2;
+            if (!passive_price(side, new_ticks)) {
+                return;
+            }
+        }
+        
+        ModifyOrderMsg msg;
+        msg.type = 'U';
+        msg.ts_us = timestamp_us;
+        msg.order_id = order.order_id;
+        msg.new_px_nano = new_ticks * TICK_NANO;
+        msg.new_qty = new_quantity;
+        put(output, msg);
+        
+        if (new_ticks == old_ticks) {
+            level->second[position].quantity = new_quantity;
+        } else {
+            remove_from_level(side, level, position);
+            levels_[side][key(side, new_ticks)].push_back({order.order_id, new_quantity});
+            live_++;
+        }
+    }
+    
+    void generate_delete(std::vector<char>& output, uint64_t timestamp_us, size_t side, size_t depth_limit) {
+        if (levels_[side].empty()) {
+            side ^= 1;
+        }
+        auto level = pick_level(side, depth_limit);
+        const size_t position = rng_.below(level->second.size());
+        
+        DeleteOrderMsg msg;
+        msg.type = 'D';
+        msg.ts_us = timestamp_us;
+        msg.order_id = level->second[position].order_id;
+        put(output, msg);
+        
+        remove_from_level(side, level, position);
+    }
+};
+
+} // anonymous namespace
+
+FeedGenerator::FeedGenerator(const SimConfig& config)
+    : threads_(std::clamp<size_t>(config.threads, 1, std::max<size_t>(config.symbols.size(), 1))),
+      offsets_(config.symbols.size()), filled_until_us_(config.start_us) {
+    if (config.symbols.empty()) {
+        throw std::invalid_argument("Feed generator needs at least one symbol");
+    }
+    const size_t count = config.symbols.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (config.profile == SimProfile::REALISTIC) {
+            streams_.push_back(std::make_unique<RealisticStream>(config.symbols[i], i, count, config.seed,
+                                                                 config.start_us));
+        } else {
+            streams_.push_back(std::make_unique<UniformStream>(config.symbols[i], i, count, config.seed,
+                                                               config.start_us));
+        }
+    }
+    for (Window& window : windows_) {
+        window.resize(count);
+    }
+}
+
+FeedGenerator::~FeedGenerator() = default;
+
+void FeedGenerator::generate(FeedWriter& output, uint64_t num_messages) {
+    uint64_t written = 0;
+    while (written < num_messages) {
+        if (!current_ready_) {
+            for (std::thread& worker : start_fill(windows_[current_])) {
+                worker.join();
+            }
+            current_ready_ = true;
+        }
+        
+        // Fill the next window while this one is merged
+        std::vector<std::thread> workers;
+        if (!next_ready_) {
+            workers = start_fill(windows_[current_ ^ 1]);
+        }
+        const bool window_done = merge(output, num_messages - written, written);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        next_ready_ = true;
+        
+        if (window_done) {
+            current_ ^= 1;
+            next_ready_ = false;
+            std::fill(offsets_.begin(), offsets_.end(), 0);
+        }
+    }
+}
+
+std::vector<std::thread> FeedGenerator::start_fill(Window& window) {
+    filled_until_us_ += WINDOW_US;
+    const uint64_t end_us = filled_until_us_;
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads_; ++t) {
+        workers.emplace_back([this, &window, end_us, t] {
+            for (size_t i = t; i < streams_.size(); i += threads_) {
+                window[i].clear();
+                streams_[i]->generate_until(end_us, window[i]);
+            }
+        });
+    }
+    return workers;
+}
+
+bool FeedGenerator::merge(FeedWriter& output, uint64_t limit, uint64_t& written) {
+    struct Cursor {
+        uint64_t ts_us;
+        size_t symbol;
+        bool operator>(const Cursor& other) const {
+            return ts_us != other.ts_us ? ts_us > other.ts_us : symbol > other.symbol;
+        }
+    };
+    
+    const Window& window = windows_[current_];
+    std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heap;
+    for (size_t i = 0; i < window.size(); ++i) {
+        if (offsets_[i] < window[i].size()) {
+            heap.push({message_timestamp(window[i].data() + offsets_[i]), i});
+        }
+    }
+    
+    uint64_t merged = 0;
+    while (!heap.empty() && merged < limit) {
+        Cursor cursor = heap.top();
+        heap.pop();
+        const std::vector<char>& messages = window[cursor.symbol];
+        size_t& offset = offsets_[cursor.symbol];
+        const size_t size = message_size(messages[offset]);
+        output.append(messages.data() + offset, size);
+        merged++;
+        offset += size;
+        if (offset < messages.size()) {
+            cursor.ts_us = message_timestamp(messages.data() + offset);
+            heap.push(cursor);
+        }
+    }
+    written += merged;
+    return heap.empty();
+}
+
+} // namespace feed
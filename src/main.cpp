@@ -4,13 +4,29 @@
  */
 
 #include "clock.hpp"
+#include "arena.hpp"
 #include "ring_buffer.hpp"
+#include "byte_ring.hpp"
 #include "decoder.hpp"
 #include "order_book.hpp"
 #include "publisher.hpp"
+#include "shm_publisher.hpp"
+#include "binary_publisher.hpp"
+#include "async_publisher.hpp"
+#include "udp_publisher.hpp"
+#include "tob_sink.hpp"
+#include "columnar.hpp"
 #include "messages.hpp"
+#include "snapshot.hpp"
+#include "conflator.hpp"
+#include "tob_table.hpp"
+#include "depth_snapshot.hpp"
+#include "trades.hpp"
+#include "trade_publisher.hpp"
+#include "analytics_publisher.hpp"
 
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -21,6 +37,12 @@
 #include <csignal>
 #include <atomic>
 #include <sstream>
+#include <span>
+#include <optional>
+#include <variant>
+#include <stdexcept>
+#include <cstddef>
+#include <cstring>
 
 namespace {
 
@@ -28,6 +50,35 @@ struct Config {
     std::string input_file;
     std::vector<std::string> symbols;
     uint64_t publish_interval_us = 1000;  // 1ms default
+    std::string output_file;              // empty = stdout
+    std::string output_format = "csv";    // "csv", "binary", "columnar" or "null"
+    bool publish_thread = false;          // format and write on a dedicated thread
+    std::string checkpoint_file;
+    uint64_t checkpoint_at_message = 0;   // 0 = never
+    std::string restore_file;
+    size_t arena_kb = 0;                  // 0 = global heap
+    std::string order_index = "hash";     // "hash" or "direct"
+    std::string order_record = "wide";    // "wide" or "packed"
+    std::unordered_map<std::string, book::PriceGrid> grids;  // per-symbol tick size and base
+    std::string ring = "events";          // "events" or "bytes"
+    uint64_t ring_stats_ms = 0;           // 0 = report ring telemetry at exit only
+    uint64_t depth_report_ms = 0;         // 0 = no depth snapshot reader
+    std::string depth_history_file;       // empty = no depth history
+    size_t depth_levels = 10;
+    std::string trades_file;              // empty = no trade stream
+    std::string bars_file;                // empty = no bars
+    std::vector<uint64_t> bar_intervals_ms = {1000};
+    std::string analytics_file;           // empty = book analytics off
+    size_t analytics_levels = 5;
+    uint32_t analytics_bps = 10;
+    std::string shm_name;                 // empty = no shared-memory ring
+    size_t shm_slots = 65536;
+    std::string udp_endpoint;             // empty = no UDP multicast
+    std::string udp_interface = "127.0.0.1";
+    std::string overflow = "block";       // "block", "drop" or "conflate"
+    size_t max_queue = 0;                 // 0 = ring capacity
+    std::string ring_pages = "4k";        // "4k", "thp" or "hugetlb"
+    bool ring_prefault = false;
 };
 
 std::atomic<bool> g_shutdown{false};
@@ -42,9 +93,58 @@ void print_usage(const char* program_name) {
               << "  --input FILE              Input binary feed file\n"
               << "  --symbols SYM1,SYM2,...   Comma-separated list of symbols to process\n"
               << "  --publish-top-of-book-us N Publish interval in microseconds (default: 1000)\n"
+              << "  --output FILE             Write top of book to FILE instead of stdout\n"
+              << "  --output-format FORMAT    Top of book as csv, binary, columnar or null (default: csv)\n"
+              << "  --publish-thread          Format and write top of book on a dedicated thread\n"
+              << "  --checkpoint FILE         Write a book checkpoint to FILE\n"
+              << "  --checkpoint-at N         Take the checkpoint after N messages\n"
+              << "  --restore FILE            Restore books from a checkpoint and resume replay\n"
+              << "  --arena-kb N              Give each book an N KiB memory arena (default: heap)\n"
+              << "  --order-index MODE        Order lookup: hash or direct (default: hash)\n"
+              << "  --order-record MODE       Order storage: wide or packed (default: wide)\n"
+              << "  --tick-size SYM:TICK[:BASE] Price grid for SYM, e.g. AAPL:0.01:100 (repeatable)\n"
+              << "  --ring MODE               Decoder->book queue: events or bytes (default: events)\n"
+              << "  --ring-stats-ms N         Also report ring telemetry every N ms\n"
+              << "  --depth-report-ms N       Snapshot full depth from another thread every N ms\n"
+              << "  --depth-history FILE      Write the top levels of every book to a columnar FILE\n"
+              << "                            at each publish interval\n"
+              << "  --depth-levels N          Levels per side for --depth-history (default: 10)\n"
+              << "  --trades FILE             Write a CSV trade for every execute to FILE\n"
+              << "  --bars FILE               Write per-symbol OHLCV/VWAP bars as CSV to FILE\n"
+              << "  --bar-interval-ms MS,...  Bar intervals in feed time (default: 1000)\n"
+              << "  --analytics FILE          Write microprice, imbalance and depth per symbol to FILE\n"
+              << "                            at each publish interval\n"
+              << "  --analytics-levels N      Levels per side for imbalance and depth (default: 5)\n"
+              << "  --analytics-bps X         Band for band depth, in bps of the best price (default: 10)\n"
+              << "  --shm NAME                Also publish top of book to shared-memory ring NAME\n"
+              << "  --shm-slots N             Shared-memory ring size in records (default: 65536)\n"
+              << "  --udp GROUP:PORT          Also multicast top of book to GROUP:PORT\n"
+              << "  --udp-interface ADDR      Interface for --udp (default: 127.0.0.1)\n"
+              << "  --ring-pages MODE         Event ring pages: 4k, thp or hugetlb (default: 4k)\n"
+              << "  --ring-prefault           Fault the event ring in on the book thread's NUMA node\n"
+              << "  --overflow POLICY         When the ring is full: block, drop or conflate (default: block)\n"
+              << "  --max-queue N             Queue depth that triggers the overflow policy, in ring\n"
+              << "                            units (events, or bytes with --ring bytes; default: capacity)\n"
               << "  --help                    Show this help message\n";
 }
 
+/**
+ * @brief Parse a decimal price ("100.25") into nano-units
+ * @throws std::invalid_argument if the string is not a non-negative decimal
+ */
+int64_t parse_price_nano(const std::string& text) {
+    const size_t dot = text.find('.');
+    const std::string whole = text.substr(0, dot);
+    std::string fraction = dot == std::string::npos ? "" : text.substr(dot + 1);
+    if ((whole.empty() && fraction.empty()) || fraction.size() > 9 ||
+        whole.find_first_not_of("0123456789") != std::string::npos ||
+        fraction.find_first_not_of("0123456789") != std::string::npos) {
+        throw std::invalid_argument("invalid price: " + text);
+    }
+    fraction.resize(9, '0');
+    return (whole.empty() ? 0 : std::stoll(whole)) * 1000000000LL + std::stoll(fraction);
+}
+
 Config parse_args(int argc, char* argv[]) {
     Config config;
     
@@ -52,12 +152,41 @@ Config parse_args(int argc, char* argv[]) {
         {"input", required_argument, 0, 'i'},
         {"symbols", required_argument, 0, 's'},
         {"publish-top-of-book-us", required_argument, 0, 'p'},
+        {"output", required_argument, 0, 'w'},
+        {"output-format", required_argument, 0, 'f'},
+        {"publish-thread", no_argument, 0, 'B'},
+        {"checkpoint", required_argument, 0, 'c'},
+        {"checkpoint-at", required_argument, 0, 'n'},
+        {"restore", required_argument, 0, 'r'},
+        {"arena-kb", required_argument, 0, 'a'},
+        {"order-index", required_argument, 0, 'o'},
+        {"order-record", required_argument, 0, 'R'},
+        {"tick-size", required_argument, 0, 't'},
+        {"ring", required_argument, 0, 'g'},
+        {"ring-stats-ms", required_argument, 0, 'T'},
+        {"depth-report-ms", required_argument, 0, 'd'},
+        {"depth-history", required_argument, 0, 'H'},
+        {"depth-levels", required_argument, 0, 'L'},
+        {"trades", required_argument, 0, 'x'},
+        {"bars", required_argument, 0, 'b'},
+        {"bar-interval-ms", required_argument, 0, 'l'},
+        {"analytics", required_argument, 0, 'A'},
+        {"analytics-levels", required_argument, 0, 'N'},
+        {"analytics-bps", required_argument, 0, 'X'},
+        {"shm", required_argument, 0, 'm'},
+        {"shm-slots", required_argument, 0, 'M'},
+        {"udp", required_argument, 0, 'u'},
+        {"udp-interface", required_argument, 0, 'I'},
+        {"ring-pages", required_argument, 0, 'P'},
+        {"ring-prefault", no_argument, 0, 'F'},
+        {"overflow", required_argument, 0, 'O'},
+        {"max-queue", required_argument, 0, 'Q'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}
     };
     
     int c;
-    while ((c = getopt_long(argc, argv, "i:s:p:h", long_options, nullptr)) != -1) {
+    while ((c = getopt_long(argc, argv, "i:s:p:w:f:Bc:n:r:a:o:R:t:g:T:d:H:L:x:b:l:A:N:X:P:Fm:M:u:I:O:Q:h", long_options, nullptr)) != -1) {
         switch (c) {
             case 'i':
                 config.input_file = optarg;
@@ -74,6 +203,113 @@ Config parse_args(int argc, char* argv[]) {
             case 'p':
                 config.publish_interval_us = std::stoull(optarg);
                 break;
+            case 'w':
+                config.output_file = optarg;
+                break;
+            case 'f':
+                config.output_format = optarg;
+                break;
+            case 'c':
+                config.checkpoint_file = optarg;
+                break;
+            case 'n':
+                config.checkpoint_at_message = std::stoull(optarg);
+                break;
+            case 'r':
+                config.restore_file = optarg;
+                break;
+            case 'a':
+                config.arena_kb = std::stoull(optarg);
+                break;
+            case 'o':
+                config.order_index = optarg;
+                break;
+            case 'R':
+                config.order_record = optarg;
+                break;
+            case 't': {
+                // SYM:TICK[:BASE], prices in decimal
+                std::stringstream ss(optarg);
+                std::string symbol, tick, base;
+                std::getline(ss, symbol, ':');
+                std::getline(ss, tick, ':');
+                std::getline(ss, base, ':');
+                book::PriceGrid grid;
+                grid.tick_px = parse_price_nano(tick);
+                grid.base_px = base.empty() ? 0 : parse_price_nano(base);
+                if (symbol.empty() || grid.tick_px <= 0) {
+                    std::cerr << "Error: invalid --tick-size " << optarg << "\n";
+                    std::exit(1);
+                }
+                config.grids[symbol] = grid;
+                break;
+            }
+            case 'g':
+                config.ring = optarg;
+                break;
+            case 'T':
+                config.ring_stats_ms = std::stoull(optarg);
+                break;
+            case 'd':
+                config.depth_report_ms = std::stoull(optarg);
+                break;
+            case 'H':
+                config.depth_history_file = optarg;
+                break;
+            case 'L':
+                config.depth_levels = std::stoull(optarg);
+                break;
+            case 'A':
+                config.analytics_file = optarg;
+                break;
+            case 'N':
+                config.analytics_levels = std::stoull(optarg);
+                break;
+            case 'X':
+                config.analytics_bps = static_cast<uint32_t>(std::stoul(optarg));
+                break;
+            case 'x':
+                config.trades_file = optarg;
+                break;
+            case 'b':
+                config.bars_file = optarg;
+                break;
+            case 'l': {
+                config.bar_intervals_ms.clear();
+                std::stringstream ss(optarg);
+                std::string interval;
+                while (std::getline(ss, interval, ',')) {
+                    config.bar_intervals_ms.push_back(std::stoull(interval));
+                }
+                break;
+            }
+            case 'P':
+                config.ring_pages = optarg;
+                break;
+            case 'F':
+                config.ring_prefault = true;
+                break;
+            case 'B':
+                config.publish_thread = true;
+                break;
+            case 'm':
+                config.shm_name = optarg;
+                break;
+            case 'M':
+                config.shm_slots = std::stoull(optarg);
+                break;
+            case 'u':
+                config.udp_endpoint = optarg;
+                break;
+            case 'I':
+                config.udp_interface = optarg;
+                break;
+            case 'O':
+                config.overflow = optarg;
+                break;
+            case 'Q':
+                config.max_queue = std::stoull(optarg);
+                break;
             case 'h':
                 print_usage(argv[0]);
                 std::exit(0);
@@ -95,6 +331,109 @@ Config parse_args(int argc, char* argv[]) {
         std::exit(1);
     }
     
+    if (config.checkpoint_file.empty() != (config.checkpoint_at_message == 0)) {
+        std::cerr << "Error: --checkpoint and --checkpoint-at must be given together\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.output_format != "csv" && config.output_format != "binary" && config.output_format != "columnar" &&
+        config.output_format != "null") {
+        std::cerr << "Error: --output-format must be csv, binary, columnar or null\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.output_format == "columnar" && config.output_file.empty()) {
+        std::cerr << "Error: --output-format columnar needs --output\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.depth_levels == 0) {
+        std::cerr << "Error: --depth-levels must be at least 1\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.analytics_levels == 0) {
+        std::cerr << "Error: --analytics-levels must be at least 1\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.bar_intervals_ms.empty() ||
+        std::find(config.bar_intervals_ms.begin(), config.bar_intervals_ms.end(), 0) != config.bar_intervals_ms.end()) {
+        std::cerr << "Error: --bar-interval-ms needs intervals of at least 1 ms\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.order_index != "hash" && config.order_index != "direct") {
+        std::cerr << "Error: --order-index must be hash or direct\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.order_record != "wide" && config.order_record != "packed") {
+        std::cerr << "Error: --order-record must be wide or packed\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.ring != "events" && config.ring != "bytes") {
+        std::cerr << "Error: --ring must be events or bytes\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.ring_pages != "4k" && config.ring_pages != "thp" && config.ring_pages != "hugetlb") {
+        std::cerr << "Error: --ring-pages must be 4k, thp or hugetlb\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if ((config.ring_pages != "4k" || config.ring_prefault) && config.ring != "events") {
+        std::cerr << "Error: --ring-pages and --ring-prefault need --ring events\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.shm_slots == 0 || (config.shm_slots & (config.shm_slots - 1)) != 0) {
+        std::cerr << "Error: --shm-slots must be a power of 2\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.overflow != "block" && config.overflow != "drop" && config.overflow != "conflate") {
+        std::cerr << "Error: --overflow must be block, drop or conflate\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    // A checkpoint must describe exactly the messages applied so far
+    if (config.overflow != "block" && !config.checkpoint_file.empty()) {
+        std::cerr << "Error: --overflow " << config.overflow << " cannot be combined with --checkpoint\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    if (config.overflow == "conflate" && config.ring != "events") {
+        std::cerr << "Error: --overflow conflate needs --ring events\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    // Packed records hold 31-bit tick offsets, so nano-tick grids rarely fit
+    if (config.order_record == "packed") {
+        for (const auto& symbol : config.symbols) {
+            if (config.grids.find(symbol) == config.grids.end()) {
+                std::cerr << "Error: --order-record packed needs --tick-size for " << symbol << "\n";
+                std::exit(1);
+            }
+        }
+    }
+    
     return config;
 }
 
@@ -127,170 +466,807 @@ struct LatencyStats {
     }
 };
 
-} // anonymous namespace
+/**
+ * @brief Print ring telemetry to stderr
+ * @param stats Counters from RingBuffer::stats() or ByteRing::stats()
+ * @param capacity Ring capacity, in the unit of stats.high_water
+ * @param unit "events" or "bytes"
+ */
+void report_ring_stats(const core::RingStats& stats, size_t capacity, const char* unit) {
+    std::cerr << "Ring: pushes=" << stats.pushes
+              << " pops=" << stats.pops
+              << " full_spins=" << stats.full_spins
+              << " empty_spins=" << stats.empty_spins
+              << " high_water=" << stats.high_water << "/" << capacity << " " << unit
+              << " (" << (100.0 * static_cast<double>(stats.high_water) / static_cast<double>(capacity)) << "%)\n";
+}
 
-int main(int argc, char* argv[]) {
-    // Install signal handler
-    std::signal(SIGINT, signal_handler);
-    std::signal(SIGTERM, signal_handler);
+/**
+ * @brief Decode, apply and publish the feed with one Book per symbol
+ */
+template<typename Book>
+void run(const Config& config) {
+    // Create decoder
+    feed::Decoder decoder(config.input_file);
     
-    try {
-        Config config = parse_args(argc, argv);
-        
-        // Create decoder
-        feed::Decoder decoder(config.input_file);
-        
-        // Create ring buffer for events (power of 2 size)
-        constexpr size_t RING_BUFFER_SIZE = 1024 * 1024;  // 1M events
-        core::RingBuffer<feed::Event> ring_buffer(RING_BUFFER_SIZE);
-        
-        // Create order books for each symbol
-        std::unordered_map<feed::Symbol, book::OrderBook> order_books;
-        for (const auto& symbol_str : config.symbols) {
-            feed::Symbol symbol(symbol_str.c_str());
-            order_books[symbol] = book::OrderBook();
+    // Create ring buffer for events (power of 2 size)
+    constexpr size_t RING_BUFFER_SIZE = 1024 * 1024;  // 1M events
+    constexpr size_t BYTE_RING_SIZE = 32 * 1024 * 1024;  // raw messages (--ring bytes)
+    constexpr size_t PRODUCER_BATCH = 64;              // slots claimed per commit
+    constexpr size_t CONSUMER_BATCH = 64;              // slots read per release
+    const bool raw_ring = config.ring == "bytes";
+    std::unique_ptr<core::RingBuffer<feed::Event>> ring_buffer;
+    std::unique_ptr<core::ByteRing> byte_ring;
+    if (raw_ring) {
+        byte_ring = std::make_unique<core::ByteRing>(BYTE_RING_SIZE);
+    } else if (config.ring_pages != "4k" || config.ring_prefault) {
+        // This thread runs the book, so the ring lives on its NUMA node
+        core::PageOptions pages;
+        pages.pages = config.ring_pages == "hugetlb" ? core::PageMode::HUGETLB
+                    : config.ring_pages == "thp"     ? core::PageMode::TRANSPARENT
+                                                     : core::PageMode::SMALL;
+        pages.numa_node = core::current_numa_node();
+        pages.prefault = config.ring_prefault;
+        ring_buffer = std::make_unique<core::RingBuffer<feed::Event>>(RING_BUFFER_SIZE, pages);
+        const core::MappedRegion& region = ring_buffer->region();
+        std::cerr << "Ring memory: " << region.size() << " bytes, pages=" << core::page_mode_name(region.pages())
+                  << " numa_node=" << pages.numa_node << (region.numa_bound() ? "" : " (unbound)")
+                  << (pages.prefault ? " prefaulted" : "") << "\n";
+    } else {
+        ring_buffer = std::make_unique<core::RingBuffer<feed::Event>>(RING_BUFFER_SIZE);
+    }
+    
+    // Overflow policy: past max_queue the producer drops or conflates instead of waiting
+    const bool bounded = config.overflow != "block";
+    const bool drop_overflow = config.overflow == "drop";
+    std::optional<feed::EventConflator> conflator;
+    if (config.overflow == "conflate") {
+        conflator.emplace();
+    }
+    const size_t ring_capacity = raw_ring ? BYTE_RING_SIZE : RING_BUFFER_SIZE;
+    const size_t max_queue = config.max_queue == 0 ? ring_capacity : std::min(config.max_queue, ring_capacity);
+    uint64_t dropped_messages = 0;
+    std::atomic<bool> producer_finished{false};
+    auto queued = [&]() -> size_t {
+        return raw_ring ? byte_ring->used_bytes() : ring_buffer->size();
+    };
+    
+    // Per-book arenas (declared before the books so they outlive them)
+    std::unordered_map<feed::Symbol, std::unique_ptr<core::ArenaResource>> book_arenas;
+    
+    // Create order books for each symbol
+    std::unordered_map<feed::Symbol, Book> order_books;
+    for (const auto& symbol_str : config.symbols) {
+        feed::Symbol symbol(symbol_str.c_str());
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+        if (config.arena_kb > 0) {
+            auto& arena = book_arenas[symbol];
+            arena = std::make_unique<core::ArenaResource>(config.arena_kb * 1024);
+            resource = arena.get();
         }
-        
-        // Create publisher
-        publish::TopOfBookPublisher publisher;
-        
-        // Statistics
-        LatencyStats latency_stats;
-        uint64_t total_messages = 0;
-        uint64_t start_time_us = core::Clock::now_us();
-        uint64_t last_publish_us = start_time_us;
-        
-        // Producer thread - decode messages and push to ring buffer
-        std::thread producer([&]() {
-            while (!g_shutdown && decoder.has_next()) {
-                feed::Event event = decoder.next();
-                if (event.type == feed::EventType::INVALID) {
-                    continue;
+        auto grid = config.grids.find(symbol_str);
+        auto [it, inserted] = order_books.try_emplace(
+            symbol, grid != config.grids.end() ? grid->second : book::PriceGrid{}, resource);
+        if (inserted && !config.analytics_file.empty()) {
+            it->second.enable_analytics(config.analytics_levels, config.analytics_bps);
+        }
+    }
+    
+    // Warm start: restore books and skip the part of the feed they already cover
+    uint64_t restored_messages = 0;
+    if (!config.restore_file.empty()) {
+        book::SnapshotPosition position = book::load_snapshot(config.restore_file, order_books);
+        book::verify_snapshot_feed(position, decoder.data());
+        decoder.seek(position.feed_offset);
+        restored_messages = position.message_count;
+        std::cerr << "Restored checkpoint " << config.restore_file
+                  << " at offset " << position.feed_offset
+                  << " (" << position.message_count << " messages)\n";
+    }
+    
+    // Checkpoint handshake: the producer parks after the checkpoint message so the
+    // consumer can record a decoder offset that matches the books exactly
+    const bool checkpoint_enabled = !config.checkpoint_file.empty() &&
+                                    config.checkpoint_at_message > restored_messages;
+    std::atomic<bool> producer_parked{false};
+    std::atomic<bool> checkpoint_done{!checkpoint_enabled};
+    size_t checkpoint_offset = 0;
+    
+    // Current top of book per symbol, readable from any thread; entries follow
+    // the books' iteration order so published rows keep their order
+    book::TopOfBookTable quotes(order_books.size());
+    std::unordered_map<feed::Symbol, size_t> quote_slots;
+    std::vector<const Book*> slot_books;
+    for (const auto& [sym, book] : order_books) {
+        const size_t slot = quotes.add_symbol(sym);
+        quote_slots.emplace(sym, slot);
+        slot_books.push_back(&book);
+        quotes.update(slot, book.top_of_book(), core::Clock::now_us());
+    }
+    
+    // Full-depth snapshots, built on this thread only when a reader asks
+    std::vector<std::unique_ptr<book::DepthPublisher>> depth;
+    if (config.depth_report_ms > 0) {
+        for (size_t slot = 0; slot < quotes.size(); ++slot) {
+            depth.push_back(std::make_unique<book::DepthPublisher>());
+        }
+    }
+    
+    // Create publisher
+    std::ofstream csv_file;
+    std::vector<feed::Symbol> symbol_ids;  // Record symbol id = quote slot
+    for (size_t slot = 0; slot < quotes.size(); ++slot) {
+        symbol_ids.push_back(quotes.symbol(slot));
+    }
+    std::optional<publish::BinaryTopOfBookPublisher> binary_publisher;
+    std::optional<publish::ColumnarWriter> columnar_writer;
+    if (config.output_format == "binary") {
+        binary_publisher.emplace(config.output_file.empty() ? "-" : config.output_file, symbol_ids);
+    } else if (config.output_format == "columnar") {
+        columnar_writer.emplace(config.output_file, publish::columnar_tob_columns(), symbol_ids);
+    } else if (config.output_format == "csv" && !config.output_file.empty()) {
+        csv_file.open(config.output_file);
+        if (!csv_file) {
+            throw std::runtime_error("Cannot create " + config.output_file);
+        }
+    }
+    // Flushed once per publish round (or batch) by publish::CsvSink
+    publish::TopOfBookPublisher publisher(csv_file.is_open() ? csv_file : std::cout, false);
+    std::optional<publish::ShmTopOfBookPublisher> shm_publisher;
+    if (!config.shm_name.empty()) {
+        shm_publisher.emplace(config.shm_name, config.shm_slots);
+    }
+    std::optional<publish::UdpTopOfBookPublisher> udp_publisher;
+    if (!config.udp_endpoint.empty()) {
+        const auto [group, port] = publish::parse_udp_endpoint(config.udp_endpoint);
+        udp_publisher.emplace(group, port, config.udp_interface);
+    }
+    
+    std::optional<publish::AsyncPublisher> async_publisher;
+    std::optional<publish::ColumnarWriter> depth_history;
+    if (!config.depth_history_file.empty()) {
+        depth_history.emplace(config.depth_history_file, publish::columnar_depth_columns(), symbol_ids);
+    }
+    
+    // Book analytics, read from the books on this thread at each publish
+    std::ofstream analytics_file;
+    std::optional<publish::AnalyticsPublisher> analytics_publisher;
+    if (!config.analytics_file.empty()) {
+        analytics_file.open(config.analytics_file);
+        if (!analytics_file) {
+            throw std::runtime_error("Cannot create " + config.analytics_file);
+        }
+        analytics_publisher.emplace(analytics_file);
+    }
+    
+    // Trades and bars, built from execute messages on this thread; both off
+    // means execute messages take the plain on_execute path
+    std::ofstream trades_file;
+    std::ofstream bars_file;
+    std::optional<publish::TradePublisher> trade_publisher;
+    std::optional<publish::BarPublisher> bar_publisher;
+    std::vector<std::vector<book::BarAggregator>> bar_aggregators;  // per quote slot
+    if (!config.trades_file.empty()) {
+        trades_file.open(config.trades_file);
+        if (!trades_file) {
+            throw std::runtime_error("Cannot create " + config.trades_file);
+        }
+        trade_publisher.emplace(trades_file);
+    }
+    if (!config.bars_file.empty()) {
+        bars_file.open(config.bars_file);
+        if (!bars_file) {
+            throw std::runtime_error("Cannot create " + config.bars_file);
+        }
+        bar_publisher.emplace(bars_file);
+        bar_aggregators.resize(quotes.size());
+        for (std::vector<book::BarAggregator>& aggregators : bar_aggregators) {
+            for (const uint64_t interval_ms : config.bar_intervals_ms) {
+                aggregators.emplace_back(interval_ms * 1000);
+            }
+        }
+    }
+    const bool trades_enabled = trade_publisher || bar_publisher;
+    uint64_t next_bar_close_us = UINT64_MAX;  // Earliest end of an open bar
+    
+    // Close every bar whose interval ended before feed time now_us
+    auto close_due_bars = [&](uint64_t now_us) {
+        next_bar_close_us = UINT64_MAX;
+        for (size_t slot = 0; slot < bar_aggregators.size(); ++slot) {
+            for (book::BarAggregator& aggregator : bar_aggregators[slot]) {
+                book::Bar bar;
+                if (aggregator.close_if_due(now_us, bar)) {
+                    bar_publisher->publish(quotes.symbol(slot), bar);
+                } else if (aggregator.has_open_bar()) {
+                    next_bar_close_us = std::min(next_bar_close_us, aggregator.current().end_us());
                 }
-                
-                // Try to push to ring buffer (non-blocking)
-                while (!ring_buffer.try_push(std::move(event)) && !g_shutdown) {
-                    // Ring buffer full, yield briefly
+            }
+        }
+    };
+    
+    auto record_trade = [&](size_t slot, const book::Trade& trade) {
+        if (trade_publisher) {
+            trade_publisher->publish(quotes.symbol(slot), trade);
+        }
+        if (bar_publisher) {
+            for (book::BarAggregator& aggregator : bar_aggregators[slot]) {
+                book::Bar bar;
+                if (aggregator.on_trade(trade, bar)) {
+                    bar_publisher->publish(quotes.symbol(slot), bar);
+                }
+                next_bar_close_us = std::min(next_bar_close_us, aggregator.current().end_us());
+            }
+        }
+    };
+    
+    // Statistics
+    LatencyStats latency_stats;
+    uint64_t total_messages = 0;
+    uint64_t start_time_us = core::Clock::now_us();
+    uint64_t last_publish_us = start_time_us;
+    uint64_t last_stats_us = start_time_us;
+    auto report_ring = [&]() {
+        if (raw_ring) {
+            report_ring_stats(byte_ring->stats(), byte_ring->capacity(), "bytes");
+        } else {
+            report_ring_stats(ring_buffer->stats(), ring_buffer->capacity(), "events");
+        }
+    };
+    
+    // Decode up to limit messages straight into claimed ring buffer slots
+    auto decode_events = [&](size_t limit) -> size_t {
+        std::span<feed::Event> slots = ring_buffer->claim_batch(limit);
+        size_t filled = 0;
+        while (filled < slots.size() && decoder.has_next()) {
+            if (decoder.next_into(slots[filled])) {
+                filled++;
+            }
+        }
+        ring_buffer->commit(filled);
+        return filled;
+    };
+    
+    // Copy up to limit wire messages into the byte ring; the consumer decodes
+    auto frame_messages = [&](size_t limit) -> size_t {
+        size_t framed = 0;
+        while (framed < limit) {
+            const size_t position = decoder.position();
+            std::span<const char> raw = decoder.next_raw();
+            if (raw.empty()) {
+                break;
+            }
+            char* slot = byte_ring->try_claim(raw.size());
+            if (slot == nullptr) {
+                decoder.seek(position);  // Ring full; retry this message
+                break;
+            }
+            std::memcpy(slot, raw.data(), raw.size());
+            framed++;
+        }
+        byte_ring->commit();
+        return framed;
+    };
+    
+    // Producer thread - fill the ring in batches
+    std::thread producer([&]() {
+        uint64_t pushed = restored_messages;
+        auto park_at_checkpoint = [&]() {
+            if (pushed == config.checkpoint_at_message && !checkpoint_done.load(std::memory_order_acquire)) {
+                checkpoint_offset = decoder.position();
+                producer_parked.store(true, std::memory_order_release);
+                while (!checkpoint_done.load(std::memory_order_acquire) && !g_shutdown) {
                     std::this_thread::yield();
                 }
             }
-        });
+        };
+        while (!g_shutdown && decoder.has_next()) {
+            park_at_checkpoint();
+            
+            // Never batch across the checkpoint message
+            size_t limit = PRODUCER_BATCH;
+            if (!checkpoint_done.load(std::memory_order_relaxed) && config.checkpoint_at_message > pushed) {
+                limit = std::min<uint64_t>(limit, config.checkpoint_at_message - pushed);
+            }
+            
+            if (bounded) {
+                const size_t depth = queued();
+                if (conflator && (depth >= max_queue || !conflator->empty())) {
+                    // Behind: merge new events per order and feed the net result as room appears
+                    if (depth < max_queue) {
+                        std::span<feed::Event> slots = ring_buffer->claim_batch(std::min(max_queue - depth, limit));
+                        ring_buffer->commit(conflator->drain(slots));
+                    }
+                    feed::Event event;
+                    if (decoder.next_into(event)) {
+                        conflator->add(event);
+                    }
+                    continue;
+                }
+                if (drop_overflow && depth >= max_queue) {
+                    if (!decoder.next_raw().empty()) {
+                        dropped_messages++;
+                    }
+                    continue;
+                }
+                if (!raw_ring) {
+                    limit = std::min(limit, max_queue - depth);
+                }
+            }
+            
+            const size_t filled = raw_ring ? frame_messages(limit) : decode_events(limit);
+            if (filled == 0) {
+                if (drop_overflow && decoder.has_next()) {
+                    // Ring full: drop the newest message rather than wait
+                    if (!decoder.next_raw().empty()) {
+                        dropped_messages++;
+                    }
+                    continue;
+                }
+                // Ring buffer full, yield briefly
+                std::this_thread::yield();
+                continue;
+            }
+            pushed += filled;
+        }
+        // The checkpoint message may be the last one in the feed
+        if (!g_shutdown) {
+            park_at_checkpoint();
+        }
         
-        // Consumer thread - process events from ring buffer
-        feed::Event event;
-        while (!g_shutdown) {
-            if (ring_buffer.try_pop(event)) {
-                // Process event based on type
-                bool processed = false;
-                feed::Symbol symbol;
+        // Feed ended while behind: flush what is still conflated
+        while (conflator && !conflator->empty() && !g_shutdown) {
+            std::span<feed::Event> slots = ring_buffer->claim_batch(PRODUCER_BATCH);
+            const size_t drained = conflator->drain(slots);
+            ring_buffer->commit(drained);
+            if (drained == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producer_finished.store(true, std::memory_order_release);
+    });
+    
+    // Apply one decoded event to its book
+    auto apply_event = [&](const feed::Event& event) {
+        bool processed = false;
+        feed::Symbol symbol;
+        const Book* touched = nullptr;
+        
+        // Bars whose interval this event's feed time has passed are written first
+        if (bar_publisher) {
+            const uint64_t feed_us = feed::event_timestamp(event);
+            if (feed_us >= next_bar_close_us) {
+                close_due_bars(feed_us);
+            }
+        }
+        
+        switch (event.type) {
+            case feed::EventType::ADD_ORDER: {
+                const auto& msg = event.payload.add;
+                symbol = feed::Symbol(msg.symbol);
                 
-                switch (event.type) {
-                    case feed::EventType::ADD_ORDER: {
-                        const auto& msg = event.payload.add;
-                        symbol = feed::Symbol(msg.symbol);
-                        
-                        auto it = order_books.find(symbol);
-                        if (it != order_books.end()) {
-                            book::Side side = (msg.side == 'B') ? book::Side::BUY : book::Side::SELL;
-                            processed = it->second.on_add(msg.order_id, side, msg.px_nano, msg.qty);
-                        }
+                auto it = order_books.find(symbol);
+                if (it != order_books.end()) {
+                    book::Side side = (msg.side == 'B') ? book::Side::BUY : book::Side::SELL;
+                    processed = it->second.on_add(msg.order_id, side, msg.px_nano, msg.qty);
+                    touched = &it->second;
+                }
+                break;
+            }
+            case feed::EventType::MODIFY_ORDER: {
+                const auto& msg = event.payload.modify;
+                // Find which order book contains this order
+                for (auto& [sym, book] : order_books) {
+                    if (book.on_modify(msg.order_id, msg.new_px_nano, msg.new_qty)) {
+                        symbol = sym;
+                        processed = true;
+                        touched = &book;
                         break;
                     }
-                    case feed::EventType::MODIFY_ORDER: {
-                        const auto& msg = event.payload.modify;
-                        // Find which order book contains this order
-                        for (auto& [sym, book] : order_books) {
-                            if (book.on_modify(msg.order_id, msg.new_px_nano, msg.new_qty)) {
-                                symbol = sym;
-                                processed = true;
-                                break;
-                            }
+                }
+                break;
+            }
+            case feed::EventType::EXECUTE_ORDER: {
+                const auto& msg = event.payload.execute;
+                // Find which order book contains this order
+                book::OrderInfo resting;
+                for (auto& [sym, book] : order_books) {
+                    if (trades_enabled ? book.on_execute(msg.order_id, msg.exec_qty, resting)
+                                       : book.on_execute(msg.order_id, msg.exec_qty)) {
+                        symbol = sym;
+                        processed = true;
+                        touched = &book;
+                        if (trades_enabled) {
+                            record_trade(quote_slots.find(sym)->second,
+                                         book::Trade{msg.ts_us, msg.order_id, resting.price, msg.exec_qty, resting.side});
                         }
                         break;
                     }
-                    case feed::EventType::EXECUTE_ORDER: {
-                        const auto& msg = event.payload.execute;
-                        // Find which order book contains this order
-                        for (auto& [sym, book] : order_books) {
-                            if (book.on_execute(msg.order_id, msg.exec_qty)) {
-                                symbol = sym;
-                                processed = true;
-                                break;
-                            }
-                        }
+                }
+                break;
+            }
+            case feed::EventType::DELETE_ORDER: {
+                const auto& msg = event.payload.delete_order;
+                // Find which order book contains this order
+                for (auto& [sym, book] : order_books) {
+                    if (book.on_delete(msg.order_id)) {
+                        symbol = sym;
+                        processed = true;
+                        touched = &book;
                         break;
                     }
-                    case feed::EventType::DELETE_ORDER: {
-                        const auto& msg = event.payload.delete_order;
-                        // Find which order book contains this order
-                        for (auto& [sym, book] : order_books) {
-                            if (book.on_delete(msg.order_id)) {
-                                symbol = sym;
-                                processed = true;
-                                break;
-                            }
-                        }
-                        break;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        
+        if (processed) {
+            uint64_t apply_end_us = core::Clock::now_us();
+            uint64_t latency_us = apply_end_us - event.decode_timestamp_us;
+            latency_stats.add(latency_us);
+            quotes.update(quote_slots.find(symbol)->second, touched->top_of_book(), apply_end_us);
+        }
+    };
+    
+    // Per-message bookkeeping: checkpoint handshake and periodic publishing
+    auto finish_message = [&](auto& sink) {
+        total_messages++;
+        
+        if (!checkpoint_done.load(std::memory_order_relaxed) &&
+            restored_messages + total_messages == config.checkpoint_at_message) {
+            while (!producer_parked.load(std::memory_order_acquire) && !g_shutdown) {
+                std::this_thread::yield();
+            }
+            if (!producer_parked.load(std::memory_order_acquire)) {
+                // Shut down before the producer recorded the offset: the books
+                // match no known feed position
+                std::cerr << "Checkpoint not reached\n";
+            } else {
+                try {
+                    const uint64_t feed_checksum = book::snapshot_checksum(decoder.data().data(), checkpoint_offset);
+                    book::save_snapshot(config.checkpoint_file, order_books,
+                                        {checkpoint_offset, config.checkpoint_at_message, feed_checksum});
+                    std::cerr << "Wrote checkpoint " << config.checkpoint_file
+                              << " at offset " << checkpoint_offset << "\n";
+                } catch (const std::exception& e) {
+                    // Never leave the producer parked on a failed checkpoint
+                    std::cerr << "Checkpoint failed: " << e.what() << "\n";
+                }
+            }
+            checkpoint_done.store(true, std::memory_order_release);
+        }
+        
+        // Check if it's time to publish
+        uint64_t current_time_us = core::Clock::now_us();
+        if (current_time_us - last_publish_us >= config.publish_interval_us) {
+            // Publish top of book for all symbols
+            for (size_t slot = 0; slot < quotes.size(); ++slot) {
+                const publish::BinaryTobRecord record = publish::make_binary_tob_record(
+                    current_time_us, static_cast<uint32_t>(slot), quotes.read(slot).tob);
+                if (async_publisher) {
+                    async_publisher->publish(record);
+                } else {
+                    sink.write(record, quotes.symbol(slot));
+                }
+            }
+            if (!async_publisher) {
+                sink.end_round();
+            }
+            if (depth_history) {
+                for (size_t slot = 0; slot < slot_books.size(); ++slot) {
+                    for (const book::Side side : {book::Side::BUY, book::Side::SELL}) {
+                        int64_t level = 0;
+                        slot_books[slot]->for_each_level(side, [&](int64_t price, uint32_t quantity) {
+                            const int64_t row[] = {static_cast<int64_t>(current_time_us), static_cast<int64_t>(slot),
+                                                   side == book::Side::SELL, level, price, quantity};
+                            depth_history->append(row);
+                            return static_cast<size_t>(++level) < config.depth_levels;
+                        });
                     }
-                    default:
-                        break;
                 }
-                
-                if (processed) {
-                    uint64_t apply_end_us = core::Clock::now_us();
-                    uint64_t latency_us = apply_end_us - event.decode_timestamp_us;
-                    latency_stats.add(latency_us);
+            }
+            if (analytics_publisher) {
+                for (size_t slot = 0; slot < slot_books.size(); ++slot) {
+                    analytics_publisher->publish(current_time_us, quotes.symbol(slot), slot_books[slot]->analytics());
                 }
-                
-                total_messages++;
-                
-                // Check if it's time to publish
-                uint64_t current_time_us = core::Clock::now_us();
-                if (current_time_us - last_publish_us >= config.publish_interval_us) {
-                    // Publish top of book for all symbols
-                    for (const auto& [sym, book] : order_books) {
-                        book::TopOfBook tob = book.top_of_book();
-                        publisher.publish(current_time_us, sym, tob);
+            }
+            last_publish_us = current_time_us;
+        }
+        
+        for (size_t slot = 0; slot < depth.size(); ++slot) {
+            depth[slot]->publish_if_wanted(*slot_books[slot], current_time_us);
+        }
+        
+        if (config.ring_stats_ms > 0 && current_time_us - last_stats_us >= config.ring_stats_ms * 1000) {
+            report_ring();
+            last_stats_us = current_time_us;
+        }
+    };
+    
+    // ADD messages for symbols without a book are dropped before decoding;
+    // the symbol is built exactly as apply_event builds it
+    auto wanted = [&](std::span<const char> raw) {
+        if (raw[0] != 'A') {
+            return true;
+        }
+        char name[sizeof(feed::Symbol::data) + 1] = {};
+        std::memcpy(name, raw.data() + offsetof(feed::AddOrderMsg, symbol), sizeof(feed::Symbol::data));
+        return order_books.find(feed::Symbol(name)) != order_books.end();
+    };
+    
+    // Depth reader (stands in for e.g. a risk engine) - asks for a snapshot of
+    // every book, waits for it and reports it, all without touching the books
+    std::atomic<bool> depth_stop{false};
+    std::thread depth_reader;
+    if (!depth.empty()) {
+        depth_reader = std::thread([&]() {
+            while (!depth_stop.load(std::memory_order_acquire)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(config.depth_report_ms));
+                for (size_t slot = 0; slot < depth.size(); ++slot) {
+                    const uint64_t ticket = depth[slot]->request();
+                    while (!depth[slot]->ready(ticket) && !depth_stop.load(std::memory_order_acquire)) {
+                        std::this_thread::yield();
+                    }
+                    std::shared_ptr<const book::DepthSnapshot> snapshot = depth[slot]->snapshot();
+                    if (!snapshot || !depth[slot]->ready(ticket)) {
+                        break;
+                    }
+                    uint64_t bid_qty = 0;
+                    uint64_t ask_qty = 0;
+                    for (const book::PriceLevel& level : snapshot->bids) {
+                        bid_qty += level.quantity;
+                    }
+                    for (const book::PriceLevel& level : snapshot->asks) {
+                        ask_qty += level.quantity;
+                    }
+                    std::ostringstream line;
+                    line << "Depth " << quotes.symbol(slot).to_string()
+                         << ": version=" << snapshot->version
+                         << " bid_levels=" << snapshot->bids.size() << " bid_qty=" << bid_qty
+                         << " ask_levels=" << snapshot->asks.size() << " ask_qty=" << ask_qty << "\n";
+                    std::cerr << line.str();
+                }
+            }
+        });
+    }
+    
+    // Consumer thread - process events from ring buffer
+    auto consume = [&](auto& sink) {
+        feed::Event decoded;
+        while (!g_shutdown) {
+            size_t consumed = 0;
+            if (raw_ring) {
+                // Decode here, and only what a book will use
+                for (; consumed < CONSUMER_BATCH; ++consumed) {
+                    std::span<const char> raw = byte_ring->peek();
+                    if (raw.empty()) {
+                        break;
+                    }
+                    if (wanted(raw) && feed::Decoder::decode(raw, decoded)) {
+                        decoded.decode_timestamp_us = core::Clock::now_us();
+                        apply_event(decoded);
                     }
-                    last_publish_us = current_time_us;
+                    byte_ring->release();
+                    finish_message(sink);
                 }
             } else {
+                // Read events in place and hand the slots back in one release
+                std::span<feed::Event> batch = ring_buffer->peek_batch(CONSUMER_BATCH);
+                for (const feed::Event& event : batch) {
+                    apply_event(event);
+                    finish_message(sink);
+                }
+                ring_buffer->release(batch.size());
+                consumed = batch.size();
+            }
+            
+            if (consumed == 0) {
                 // No events available, yield
                 std::this_thread::yield();
                 
                 // Check if producer is done and buffer is empty
-                if (!producer.joinable() || ring_buffer.empty()) {
-                    if (!decoder.has_next() || g_shutdown) {
+                const bool ring_empty = raw_ring ? byte_ring->empty() : ring_buffer->empty();
+                if (!producer.joinable() || ring_empty) {
+                    if ((!decoder.has_next() && producer_finished.load(std::memory_order_acquire)) || g_shutdown) {
                         break;
                     }
                 }
             }
         }
-        
-        // Wait for producer to finish
-        if (producer.joinable()) {
-            producer.join();
+    };
+    
+    // Pick the outputs once; the consumer loop is compiled for each kind of
+    // primary sink, so the per-record calls are direct
+    using PrimarySink = std::variant<publish::CsvSink, publish::BinarySink, publish::ColumnarSink, publish::NullSink>;
+    PrimarySink primary_sink = publish::NullSink{};
+    if (binary_publisher) {
+        primary_sink = publish::BinarySink(*binary_publisher);
+    } else if (columnar_writer) {
+        primary_sink = publish::ColumnarSink(*columnar_writer);
+    } else if (config.output_format == "csv") {
+        primary_sink = publish::CsvSink(publisher);
+    }
+    publish::OptionalSink<publish::ShmSink> shm_sink;
+    if (shm_publisher) {
+        shm_sink = publish::OptionalSink<publish::ShmSink>(publish::ShmSink(*shm_publisher));
+    }
+    publish::OptionalSink<publish::UdpSink> udp_sink;
+    if (udp_publisher) {
+        udp_sink = publish::OptionalSink<publish::UdpSink>(publish::UdpSink(*udp_publisher));
+    }
+    
+    std::visit([&](auto primary) {
+        publish::FanOutSink sink(primary, shm_sink, udp_sink);
+        if (config.publish_thread) {
+            // The book thread only queues records; formatting, I/O and the
+            // end-of-round flush (once per batch) happen on the publisher thread
+            async_publisher.emplace([sink, &quotes](std::span<const publish::BinaryTobRecord> batch) mutable {
+                for (const publish::BinaryTobRecord& record : batch) {
+                    sink.write(record, quotes.symbol(record.symbol_id));
+                }
+                sink.end_round();
+            });
         }
-        
-        // Process any remaining events in the buffer
-        while (ring_buffer.try_pop(event)) {
-            // Process remaining events...
+        consume(sink);
+    }, primary_sink);
+    
+    // Wait for producer to finish
+    if (producer.joinable()) {
+        producer.join();
+    }
+    if (!checkpoint_done.load(std::memory_order_acquire)) {
+        std::cerr << "Checkpoint not reached\n";
+    }
+    depth_stop.store(true, std::memory_order_release);
+    if (depth_reader.joinable()) {
+        depth_reader.join();
+    }
+    
+    // Process any remaining events in the buffer
+    if (raw_ring) {
+        for (; !byte_ring->peek().empty(); byte_ring->release()) {
             total_messages++;
         }
+    } else {
+        for (std::span<feed::Event> rest = ring_buffer->peek_batch(RING_BUFFER_SIZE); !rest.empty();
+             rest = ring_buffer->peek_batch(RING_BUFFER_SIZE)) {
+            // Process remaining events...
+            total_messages += rest.size();
+            ring_buffer->release(rest.size());
+        }
+    }
+    
+    uint64_t end_time_us = core::Clock::now_us();
+    uint64_t total_time_us = end_time_us - start_time_us;
+    
+    // Print final statistics
+    double throughput = static_cast<double>(total_messages) / (static_cast<double>(total_time_us) / 1e6);
+    
+    std::cerr << "\nFinal Statistics:\n";
+    std::cerr << "Total messages processed: " << total_messages << "\n";
+    std::cerr << "Total time: " << (total_time_us / 1000.0) << " ms\n";
+    std::cerr << "Throughput: " << static_cast<uint64_t>(throughput) << " msgs/s\n";
+    
+    // Off-grid or unrepresentable prices, apart from the other rejected messages
+    uint64_t price_rejects = 0;
+    for (const auto& [sym, book] : order_books) {
+        price_rejects += book.price_rejects();
+    }
+    std::cerr << "Price rejects: " << price_rejects << "\n";
+    
+    latency_stats.report();
+    report_ring();
+    
+    if (bounded) {
+        std::cerr << "Overflow: policy=" << config.overflow << " max_queue=" << max_queue;
+        if (conflator) {
+            std::cerr << " events_in=" << conflator->events_in()
+                      << " events_out=" << conflator->events_out()
+                      << " conflated=" << (conflator->events_in() - conflator->events_out());
+        } else {
+            std::cerr << " dropped=" << dropped_messages;
+        }
+        std::cerr << "\n";
+    }
+    
+    if (async_publisher) {
+        async_publisher->stop();
+        const core::RingStats stats = async_publisher->stats();
+        std::cerr << "Publisher thread: records=" << async_publisher->published()
+                  << " batches=" << async_publisher->batches()
+                  << " full_waits=" << async_publisher->full_waits()
+                  << " high_water=" << stats.high_water << "\n";
+    }
+    
+    if (binary_publisher) {
+        binary_publisher->close();
+        std::cerr << "Binary output: records=" << binary_publisher->published() << "\n";
+    }
+    
+    if (columnar_writer) {
+        columnar_writer->close();
+        std::cerr << "Columnar output: rows=" << columnar_writer->rows()
+                  << " row_groups=" << columnar_writer->row_groups()
+                  << " bytes=" << columnar_writer->bytes_written() << "\n";
+    }
+    
+    if (depth_history) {
+        depth_history->close();
+        std::cerr << "Depth history: " << config.depth_history_file << " rows=" << depth_history->rows()
+                  << " row_groups=" << depth_history->row_groups()
+                  << " bytes=" << depth_history->bytes_written() << "\n";
+    }
+    
+    if (analytics_publisher) {
+        analytics_publisher->flush();
+        std::cerr << "Analytics: " << config.analytics_file << " rows=" << analytics_publisher->published() << "\n";
+    }
+    
+    if (trade_publisher) {
+        trade_publisher->flush();
+        std::cerr << "Trades: " << config.trades_file << " trades=" << trade_publisher->published() << "\n";
+    }
+    
+    if (bar_publisher) {
+        // Bars still open at the end of the feed are written as they stand
+        for (size_t slot = 0; slot < bar_aggregators.size(); ++slot) {
+            for (book::BarAggregator& aggregator : bar_aggregators[slot]) {
+                book::Bar bar;
+                if (aggregator.finish(bar)) {
+                    bar_publisher->publish(quotes.symbol(slot), bar);
+                }
+            }
+        }
+        bar_publisher->flush();
+        std::cerr << "Bars: " << config.bars_file << " bars=" << bar_publisher->published() << "\n";
+    }
+    
+    if (shm_publisher) {
+        std::cerr << "Shared memory: " << config.shm_name << " records=" << shm_publisher->published() << "\n";
+    }
+    
+    if (udp_publisher) {
+        udp_publisher->flush();
+        std::cerr << "UDP: " << config.udp_endpoint << " session=" << udp_publisher->session()
+                  << " records=" << udp_publisher->published()
+                  << " datagrams=" << udp_publisher->datagrams()
+                  << " sendmmsg_calls=" << udp_publisher->send_calls() << "\n";
+    }
+    
+    if (!book_arenas.empty()) {
+        std::cerr << "Arena Stats (per book):\n";
+        for (const auto& [sym, arena] : book_arenas) {
+            const auto& stats = arena->stats();
+            std::cerr << "  " << sym.to_string()
+                      << ": allocations=" << stats.allocations
+                      << " frees=" << stats.deallocations
+                      << " peak_bytes=" << stats.peak_bytes_in_use
+                      << " overflow_bytes=" << stats.upstream_bytes << "\n";
+        }
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    // Install signal handler
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+    
+    try {
+        Config config = parse_args(argc, argv);
         
-        uint64_t end_time_us = core::Clock::now_us();
-        uint64_t total_time_us = end_time_us - start_time_us;
-        
-        // Print final statistics
-        double throughput = static_cast<double>(total_messages) / (static_cast<double>(total_time_us) / 1e6);
-        
-        std::cerr << "\nFinal Statistics:\n";
-        std::cerr << "Total messages processed: " << total_messages << "\n";
-        std::cerr << "Total time: " << (total_time_us / 1000.0) << " ms\n";
-        std::cerr << "Throughput: " << static_cast<uint64_t>(throughput) << " msgs/s\n";
-        
-        latency_stats.report();
-        
+        const bool direct = config.order_index == "direct";
+        if (config.order_record == "packed" && direct) {
+            run<book::DensePackedOrderBook>(config);
+        } else if (config.order_record == "packed") {
+            run<book::PackedOrderBook>(config);
+        } else if (direct) {
+            run<book::DenseOrderBook>(config);
+        } else {
+            run<book::OrderBook>(config);
+        }
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
         return 1;
@@ -0,0 +1,35 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "analytics_publisher.hpp"
+#include <cstdio>
+
+namespace publish {
+
+AnalyticsPublisher::AnalyticsPublisher(std::ostream& output) : output_(output) {
+}
+
+void AnalyticsPublisher::publish(uint64_t timestamp_us, const feed::Symbol& symbol,
+                                 const book::BookAnalytics& analytics) {
+    if (published_ == 0) {
+        output_ << "ts_us,symbol,microprice,imbalance,bid_depth,ask_depth,bid_band_depth,ask_band_depth\n";
+    }
+    char microprice[32] = "";
+    if (analytics.microprice != 0.0) {
+        std::snprintf(microprice, sizeof(microprice), "%.9f", analytics.microprice / 1e9);
+    }
+    char imbalance[32];
+    std::snprintf(imbalance, sizeof(imbalance), "%.6f", analytics.imbalance);
+    output_ << timestamp_us << "," << symbol.to_string() << "," << microprice << "," << imbalance << ","
+            << analytics.bid_depth << "," << analytics.ask_depth << "," << analytics.bid_band_depth << ","
+            << analytics.ask_band_depth << "\n";
+    published_++;
+}
+
+void AnalyticsPublisher::flush() {
+    output_.flush();
+}
+
+} // namespace publish
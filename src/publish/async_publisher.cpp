@@ -0,0 +1,81 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "async_publisher.hpp"
+#include <chrono>
+#include <utility>
+
+namespace publish {
+
+namespace {
+
+// Empty polls before the publisher thread starts sleeping between polls
+constexpr int IDLE_SPINS = 64;
+constexpr auto IDLE_SLEEP = std::chrono::microseconds(100);
+
+} // anonymous namespace
+
+AsyncPublisher::AsyncPublisher(Sink sink, size_t capacity, size_t max_batch)
+    : sink_(std::move(sink)), max_batch_(max_batch), ring_(capacity) {
+    thread_ = std::thread([this]() { run(); });
+}
+
+AsyncPublisher::~AsyncPublisher() {
+    try {
+        stop();
+    } catch (const std::exception&) {
+        // A sink error only surfaces through an explicit stop()
+    }
+}
+
+void AsyncPublisher::stop() {
+    if (thread_.joinable()) {
+        stopping_.store(true, std::memory_order_release);
+        thread_.join();
+    }
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+void AsyncPublisher::run() {
+    int idle = 0;
+    while (true) {
+        // Read the flag first: everything queued before stop() is drained
+        const bool stopping = stopping_.load(std::memory_order_acquire);
+        if (drain() > 0) {
+            idle = 0;
+            continue;
+        }
+        if (stopping) {
+            return;
+        }
+        if (++idle < IDLE_SPINS) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(IDLE_SLEEP);
+        }
+    }
+}
+
+size_t AsyncPublisher::drain() {
+    std::span<BinaryTobRecord> batch = ring_.peek_batch(max_batch_);
+    if (batch.empty()) {
+        return 0;
+    }
+    if (!error_) {
+        try {
+            sink_(batch);
+            published_.store(published_.load(std::memory_order_relaxed) + batch.size(), std::memory_order_relaxed);
+            batches_.store(batches_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+    }
+    ring_.release(batch.size());
+    return batch.size();
+}
+
+} // namespace publish
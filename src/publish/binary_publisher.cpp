@@ -0,0 +1,152 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "binary_publisher.hpp"
+#include "publish_io.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace publish {
+
+using detail::SYMBOL_NAME_SIZE;
+using detail::io_error;
+
+TobRecord to_tob_record(const BinaryTobRecord& record, const feed::Symbol& symbol) noexcept {
+    TobRecord out;
+    out.ts_us = record.ts_us;
+    out.bid_px = record.bid_px;
+    out.ask_px = record.ask_px;
+    out.bid_sz = record.bid_sz;
+    out.ask_sz = record.ask_sz;
+    detail::write_symbol_name(symbol, out.symbol);
+    return out;
+}
+
+BinaryTopOfBookPublisher::BinaryTopOfBookPublisher(const std::string& path, const std::vector<feed::Symbol>& symbols,
+                                                   size_t buffer_bytes)
+    : capacity_(std::max(buffer_bytes, sizeof(BinaryTobRecord))) {
+    if (symbols.size() > (UINT32_MAX - sizeof(BinaryTobHeader)) / SYMBOL_NAME_SIZE) {
+        throw std::invalid_argument("Too many symbols for a top-of-book file: " + std::to_string(symbols.size()));
+    }
+    if (path == "-") {
+        fd_ = STDOUT_FILENO;
+    } else {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            throw io_error("Cannot create " + path);
+        }
+        owns_fd_ = true;
+    }
+    // The count can only be patched in if the header lands at offset 0
+    patch_count_ = ::lseek(fd_, 0, SEEK_CUR) == 0 && (::fcntl(fd_, F_GETFL) & O_APPEND) == 0;
+    
+    BinaryTobHeader header{};
+    std::memcpy(header.magic, BINARY_TOB_MAGIC, sizeof(header.magic));
+    header.version = BINARY_TOB_VERSION;
+    header.header_size = static_cast<uint32_t>(sizeof(BinaryTobHeader) + symbols.size() * SYMBOL_NAME_SIZE);
+    header.record_size = sizeof(BinaryTobRecord);
+    header.symbol_count = static_cast<uint32_t>(symbols.size());
+    
+    // The header and symbol table go out with the first buffer
+    capacity_ = std::max(capacity_, static_cast<size_t>(header.header_size));
+    buffer_ = std::make_unique<char[]>(capacity_);
+    std::memcpy(buffer_.get(), &header, sizeof(header));
+    used_ = sizeof(header);
+    for (const feed::Symbol& symbol : symbols) {
+        char name[SYMBOL_NAME_SIZE];
+        detail::write_symbol_name(symbol, name);
+        std::memcpy(buffer_.get() + used_, name, sizeof(name));
+        used_ += sizeof(name);
+    }
+}
+
+BinaryTopOfBookPublisher::~BinaryTopOfBookPublisher() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // Write errors are only reported by an explicit close()
+    }
+}
+
+void BinaryTopOfBookPublisher::flush() {
+    write_all(buffer_.get(), used_);
+    used_ = 0;
+}
+
+void BinaryTopOfBookPublisher::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    const int fd = fd_;
+    flush();
+    fd_ = -1;
+    
+    // Seekable output: fill in the final count; pipes keep 0 (read to EOF)
+    const uint64_t count = records_;
+    if (patch_count_ && ::pwrite(fd, &count, sizeof(count), offsetof(BinaryTobHeader, record_count)) < 0) {
+        if (owns_fd_) {
+            ::close(fd);
+        }
+        throw io_error("Cannot finish top-of-book file");
+    }
+    if (owns_fd_ && ::close(fd) != 0) {
+        throw io_error("Cannot close top-of-book file");
+    }
+}
+
+void BinaryTopOfBookPublisher::write_all(const char* data, size_t size) {
+    while (size > 0) {
+        const ssize_t written = ::write(fd_, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw io_error("Cannot write top-of-book records");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+BinaryTobReader::BinaryTobReader(std::istream& input) : input_(input) {
+    if (!input_.read(reinterpret_cast<char*>(&header_), sizeof(header_)) ||
+        std::memcmp(header_.magic, BINARY_TOB_MAGIC, sizeof(header_.magic)) != 0) {
+        throw std::runtime_error("Not a binary top-of-book file");
+    }
+    if (header_.version != BINARY_TOB_VERSION) {
+        throw std::runtime_error("Unsupported binary top-of-book version " + std::to_string(header_.version));
+    }
+    if (header_.record_size != sizeof(BinaryTobRecord) ||
+        header_.header_size < sizeof(BinaryTobHeader) + uint64_t{header_.symbol_count} * SYMBOL_NAME_SIZE) {
+        throw std::runtime_error("Corrupt binary top-of-book header");
+    }
+    
+    for (uint32_t i = 0; i < header_.symbol_count; ++i) {
+        char name[SYMBOL_NAME_SIZE];
+        if (!input_.read(name, SYMBOL_NAME_SIZE)) {
+            throw std::runtime_error("Truncated binary top-of-book symbol table");
+        }
+        symbols_.push_back(detail::read_symbol_name(name));
+    }
+    input_.ignore(header_.header_size - sizeof(BinaryTobHeader) - header_.symbol_count * SYMBOL_NAME_SIZE);
+}
+
+bool BinaryTobReader::next(BinaryTobRecord& record) {
+    if (header_.record_count != 0 && read_ == header_.record_count) {
+        return false;
+    }
+    if (!input_.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        return false;
+    }
+    read_++;
+    return true;
+}
+
+} // namespace publish
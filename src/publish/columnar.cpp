@@ -0,0 +1,292 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "columnar.hpp"
+#include "publish_io.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace publish {
+
+using detail::SYMBOL_NAME_SIZE;
+using detail::io_error;
+
+std::vector<ColumnSpec> columnar_tob_columns() {
+    return {
+        {"ts_us", ColumnEncoding::DELTA_VARINT},
+        {"symbol_id", ColumnEncoding::VARINT},
+        {"bid_px", ColumnEncoding::DELTA_VARINT},
+        {"bid_sz", ColumnEncoding::VARINT},
+        {"ask_px", ColumnEncoding::DELTA_VARINT},
+        {"ask_sz", ColumnEncoding::VARINT},
+    };
+}
+
+std::vector<ColumnSpec> columnar_depth_columns() {
+    return {
+        {"ts_us", ColumnEncoding::DELTA_VARINT},
+        {"symbol_id", ColumnEncoding::VARINT},
+        {"side", ColumnEncoding::VARINT},
+        {"level", ColumnEncoding::VARINT},
+        {"price", ColumnEncoding::DELTA_VARINT},
+        {"quantity", ColumnEncoding::VARINT},
+    };
+}
+
+ColumnarWriter::ColumnarWriter(const std::string& path, std::vector<ColumnSpec> columns,
+                               const std::vector<feed::Symbol>& symbols, size_t rows_per_group)
+    : columns_(std::move(columns)), symbols_(symbols), rows_per_group_(std::max<size_t>(rows_per_group, 1)) {
+    if (columns_.empty()) {
+        throw std::invalid_argument("Columnar schema has no columns");
+    }
+    for (const ColumnSpec& column : columns_) {
+        if (column.name.empty() || column.name.size() >= sizeof(ColumnarColumnInfo::name)) {
+            throw std::invalid_argument("Bad column name '" + column.name + "'");
+        }
+    }
+    buffers_.resize(columns_.size());
+    for (std::vector<int64_t>& buffer : buffers_) {
+        buffer.reserve(rows_per_group_);
+    }
+    
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        throw io_error("Cannot create " + path);
+    }
+    ColumnarFileHeader header{};
+    std::memcpy(header.magic, COLUMNAR_MAGIC, sizeof(header.magic));
+    header.version = COLUMNAR_VERSION;
+    write_all(&header, sizeof(header));
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // Left without a trailer, which ColumnarReader rejects; close() says why
+    }
+}
+
+void ColumnarWriter::write_group() {
+    const size_t rows = buffers_[0].size();
+    if (rows == 0) {
+        return;
+    }
+    for (size_t column = 0; column < columns_.size(); ++column) {
+        std::vector<int64_t>& values = buffers_[column];
+        encoded_.clear();
+        int64_t previous = 0;
+        int64_t min = std::numeric_limits<int64_t>::max();
+        int64_t max = std::numeric_limits<int64_t>::min();
+        const bool delta = columns_[column].encoding == ColumnEncoding::DELTA_VARINT;
+        for (const int64_t value : values) {
+            min = std::min(min, value);
+            max = std::max(max, value);
+            // Wrapping subtraction: any int64 delta round-trips
+            const int64_t encoded = delta ? static_cast<int64_t>(static_cast<uint64_t>(value) -
+                                                                 static_cast<uint64_t>(previous))
+                                          : value;
+            put_varint(encoded_, zigzag_encode(encoded));
+            previous = value;
+        }
+        
+        ColumnarChunkInfo info;
+        info.offset = offset_;
+        info.size = encoded_.size();
+        info.min = min;
+        info.max = max;
+        write_all(encoded_.data(), encoded_.size());
+        chunks_.push_back(info);
+        values.clear();
+    }
+    group_rows_.push_back(rows);
+    rows_written_ += rows;
+}
+
+void ColumnarWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    write_group();
+    
+    const uint64_t footer_offset = offset_;
+    ColumnarFooter footer;
+    footer.column_count = static_cast<uint32_t>(columns_.size());
+    footer.symbol_count = static_cast<uint32_t>(symbols_.size());
+    footer.row_group_count = group_rows_.size();
+    footer.row_count = rows_written_;
+    write_all(&footer, sizeof(footer));
+    for (const ColumnSpec& column : columns_) {
+        ColumnarColumnInfo info{};
+        std::memcpy(info.name, column.name.data(), column.name.size());
+        info.encoding = static_cast<uint8_t>(column.encoding);
+        write_all(&info, sizeof(info));
+    }
+    for (const feed::Symbol& symbol : symbols_) {
+        char name[SYMBOL_NAME_SIZE];
+        detail::write_symbol_name(symbol, name);
+        write_all(name, sizeof(name));
+    }
+    for (size_t group = 0; group < group_rows_.size(); ++group) {
+        write_all(&group_rows_[group], sizeof(uint64_t));
+        write_all(&chunks_[group * columns_.size()], columns_.size() * sizeof(ColumnarChunkInfo));
+    }
+    ColumnarTrailer trailer;
+    trailer.footer_offset = footer_offset;
+    std::memcpy(trailer.magic, COLUMNAR_MAGIC, sizeof(trailer.magic));
+    write_all(&trailer, sizeof(trailer));
+    
+    const int fd = fd_;
+    fd_ = -1;
+    if (::close(fd) != 0) {
+        throw io_error("Cannot close columnar file");
+    }
+}
+
+void ColumnarWriter::write_all(const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(fd_, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw io_error("Cannot write columnar file");
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+        offset_ += static_cast<uint64_t>(written);
+    }
+}
+
+ColumnarReader::ColumnarReader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw io_error("Cannot open " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw io_error("Cannot stat " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ < sizeof(ColumnarFileHeader) + sizeof(ColumnarFooter) + sizeof(ColumnarTrailer)) {
+        ::close(fd);
+        throw std::runtime_error("Not a columnar file: " + path);
+    }
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw io_error("Cannot map " + path);
+    }
+    data_ = static_cast<const uint8_t*>(mapped);
+    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+    
+    try {
+        ColumnarFileHeader header;
+        ColumnarTrailer trailer;
+        std::memcpy(&header, data_, sizeof(header));
+        std::memcpy(&trailer, data_ + size_ - sizeof(trailer), sizeof(trailer));
+        if (std::memcmp(header.magic, COLUMNAR_MAGIC, sizeof(header.magic)) != 0 ||
+            std::memcmp(trailer.magic, COLUMNAR_MAGIC, sizeof(trailer.magic)) != 0) {
+            throw std::runtime_error("Not a columnar file (or not closed): " + path);
+        }
+        if (header.version != COLUMNAR_VERSION) {
+            throw std::runtime_error("Unsupported columnar version " + std::to_string(header.version));
+        }
+        
+        const size_t footer_end = size_ - sizeof(trailer);
+        size_t at = trailer.footer_offset;
+        auto take = [&](void* out, size_t bytes) {
+            if (at > footer_end || footer_end - at < bytes) {
+                throw std::runtime_error("Corrupt columnar footer in " + path);
+            }
+            std::memcpy(out, data_ + at, bytes);
+            at += bytes;
+        };
+        ColumnarFooter footer;
+        take(&footer, sizeof(footer));
+        for (uint32_t i = 0; i < footer.column_count; ++i) {
+            ColumnarColumnInfo info;
+            take(&info, sizeof(info));
+            columns_.push_back({std::string(info.name, strnlen(info.name, sizeof(info.name))),
+                                static_cast<ColumnEncoding>(info.encoding)});
+        }
+        for (uint32_t i = 0; i < footer.symbol_count; ++i) {
+            char name[SYMBOL_NAME_SIZE];
+            take(name, SYMBOL_NAME_SIZE);
+            symbols_.push_back(detail::read_symbol_name(name));
+        }
+        // Every row group needs its row count and a chunk per column: check
+        // the counts fit in the footer before sizing anything from them
+        const uint64_t group_bytes = sizeof(uint64_t) + uint64_t{footer.column_count} * sizeof(ColumnarChunkInfo);
+        if (footer.row_group_count > (footer_end - at) / group_bytes) {
+            throw std::runtime_error("Corrupt columnar footer in " + path);
+        }
+        chunks_.resize(footer.row_group_count * footer.column_count);
+        for (uint64_t group = 0; group < footer.row_group_count; ++group) {
+            uint64_t rows;
+            take(&rows, sizeof(rows));
+            group_rows_.push_back(rows);
+            take(&chunks_[group * footer.column_count], footer.column_count * sizeof(ColumnarChunkInfo));
+        }
+        for (const ColumnarChunkInfo& info : chunks_) {
+            if (info.offset > trailer.footer_offset || trailer.footer_offset - info.offset < info.size) {
+                throw std::runtime_error("Corrupt columnar chunk index in " + path);
+            }
+        }
+        row_count_ = footer.row_count;
+    } catch (...) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+        throw;
+    }
+}
+
+ColumnarReader::~ColumnarReader() {
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+size_t ColumnarReader::column_index(const std::string& name) const {
+    for (size_t column = 0; column < columns_.size(); ++column) {
+        if (columns_[column].name == name) {
+            return column;
+        }
+    }
+    throw std::out_of_range("No column named " + name);
+}
+
+void ColumnarReader::read_column(size_t group, size_t column, std::vector<int64_t>& out) const {
+    const std::span<const uint8_t> bytes = chunk_bytes(group, column);
+    const uint64_t rows = group_rows_[group];
+    const bool delta = columns_[column].encoding == ColumnEncoding::DELTA_VARINT;
+    out.resize(rows);
+    
+    const uint8_t* at = bytes.data();
+    const uint8_t* end = at + bytes.size();
+    uint64_t previous = 0;
+    for (uint64_t row = 0; row < rows; ++row) {
+        uint64_t raw;
+        at = get_varint(at, end, raw);
+        if (at == nullptr) {
+            throw std::runtime_error("Corrupt columnar chunk " + std::to_string(group) + "/" + columns_[column].name);
+        }
+        const int64_t value = zigzag_decode(raw);
+        if (delta) {
+            previous += static_cast<uint64_t>(value);
+            out[row] = static_cast<int64_t>(previous);
+        } else {
+            out[row] = value;
+        }
+    }
+}
+
+} // namespace publish
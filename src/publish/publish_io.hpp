@@ -0,0 +1,49 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#pragma once
+
+// Helpers shared by the file and socket publishers; not part of the public API
+
+#include "messages.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace publish::detail {
+
+/**
+ * @brief Bytes per symbol in a file's symbol table (NUL padded name)
+ */
+constexpr size_t SYMBOL_NAME_SIZE = 8;
+
+/**
+ * @brief runtime_error for a failed system call, with errno's description
+ */
+inline std::runtime_error io_error(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+/**
+ * @brief Encode a symbol as a symbol table entry
+ */
+inline void write_symbol_name(const feed::Symbol& symbol, char (&name)[SYMBOL_NAME_SIZE]) {
+    std::memset(name, 0, sizeof(name));
+    const std::string text = symbol.to_string();
+    std::memcpy(name, text.data(), std::min(text.size(), sizeof(name)));
+}
+
+/**
+ * @brief Decode a symbol table entry
+ */
+inline feed::Symbol read_symbol_name(const char (&name)[SYMBOL_NAME_SIZE]) {
+    feed::Symbol symbol;
+    std::memcpy(symbol.data, name, std::min(strnlen(name, sizeof(name)), sizeof(symbol.data)));
+    return symbol;
+}
+
+} // namespace publish::detail
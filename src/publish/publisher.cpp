@@ -4,12 +4,26 @@
  */
 
 #include "publisher.hpp"
+#include "publish_io.hpp"
 #include <sstream>
+#include <algorithm>
+#include <cstring>
 
 namespace publish {
 
-TopOfBookPublisher::TopOfBookPublisher(std::ostream& output) 
-    : output_(output), header_printed_(false) {
+TobRecord make_tob_record(uint64_t timestamp_us, const feed::Symbol& symbol, const book::TopOfBook& tob) {
+    TobRecord record{};
+    record.ts_us = timestamp_us;
+    record.bid_px = tob.best_bid_px;
+    record.ask_px = tob.best_ask_px;
+    record.bid_sz = tob.bid_sz;
+    record.ask_sz = tob.ask_sz;
+    detail::write_symbol_name(symbol, record.symbol);
+    return record;
+}
+
+TopOfBookPublisher::TopOfBookPublisher(std::ostream& output, bool flush_each_row)
+    : output_(output), header_printed_(false), flush_each_row_(flush_each_row) {
 }
 
 void TopOfBookPublisher::publish(uint64_t timestamp_us, const feed::Symbol& symbol, const book::TopOfBook& tob) {
@@ -36,13 +50,19 @@ void TopOfBookPublisher::publish(uint64_t timestamp_us, const feed::Symbol& symb
     }
     
     output_ << "\n";
-    output_.flush();
+    if (flush_each_row_) {
+        output_.flush();
+    }
 }
 
 void TopOfBookPublisher::print_header() {
     output_ << "ts_us,symbol,bid_px,bid_sz,ask_px,ask_sz\n";
 }
 
+void TopOfBookPublisher::flush() {
+    output_.flush();
+}
+
 std::string TopOfBookPublisher::format_price(int64_t price_nano) const {
     // Convert nano-units to decimal representation
     // Assuming 9 decimal places for nano precision
@@ -0,0 +1,18 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "shm_publisher.hpp"
+
+namespace publish {
+
+ShmTopOfBookPublisher::ShmTopOfBookPublisher(const std::string& name, size_t capacity)
+    : ring_(name, capacity) {
+}
+
+void ShmTopOfBookPublisher::publish(uint64_t timestamp_us, const feed::Symbol& symbol, const book::TopOfBook& tob) {
+    ring_.publish(make_tob_record(timestamp_us, symbol, tob));
+}
+
+} // namespace publish
@@ -0,0 +1,62 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "trade_publisher.hpp"
+#include <cinttypes>
+#include <cstdio>
+
+namespace publish {
+
+namespace {
+
+// Same 9-decimal rendering as TopOfBookPublisher, without a stringstream per field
+int format_price(char* out, size_t size, double price_nano) {
+    return std::snprintf(out, size, "%.9f", price_nano / 1e9);
+}
+
+} // anonymous namespace
+
+TradePublisher::TradePublisher(std::ostream& output) : output_(output) {
+}
+
+void TradePublisher::publish(const feed::Symbol& symbol, const book::Trade& trade) {
+    if (published_ == 0) {
+        output_ << "ts_us,symbol,order_id,side,price,quantity\n";
+    }
+    char price[32];
+    format_price(price, sizeof(price), static_cast<double>(trade.price));
+    output_ << trade.ts_us << "," << symbol.to_string() << "," << trade.order_id << ","
+            << (trade.resting_side == book::Side::BUY ? 'B' : 'S') << "," << price << "," << trade.quantity << "\n";
+    published_++;
+}
+
+void TradePublisher::flush() {
+    output_.flush();
+}
+
+BarPublisher::BarPublisher(std::ostream& output) : output_(output) {
+}
+
+void BarPublisher::publish(const feed::Symbol& symbol, const book::Bar& bar) {
+    if (published_ == 0) {
+        output_ << "start_us,interval_us,symbol,open,high,low,close,volume,trades,vwap\n";
+    }
+    char prices[5][32];
+    format_price(prices[0], sizeof(prices[0]), static_cast<double>(bar.open));
+    format_price(prices[1], sizeof(prices[1]), static_cast<double>(bar.high));
+    format_price(prices[2], sizeof(prices[2]), static_cast<double>(bar.low));
+    format_price(prices[3], sizeof(prices[3]), static_cast<double>(bar.close));
+    format_price(prices[4], sizeof(prices[4]), bar.vwap());
+    output_ << bar.start_us << "," << bar.interval_us << "," << symbol.to_string() << "," << prices[0] << ","
+            << prices[1] << "," << prices[2] << "," << prices[3] << "," << bar.volume << "," << bar.trades << ","
+            << prices[4] << "\n";
+    published_++;
+}
+
+void BarPublisher::flush() {
+    output_.flush();
+}
+
+} // namespace publish
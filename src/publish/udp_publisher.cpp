@@ -0,0 +1,251 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "udp_publisher.hpp"
+#include "publish_io.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace publish {
+
+using detail::io_error;
+
+namespace {
+
+in_addr parse_address(const std::string& address) {
+    in_addr parsed{};
+    if (::inet_pton(AF_INET, address.c_str(), &parsed) != 1) {
+        throw std::runtime_error("Invalid IPv4 address: " + address);
+    }
+    return parsed;
+}
+
+// Point each message at its own buffer slot
+void wire_messages(std::vector<char>& buffers, std::vector<iovec>& iov, std::vector<mmsghdr>& messages,
+                   size_t count) {
+    buffers.assign(count * UDP_TOB_MAX_DATAGRAM, 0);
+    iov.assign(count, iovec{});
+    messages.assign(count, mmsghdr{});
+    for (size_t i = 0; i < count; ++i) {
+        iov[i].iov_base = &buffers[i * UDP_TOB_MAX_DATAGRAM];
+        iov[i].iov_len = UDP_TOB_MAX_DATAGRAM;
+        messages[i].msg_hdr.msg_iov = &iov[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+}
+
+} // anonymous namespace
+
+size_t encode_udp_datagram(const UdpTobHeader& header, std::span<const TobRecord> records, char* out) noexcept {
+    UdpTobHeader written = header;
+    written.record_count = static_cast<uint16_t>(records.size());
+    std::memcpy(out, &written, sizeof(written));
+    std::memcpy(out + sizeof(written), records.data(), records.size_bytes());
+    return sizeof(written) + records.size_bytes();
+}
+
+bool decode_udp_datagram(std::span<const char> datagram, UdpTobHeader& header, std::vector<TobRecord>& records) {
+    if (datagram.size() < sizeof(UdpTobHeader)) {
+        return false;
+    }
+    std::memcpy(&header, datagram.data(), sizeof(header));
+    if (std::memcmp(header.magic, UDP_TOB_MAGIC, sizeof(header.magic)) != 0 || header.version != UDP_TOB_VERSION ||
+        datagram.size() != sizeof(UdpTobHeader) + header.record_count * sizeof(TobRecord)) {
+        return false;
+    }
+    const size_t first = records.size();
+    records.resize(first + header.record_count);
+    std::memcpy(&records[first], datagram.data() + sizeof(UdpTobHeader), header.record_count * sizeof(TobRecord));
+    return true;
+}
+
+void UdpSequenceTracker::on_datagram(const UdpTobHeader& header) noexcept {
+    datagrams_++;
+    if (sessions_ == 0 || header.session != session_) {
+        // First datagram, or the publisher restarted
+        session_ = header.session;
+        sessions_++;
+        expected_ = header.sequence + 1;
+        return;
+    }
+    if (header.sequence == expected_) {
+        expected_++;
+    } else if (header.sequence > expected_) {
+        gaps_++;
+        missing_ += header.sequence - expected_;
+        expected_ = header.sequence + 1;
+    } else {
+        late_++;
+    }
+}
+
+UdpTopOfBookPublisher::UdpTopOfBookPublisher(const std::string& group, uint16_t port, const std::string& interface,
+                                             size_t batch_datagrams, size_t records_per_datagram)
+    : batch_(std::max<size_t>(batch_datagrams, 1)),
+      records_per_datagram_(std::clamp<size_t>(records_per_datagram, 1, UDP_TOB_MAX_RECORDS)) {
+    const auto now = std::chrono::system_clock::now().time_since_epoch().count();
+    session_ = static_cast<uint32_t>(now ^ (now >> 32) ^ ::getpid());
+    
+    sockaddr_in destination{};
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(port);
+    destination.sin_addr = parse_address(group);
+    const in_addr source = parse_address(interface);
+    
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        throw io_error("Cannot create UDP socket");
+    }
+    const unsigned char ttl = 0;
+    const unsigned char loop = 1;
+    if (::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_IF, &source, sizeof(source)) < 0 ||
+        ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0 ||
+        ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) < 0 ||
+        ::connect(fd_, reinterpret_cast<const sockaddr*>(&destination), sizeof(destination)) < 0) {
+        const std::runtime_error error = io_error("Cannot set up multicast to " + group);
+        ::close(fd_);
+        throw error;
+    }
+    
+    wire_messages(buffers_, iov_, messages_, batch_);
+    current_.reserve(records_per_datagram_);
+}
+
+UdpTopOfBookPublisher::~UdpTopOfBookPublisher() {
+    try {
+        flush();
+    } catch (const std::exception&) {
+        // Best effort, like every datagram: the last batch is simply lost
+    }
+    ::close(fd_);
+}
+
+void UdpTopOfBookPublisher::publish(uint64_t timestamp_us, const feed::Symbol& symbol, const book::TopOfBook& tob) {
+    publish(make_tob_record(timestamp_us, symbol, tob));
+}
+
+void UdpTopOfBookPublisher::publish(const TobRecord& record) {
+    current_.push_back(record);
+    if (current_.size() == records_per_datagram_) {
+        seal();
+        if (queued_ == batch_) {
+            send();
+        }
+    }
+}
+
+void UdpTopOfBookPublisher::flush() {
+    if (!current_.empty()) {
+        seal();
+    }
+    send();
+}
+
+void UdpTopOfBookPublisher::seal() {
+    UdpTobHeader header{};
+    std::memcpy(header.magic, UDP_TOB_MAGIC, sizeof(header.magic));
+    header.version = UDP_TOB_VERSION;
+    header.session = session_;
+    header.sequence = next_sequence_++;
+    iov_[queued_].iov_len = encode_udp_datagram(header, current_, &buffers_[queued_ * UDP_TOB_MAX_DATAGRAM]);
+    records_queued_ += current_.size();
+    current_.clear();
+    queued_++;
+}
+
+void UdpTopOfBookPublisher::send() {
+    size_t sent = 0;
+    while (sent < queued_) {
+        const int result = ::sendmmsg(fd_, &messages_[sent], static_cast<unsigned int>(queued_ - sent), 0);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // The batch is lost either way; keep the sequence moving
+            queued_ = 0;
+            records_queued_ = 0;
+            throw io_error("sendmmsg failed");
+        }
+        send_calls_++;
+        sent += static_cast<size_t>(result);
+    }
+    records_sent_ += records_queued_;
+    records_queued_ = 0;
+    queued_ = 0;
+}
+
+UdpTobReceiver::UdpTobReceiver(const std::string& group, uint16_t port, const std::string& interface,
+                               size_t batch_datagrams) {
+    ip_mreq membership{};
+    membership.imr_multiaddr = parse_address(group);
+    membership.imr_interface = parse_address(interface);
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr = membership.imr_multiaddr;  // Only datagrams for this group
+    
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        throw io_error("Cannot create UDP socket");
+    }
+    const int reuse = 1;
+    const int receive_buffer = 4 << 20;
+    if (::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0 ||
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer)) < 0 ||
+        ::bind(fd_, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) < 0 ||
+        ::setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) < 0) {
+        const std::runtime_error error = io_error("Cannot join " + group);
+        ::close(fd_);
+        throw error;
+    }
+    
+    wire_messages(buffers_, iov_, messages_, std::max<size_t>(batch_datagrams, 1));
+}
+
+UdpTobReceiver::~UdpTobReceiver() {
+    ::close(fd_);
+}
+
+size_t UdpTobReceiver::receive(int timeout_ms) {
+    pollfd ready{fd_, POLLIN, 0};
+    const int polled = ::poll(&ready, 1, timeout_ms);
+    if (polled <= 0) {
+        if (polled < 0 && errno != EINTR) {
+            throw io_error("poll failed");
+        }
+        return 0;
+    }
+    const int received = ::recvmmsg(fd_, messages_.data(), static_cast<unsigned int>(messages_.size()),
+                                    MSG_DONTWAIT, nullptr);
+    if (received < 0) {
+        if (errno == EAGAIN || errno == EINTR) {
+            return 0;
+        }
+        throw io_error("recvmmsg failed");
+    }
+    return static_cast<size_t>(received);
+}
+
+std::pair<std::string, uint16_t> parse_udp_endpoint(const std::string& endpoint) {
+    const size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos || colon + 1 == endpoint.size() ||
+        endpoint.find_first_not_of("0123456789", colon + 1) != std::string::npos) {
+        throw std::invalid_argument("expected GROUP:PORT, got " + endpoint);
+    }
+    const unsigned long port = std::stoul(endpoint.substr(colon + 1));
+    if (port == 0 || port > 65535) {
+        throw std::invalid_argument("invalid port in " + endpoint);
+    }
+    return {endpoint.substr(0, colon), static_cast<uint16_t>(port)};
+}
+
+} // namespace publish
@@ -0,0 +1,75 @@
+# MIT License
+# Copyright (c) 2025 Market Feed Project
+#
+# Checkpoint at the feed's last message: market-feed must not hang, and the
+# checkpoint must record the end of the feed as its offset. Restoring it onto
+# a regenerated feed must be refused.
+#
+# Usage: cmake -DSIMGEN=... -DMARKET_FEED=... -DWORK_DIR=... -P checkpoint_last_message.cmake
+
+set(feed ${WORK_DIR}/checkpoint_last.bin)
+set(snapshot ${WORK_DIR}/checkpoint_last.snap)
+file(REMOVE ${feed} ${snapshot})
+
+execute_process(
+    COMMAND ${SIMGEN} --messages 1000 --symbols AAPL,MSFT --output ${feed} --threads 1
+    RESULT_VARIABLE result
+    OUTPUT_QUIET
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "simgen failed: ${result}")
+endif()
+
+execute_process(
+    COMMAND ${MARKET_FEED} --input ${feed} --symbols AAPL,MSFT --publish-top-of-book-us 0
+            --checkpoint ${snapshot} --checkpoint-at 1000
+    RESULT_VARIABLE result
+    OUTPUT_QUIET
+    ERROR_VARIABLE log
+    TIMEOUT 30
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "market-feed failed or hung: ${result}\n${log}")
+endif()
+
+file(SIZE ${feed} feed_size)
+if(NOT log MATCHES "Wrote checkpoint [^\n]* at offset ${feed_size}\n")
+    message(FATAL_ERROR "Expected a checkpoint at offset ${feed_size}:\n${log}")
+endif()
+
+# Warm start from the end of the feed replays nothing
+execute_process(
+    COMMAND ${MARKET_FEED} --input ${feed} --symbols AAPL,MSFT --publish-top-of-book-us 0
+            --restore ${snapshot}
+    RESULT_VARIABLE result
+    OUTPUT_QUIET
+    ERROR_VARIABLE log
+    TIMEOUT 30
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Restore failed: ${result}\n${log}")
+endif()
+if(NOT log MATCHES "Restored checkpoint [^\n]* at offset ${feed_size} \\(1000 messages\\)")
+    message(FATAL_ERROR "Unexpected restore position:\n${log}")
+endif()
+
+# Same size, different bytes: the checkpoint does not describe this feed
+execute_process(
+    COMMAND ${SIMGEN} --messages 1000 --symbols AAPL,MSFT --output ${feed} --threads 1 --seed 2
+    RESULT_VARIABLE result
+    OUTPUT_QUIET
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "simgen failed: ${result}")
+endif()
+execute_process(
+    COMMAND ${MARKET_FEED} --input ${feed} --symbols AAPL,MSFT --publish-top-of-book-us 0
+            --restore ${snapshot}
+    RESULT_VARIABLE result
+    OUTPUT_QUIET
+    ERROR_VARIABLE log
+    TIMEOUT 30
+)
+if(result EQUAL 0 OR NOT log MATCHES "different feed")
+    message(FATAL_ERROR "Restore onto another feed was not refused: ${result}\n${log}")
+endif()
@@ -0,0 +1,102 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "arena.hpp"
+#include "order_book.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+TEST(ArenaTest, CountsAllocations) {
+    core::ArenaResource arena(64 * 1024);
+    
+    void* a = arena.allocate(128, 8);
+    void* b = arena.allocate(256, 8);
+    EXPECT_EQ(arena.stats().allocations, 2);
+    EXPECT_EQ(arena.stats().bytes_in_use, 384);
+    EXPECT_EQ(arena.stats().peak_bytes_in_use, 384);
+    
+    arena.deallocate(a, 128, 8);
+    EXPECT_EQ(arena.stats().deallocations, 1);
+    EXPECT_EQ(arena.stats().bytes_in_use, 256);
+    EXPECT_EQ(arena.stats().peak_bytes_in_use, 384);
+    
+    arena.deallocate(b, 256, 8);
+    EXPECT_EQ(arena.stats().bytes_in_use, 0);
+}
+
+TEST(ArenaTest, ServesFromInitialBlock) {
+    core::ArenaResource arena(64 * 1024, core::ArenaResource::Kind::MONOTONIC);
+    
+    std::pmr::vector<int> values(&arena);
+    values.reserve(1000);
+    EXPECT_EQ(arena.stats().upstream_bytes, 0);
+    
+    std::pmr::vector<int> large(&arena);
+    large.reserve(64 * 1024);
+    EXPECT_GT(arena.stats().upstream_bytes, 0);
+}
+
+TEST(ArenaTest, ResetClearsStats) {
+    core::ArenaResource arena(4 * 1024);
+    {
+        std::pmr::vector<uint64_t> values(&arena);
+        for (uint64_t i = 0; i < 10000; ++i) {
+            values.push_back(i);
+        }
+    }
+    EXPECT_GT(arena.stats().peak_bytes_in_use, 0);
+    EXPECT_EQ(arena.stats().bytes_in_use, 0);
+    
+    arena.reset();
+    EXPECT_EQ(arena.stats().allocations, 0);
+    EXPECT_EQ(arena.stats().peak_bytes_in_use, 0);
+    EXPECT_EQ(arena.stats().upstream_bytes, 0);
+    
+    // Arena is usable again after reset
+    std::pmr::vector<uint64_t> values(&arena);
+    values.push_back(1);
+    EXPECT_EQ(arena.stats().allocations, 1);
+}
+
+TEST(ArenaTest, OrderBookAllocatesFromArena) {
+    core::ArenaResource arena(256 * 1024);
+    {
+        book::OrderBook order_book(&arena);
+        EXPECT_EQ(order_book.resource(), &arena);
+        
+        for (uint64_t i = 1; i <= 100; ++i) {
+            book::Side side = (i % 2 == 0) ? book::Side::BUY : book::Side::SELL;
+            int64_t price = (side == book::Side::BUY) ? 99000000000LL - static_cast<int64_t>(i) * 1000000LL
+                                                      : 101000000000LL + static_cast<int64_t>(i) * 1000000LL;
+            EXPECT_TRUE(order_book.on_add(i, side, price, 100));
+        }
+        EXPECT_GE(arena.stats().allocations, 200);  // one order node + one level node each
+        
+        for (uint64_t i = 1; i <= 100; ++i) {
+            EXPECT_TRUE(order_book.on_delete(i));
+        }
+        EXPECT_TRUE(order_book.empty());
+    }
+    
+    // Every node went back to the arena once the book was destroyed
+    EXPECT_EQ(arena.stats().bytes_in_use, 0);
+    arena.reset();
+}
+
+TEST(ArenaTest, PoolRecyclesFreedNodes) {
+    core::ArenaResource arena(64 * 1024);
+    book::OrderBook order_book(&arena);
+    
+    // Churn far more orders through the book than fit in the initial block at once
+    for (uint64_t i = 1; i <= 100000; ++i) {
+        EXPECT_TRUE(order_book.on_add(i, book::Side::BUY, 100000000000LL, 100));
+        EXPECT_TRUE(order_book.on_delete(i));
+    }
+    EXPECT_EQ(arena.stats().upstream_bytes, 0);
+}
+
+} // anonymous namespace
@@ -0,0 +1,65 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "async_publisher.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+publish::BinaryTobRecord make_record(uint64_t ts_us, uint32_t symbol_id) {
+    book::TopOfBook tob;
+    tob.best_bid_px = 100000000000LL + static_cast<int64_t>(ts_us);
+    tob.bid_sz = 100;
+    tob.best_ask_px = 100500000000LL;
+    tob.ask_sz = static_cast<uint32_t>(ts_us);
+    return publish::make_binary_tob_record(ts_us, symbol_id, tob);
+}
+
+TEST(AsyncPublisherTest, DeliversInOrder) {
+    std::vector<publish::BinaryTobRecord> received;
+    size_t largest_batch = 0;
+    // A small ring makes the book side wait for the publisher thread
+    publish::AsyncPublisher publisher([&](std::span<const publish::BinaryTobRecord> batch) {
+        received.insert(received.end(), batch.begin(), batch.end());
+        largest_batch = std::max(largest_batch, batch.size());
+    }, 16, 8);
+    
+    constexpr uint64_t COUNT = 10000;
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        publisher.publish(make_record(i, static_cast<uint32_t>(i % 3)));
+    }
+    publisher.stop();
+    
+    ASSERT_EQ(received.size(), COUNT);
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        EXPECT_EQ(received[i].ts_us, i);
+        EXPECT_EQ(received[i].symbol_id, i % 3);
+        EXPECT_EQ(publish::to_top_of_book(received[i]).ask_sz, i);
+    }
+    EXPECT_EQ(publisher.published(), COUNT);
+    EXPECT_LE(largest_batch, 8);
+    EXPECT_GE(publisher.batches(), COUNT / 8);
+}
+
+TEST(AsyncPublisherTest, StopRethrowsSinkError) {
+    size_t calls = 0;
+    publish::AsyncPublisher publisher([&](std::span<const publish::BinaryTobRecord>) {
+        ++calls;
+        throw std::runtime_error("disk full");
+    }, 16, 4);
+    
+    // The book side keeps going after the sink fails
+    for (uint64_t i = 0; i < 100; ++i) {
+        publisher.publish(make_record(i, 0));
+    }
+    EXPECT_THROW(publisher.stop(), std::runtime_error);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(publisher.published(), 0);
+    EXPECT_NO_THROW(publisher.stop());
+}
+
+} // namespace
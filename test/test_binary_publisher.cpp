@@ -0,0 +1,149 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "binary_publisher.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+
+class BinaryPublisherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        temp_filename = "test_tob_XXXXXX";
+        int fd = mkstemp(&temp_filename[0]);
+        ASSERT_NE(fd, -1);
+        close(fd);
+    }
+    
+    void TearDown() override {
+        std::remove(temp_filename.c_str());
+    }
+    
+    std::string temp_filename;
+};
+
+book::TopOfBook make_tob(int64_t bid_px, uint32_t bid_sz, int64_t ask_px, uint32_t ask_sz) {
+    book::TopOfBook tob;
+    tob.best_bid_px = bid_px;
+    tob.bid_sz = bid_sz;
+    tob.best_ask_px = ask_px;
+    tob.ask_sz = ask_sz;
+    return tob;
+}
+
+TEST_F(BinaryPublisherTest, RoundTrip) {
+    {
+        // A tiny buffer forces several flushes
+        publish::BinaryTopOfBookPublisher publisher(temp_filename, {feed::Symbol("AAPL"), feed::Symbol("MSFT")}, 64);
+        publisher.publish(1000, 0, make_tob(100000000000LL, 100, 100500000000LL, 200));
+        publisher.publish(1001, 1, make_tob(0, 0, 250000000000LL, 50));
+        publisher.publish(1002, 0, book::TopOfBook{});
+        EXPECT_EQ(publisher.published(), 3);
+    }
+    
+    std::ifstream file(temp_filename, std::ios::binary);
+    publish::BinaryTobReader reader(file);
+    ASSERT_EQ(reader.symbols().size(), 2);
+    EXPECT_EQ(reader.symbols()[0], feed::Symbol("AAPL"));
+    EXPECT_EQ(reader.symbols()[1].to_string(), "MSFT");
+    EXPECT_EQ(reader.record_count(), 3);
+    
+    publish::BinaryTobRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.ts_us, 1000);
+    EXPECT_EQ(record.symbol_id, 0);
+    EXPECT_EQ(record.bid_px, 100000000000LL);
+    EXPECT_EQ(record.bid_sz, 100);
+    EXPECT_EQ(record.ask_px, 100500000000LL);
+    EXPECT_EQ(record.ask_sz, 200);
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.symbol_id, 1);
+    EXPECT_EQ(record.bid_sz, 0);
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.ts_us, 1002);
+    EXPECT_FALSE(reader.next(record));
+    
+    // Fixed-size records after a 24-byte header and two 8-byte names
+    file.clear();
+    file.seekg(0, std::ios::end);
+    EXPECT_EQ(static_cast<size_t>(file.tellg()), sizeof(publish::BinaryTobHeader) + 16 + 3 * sizeof(publish::BinaryTobRecord));
+}
+
+TEST_F(BinaryPublisherTest, UnknownCountReadsToEnd) {
+    {
+        publish::BinaryTopOfBookPublisher publisher(temp_filename, {feed::Symbol("AAPL")});
+        publisher.publish(1, 0, make_tob(1, 1, 2, 1));
+        publisher.publish(2, 0, make_tob(1, 2, 2, 1));
+    }
+    std::ifstream file(temp_filename, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    
+    // As written to a pipe: no count, plus a truncated final record
+    const uint64_t unknown = 0;
+    std::memcpy(&bytes[offsetof(publish::BinaryTobHeader, record_count)], &unknown, sizeof(unknown));
+    bytes.resize(bytes.size() - 4);
+    std::istringstream stream(bytes);
+    publish::BinaryTobReader reader(stream);
+    EXPECT_EQ(reader.record_count(), 0);
+    
+    publish::BinaryTobRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.ts_us, 1);
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(BinaryPublisherTest, LargeSymbolTable) {
+    // Far more symbols than a 16-bit header size can describe
+    std::vector<feed::Symbol> symbols;
+    for (int i = 0; i < 10000; ++i) {
+        char name[8];
+        std::snprintf(name, sizeof(name), "S%d", i);
+        symbols.push_back(feed::Symbol(name));
+    }
+    {
+        publish::BinaryTopOfBookPublisher publisher(temp_filename, symbols);
+        publisher.publish(1000, 9999, make_tob(100000000000LL, 100, 100500000000LL, 200));
+        publisher.publish(1001, 0, make_tob(0, 0, 250000000000LL, 50));
+    }
+    
+    std::ifstream file(temp_filename, std::ios::binary);
+    publish::BinaryTobReader reader(file);
+    ASSERT_EQ(reader.symbols().size(), symbols.size());
+    EXPECT_EQ(reader.symbols()[9999].to_string(), "S9999");
+    EXPECT_EQ(reader.record_count(), 2);
+    
+    publish::BinaryTobRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.ts_us, 1000);
+    EXPECT_EQ(record.symbol_id, 9999);
+    EXPECT_EQ(record.ask_sz, 200);
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.symbol_id, 0);
+    EXPECT_EQ(record.ask_px, 250000000000LL);
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(BinaryPublisherTest, RejectsForeignFile) {
+    std::istringstream csv("ts_us,symbol,bid_px,bid_sz,ask_px,ask_sz\n1,AAPL,1,1,2,1\n");
+    EXPECT_THROW(publish::BinaryTobReader reader(csv), std::runtime_error);
+    EXPECT_THROW(publish::BinaryTopOfBookPublisher("/nonexistent/dir/out.bin", {}), std::runtime_error);
+}
+
+TEST(BinaryTobRecordTest, ConvertsToSharedRecord) {
+    const book::TopOfBook tob = make_tob(100000000000LL, 100, 100500000000LL, 200);
+    const publish::TobRecord expected = publish::make_tob_record(1000, feed::Symbol("MSFT"), tob);
+    const publish::TobRecord record =
+        publish::to_tob_record(publish::make_binary_tob_record(1000, 3, tob), feed::Symbol("MSFT"));
+    EXPECT_EQ(std::memcmp(&record, &expected, sizeof(record)), 0);
+    EXPECT_STREQ(record.symbol, "MSFT");
+}
+
+} // anonymous namespace
@@ -0,0 +1,162 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "broadcast_ring.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+namespace {
+
+TEST(BroadcastRingTest, EveryConsumerSeesEveryElement) {
+    core::BroadcastRing<int> ring(4);
+    const auto first = ring.add_consumer();
+    const auto second = ring.add_consumer();
+    
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(4));  // every slot is usable, then full
+    
+    for (auto consumer : {first, second}) {
+        std::span<const int> items = ring.peek_batch(consumer, 16);
+        ASSERT_EQ(items.size(), 4);
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_EQ(items[i], i);
+        }
+    }
+    
+    // The producer gates on the slowest consumer
+    ring.release(first, 4);
+    EXPECT_FALSE(ring.try_push(4));
+    ring.release(second, 1);
+    EXPECT_TRUE(ring.try_push(4));
+    EXPECT_FALSE(ring.try_push(5));
+    EXPECT_EQ(ring.sequence(first), 4);
+    EXPECT_EQ(ring.sequence(second), 1);
+}
+
+TEST(BroadcastRingTest, DependentConsumerWaitsForBarrier) {
+    core::BroadcastRing<int> ring(8);
+    const auto book = ring.add_consumer();
+    const auto publisher = ring.add_consumer({book});
+    
+    ring.try_push(1);
+    ring.try_push(2);
+    EXPECT_TRUE(ring.peek_batch(publisher, 8).empty());
+    
+    ASSERT_EQ(ring.peek_batch(book, 8).size(), 2);
+    ring.release(book, 1);
+    std::span<const int> items = ring.peek_batch(publisher, 8);
+    ASSERT_EQ(items.size(), 1);
+    EXPECT_EQ(items[0], 1);
+    
+    // Only the last stage of a chain gates the producer
+    ring.release(book, 1);
+    ring.release(publisher, 1);
+    int pushed = 0;
+    while (ring.try_push(pushed)) {
+        pushed++;
+    }
+    EXPECT_EQ(pushed, 7);
+}
+
+TEST(BroadcastRingTest, BatchesStopAtWrap) {
+    core::BroadcastRing<int> ring(8);
+    const auto consumer = ring.add_consumer();
+    
+    std::span<int> slots = ring.claim_batch(6);
+    ASSERT_EQ(slots.size(), 6);
+    for (int i = 0; i < 6; ++i) {
+        slots[i] = i;
+    }
+    ring.commit(6);
+    ring.release(consumer, ring.peek_batch(consumer, 6).size());
+    
+    // 8 free slots, but only 2 before the end of the array
+    slots = ring.claim_batch(8);
+    ASSERT_EQ(slots.size(), 2);
+    slots[0] = 6;
+    slots[1] = 7;
+    ring.commit(2);
+    slots = ring.claim_batch(8);
+    ASSERT_EQ(slots.size(), 6);
+    slots[0] = 8;
+    ring.commit(1);
+    
+    std::span<const int> items = ring.peek_batch(consumer, 8);
+    ASSERT_EQ(items.size(), 2);
+    EXPECT_EQ(items[1], 7);
+    ring.release(consumer, 2);
+    items = ring.peek_batch(consumer, 8);
+    ASSERT_EQ(items.size(), 1);
+    EXPECT_EQ(items[0], 8);
+}
+
+TEST(BroadcastRingTest, PipelineAcrossThreads) {
+    constexpr uint64_t ITEMS = 100000;
+    core::BroadcastRing<uint64_t> ring(256);
+    const auto book = ring.add_consumer();
+    const auto audit = ring.add_consumer();
+    const auto publisher = ring.add_consumer({book});
+    
+    // The book stage marks what it has applied; the publisher must never see
+    // an element the book stage has not finished
+    std::vector<uint8_t> applied(ITEMS, 0);
+    std::vector<uint64_t> sums(3, 0);
+    std::atomic<bool> ordered{true};
+    
+    auto run_consumer = [&](core::BroadcastRing<uint64_t>::ConsumerId id, auto&& on_item) {
+        uint64_t expected = 0;
+        while (expected < ITEMS) {
+            std::span<const uint64_t> items = ring.peek_batch(id, 32);
+            for (uint64_t value : items) {
+                if (value != expected++) {
+                    ordered = false;
+                }
+                on_item(value);
+                sums[id] += value;
+            }
+            ring.release(id, items.size());
+            if (items.empty()) {
+                std::this_thread::yield();
+            }
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    threads.emplace_back([&]() { run_consumer(book, [&](uint64_t v) { applied[v] = 1; }); });
+    threads.emplace_back([&]() { run_consumer(audit, [](uint64_t) {}); });
+    threads.emplace_back([&]() {
+        run_consumer(publisher, [&](uint64_t v) {
+            if (applied[v] != 1) {
+                ordered = false;
+            }
+        });
+    });
+    
+    for (uint64_t produced = 0; produced < ITEMS;) {
+        std::span<uint64_t> slots = ring.claim_batch(16);
+        for (auto& slot : slots) {
+            slot = produced++;
+        }
+        ring.commit(slots.size());
+        if (slots.empty()) {
+            std::this_thread::yield();
+        }
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_TRUE(ordered.load());
+    for (uint64_t sum : sums) {
+        EXPECT_EQ(sum, ITEMS * (ITEMS - 1) / 2);
+    }
+}
+
+} // anonymous namespace
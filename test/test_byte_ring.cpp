@@ -0,0 +1,167 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "byte_ring.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+std::string as_string(std::span<const char> bytes) {
+    return std::string(bytes.data(), bytes.size());
+}
+
+TEST(ByteRingTest, VariableLengthMessages) {
+    core::ByteRing ring(64);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_TRUE(ring.peek().empty());
+    
+    EXPECT_TRUE(ring.try_push("abc", 3));
+    EXPECT_TRUE(ring.try_push("hello world", 11));
+    EXPECT_EQ(ring.used_bytes(), core::ByteRing::frame_size(3) + core::ByteRing::frame_size(11));
+    
+    EXPECT_EQ(as_string(ring.peek()), "abc");
+    EXPECT_EQ(as_string(ring.peek()), "abc");  // peek does not consume
+    ring.release();
+    EXPECT_EQ(as_string(ring.peek()), "hello world");
+    ring.release();
+    EXPECT_TRUE(ring.peek().empty());
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(ByteRingTest, ClaimManyCommitOnce) {
+    core::ByteRing ring(64);
+    char* first = ring.try_claim(2);
+    ASSERT_NE(first, nullptr);
+    std::memcpy(first, "hi", 2);
+    char* second = ring.try_claim(3);
+    ASSERT_NE(second, nullptr);
+    std::memcpy(second, "you", 3);
+    
+    // Nothing is visible until commit
+    EXPECT_TRUE(ring.peek().empty());
+    ring.commit();
+    EXPECT_EQ(as_string(ring.peek()), "hi");
+    ring.release();
+    EXPECT_EQ(as_string(ring.peek()), "you");
+}
+
+TEST(ByteRingTest, FullAndWrap) {
+    core::ByteRing ring(64);
+    const std::string twenty(20, 'a');  // 24-byte frames
+    
+    EXPECT_TRUE(ring.try_push(twenty.data(), twenty.size()));
+    EXPECT_TRUE(ring.try_push(twenty.data(), twenty.size()));
+    EXPECT_FALSE(ring.try_push(twenty.data(), twenty.size()));  // 16 bytes left
+    EXPECT_TRUE(ring.try_push("0123456789", 10));               // 16-byte frame fits exactly
+    EXPECT_FALSE(ring.try_push("x", 1));
+    
+    ring.peek();
+    ring.release();
+    
+    // The next frame starts at offset 0 again
+    const std::string wrapped(20, 'b');
+    EXPECT_TRUE(ring.try_push(wrapped.data(), wrapped.size()));
+    
+    EXPECT_EQ(as_string(ring.peek()), twenty);
+    ring.release();
+    EXPECT_EQ(as_string(ring.peek()), "0123456789");
+    ring.release();
+    EXPECT_EQ(as_string(ring.peek()), wrapped);
+    ring.release();
+    EXPECT_TRUE(ring.empty());
+    
+    // A frame that does not fit before the end leaves a wrap marker behind
+    core::ByteRing small(32);
+    EXPECT_TRUE(small.try_push("1234", 4));            // frame at 0..8
+    EXPECT_TRUE(small.try_push("123456789012", 12));   // frame at 8..24
+    small.peek();
+    small.release();
+    small.peek();
+    small.release();
+    EXPECT_TRUE(small.try_push("abcdef", 6));          // 12-byte frame, 8 bytes before the end
+    EXPECT_EQ(small.used_bytes(), 8 + 12);
+    EXPECT_EQ(as_string(small.peek()), "abcdef");
+    small.release();
+    EXPECT_TRUE(small.empty());
+}
+
+TEST(ByteRingTest, TelemetryCounters) {
+    core::ByteRing ring(32);
+    EXPECT_TRUE(ring.peek().empty());
+    
+    EXPECT_TRUE(ring.try_push("12345678", 8));   // 12-byte frames
+    EXPECT_TRUE(ring.try_push("12345678", 8));
+    EXPECT_FALSE(ring.try_push("12345678", 8));
+    ring.peek();
+    ring.release();
+    
+    core::RingStats stats = ring.stats();
+    EXPECT_EQ(stats.pushes, 2);
+    EXPECT_EQ(stats.pops, 1);
+    EXPECT_EQ(stats.full_spins, 1);
+    EXPECT_EQ(stats.empty_spins, 1);
+    EXPECT_EQ(stats.high_water, 24);
+}
+
+TEST(ByteRingTest, HighWaterInLockstep) {
+    core::ByteRing ring(4096);
+    const char message[28] = {};  // 32-byte frames: wraps leave no padding
+    
+    // One frame in flight at a time, wrapping the ring many times
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(ring.try_push(message, sizeof(message)));
+        ASSERT_EQ(ring.peek().size(), sizeof(message));
+        ring.release();
+    }
+    EXPECT_EQ(ring.stats().high_water, core::ByteRing::frame_size(sizeof(message)));
+}
+
+TEST(ByteRingTest, ProducerConsumerThreads) {
+    constexpr uint32_t NUM_MESSAGES = 100000;
+    core::ByteRing ring(1024);
+    
+    // Message i is i % 40 + 1 bytes of (char)i
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < NUM_MESSAGES;) {
+            const size_t length = i % 40 + 1;
+            char* slot = ring.try_claim(length);
+            if (slot == nullptr) {
+                ring.commit();
+                std::this_thread::yield();
+                continue;
+            }
+            std::memset(slot, static_cast<char>(i), length);
+            if (++i % 8 == 0) {
+                ring.commit();
+            }
+        }
+        ring.commit();
+    });
+    
+    bool intact = true;
+    for (uint32_t i = 0; i < NUM_MESSAGES;) {
+        std::span<const char> message = ring.peek();
+        if (message.empty()) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (message.size() != i % 40 + 1 ||
+            std::any_of(message.begin(), message.end(), [i](char c) { return c != static_cast<char>(i); })) {
+            intact = false;
+        }
+        ring.release();
+        i++;
+    }
+    producer.join();
+    
+    EXPECT_TRUE(intact);
+    EXPECT_TRUE(ring.empty());
+}
+
+} // anonymous namespace
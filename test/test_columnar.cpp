@@ -0,0 +1,141 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "columnar.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+class ColumnarTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        temp_filename = "test_columnar_XXXXXX";
+        int fd = mkstemp(&temp_filename[0]);
+        ASSERT_NE(fd, -1);
+        close(fd);
+    }
+    
+    void TearDown() override {
+        std::remove(temp_filename.c_str());
+    }
+    
+    std::string temp_filename;
+};
+
+TEST(ColumnarEncodingTest, VarintRoundTrip) {
+    const std::vector<int64_t> values = {0, 1, -1, 63, -64, 64, 1 << 20, -(1LL << 40),
+                                         std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()};
+    std::vector<uint8_t> encoded;
+    for (const int64_t value : values) {
+        publish::put_varint(encoded, publish::zigzag_encode(value));
+    }
+    // Small magnitudes of either sign take one byte
+    EXPECT_EQ(encoded[0], 0);
+    EXPECT_EQ(encoded[1], 2);
+    EXPECT_EQ(encoded[2], 1);
+    
+    const uint8_t* at = encoded.data();
+    const uint8_t* end = at + encoded.size();
+    for (const int64_t value : values) {
+        uint64_t raw;
+        at = publish::get_varint(at, end, raw);
+        ASSERT_NE(at, nullptr);
+        EXPECT_EQ(publish::zigzag_decode(raw), value);
+    }
+    EXPECT_EQ(at, end);
+    
+    // Truncated varint
+    const uint8_t partial[] = {0x80, 0x80};
+    uint64_t raw;
+    EXPECT_EQ(publish::get_varint(partial, partial + sizeof(partial), raw), nullptr);
+}
+
+TEST_F(ColumnarTest, RoundTripAcrossRowGroups) {
+    const std::vector<feed::Symbol> symbols = {feed::Symbol("AAPL"), feed::Symbol("MSFT")};
+    constexpr int64_t ROWS = 1000;
+    {
+        // 128-row groups: 7 full groups and a partial one
+        publish::ColumnarWriter writer(temp_filename, publish::columnar_tob_columns(), symbols, 128);
+        for (int64_t i = 0; i < ROWS; ++i) {
+            const int64_t row[] = {5000000 + i * 3, i % 2, 100000000000LL - i * 10000000, i, 0, 0};
+            writer.append(row);
+        }
+        EXPECT_EQ(writer.rows(), ROWS);
+        writer.close();
+        EXPECT_EQ(writer.row_groups(), 8);
+    }
+    
+    publish::ColumnarReader reader(temp_filename);
+    EXPECT_EQ(reader.row_count(), ROWS);
+    ASSERT_EQ(reader.row_group_count(), 8);
+    EXPECT_EQ(reader.group_rows(7), ROWS - 7 * 128);
+    ASSERT_EQ(reader.columns().size(), 6);
+    EXPECT_EQ(reader.columns()[2].name, "bid_px");
+    EXPECT_EQ(reader.columns()[2].encoding, publish::ColumnEncoding::DELTA_VARINT);
+    ASSERT_EQ(reader.symbols().size(), 2);
+    EXPECT_EQ(reader.symbols()[1], feed::Symbol("MSFT"));
+    
+    const size_t ts = reader.column_index("ts_us");
+    const size_t bid_px = reader.column_index("bid_px");
+    EXPECT_THROW(reader.column_index("nope"), std::out_of_range);
+    
+    // Timestamps step by 3: one byte per row after the first
+    EXPECT_LE(reader.chunk(1, ts).size, 128 + 4);
+    EXPECT_EQ(reader.chunk(0, bid_px).max, 100000000000LL);
+    EXPECT_EQ(reader.chunk(0, bid_px).min, 100000000000LL - 127 * 10000000);
+    
+    std::vector<int64_t> values;
+    int64_t row = 0;
+    for (size_t group = 0; group < reader.row_group_count(); ++group) {
+        reader.read_column(group, bid_px, values);
+        ASSERT_EQ(values.size(), reader.group_rows(group));
+        for (const int64_t value : values) {
+            EXPECT_EQ(value, 100000000000LL - row * 10000000);
+            row++;
+        }
+    }
+    EXPECT_EQ(row, ROWS);
+}
+
+TEST_F(ColumnarTest, RejectsUnfinishedFile) {
+    {
+        std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+        file << "MFCOL this file was never closed properly";
+    }
+    EXPECT_THROW(publish::ColumnarReader reader(temp_filename), std::runtime_error);
+    EXPECT_THROW(publish::ColumnarWriter(temp_filename, {{"a_very_long_column_name", publish::ColumnEncoding::VARINT}}, {}),
+                 std::invalid_argument);
+}
+
+TEST_F(ColumnarTest, RejectsCorruptRowGroupCount) {
+    {
+        publish::ColumnarWriter writer(temp_filename, publish::columnar_tob_columns(), {feed::Symbol("AAPL")}, 4);
+        const int64_t row[] = {1, 0, 2, 3, 4, 5};
+        writer.append(row);
+        writer.close();
+    }
+    
+    std::fstream file(temp_filename, std::ios::binary | std::ios::in | std::ios::out);
+    publish::ColumnarTrailer trailer;
+    file.seekg(-static_cast<std::streamoff>(sizeof(trailer)), std::ios::end);
+    file.read(reinterpret_cast<char*>(&trailer), sizeof(trailer));
+    
+    // Counts far beyond what the footer holds, including ones whose product wraps
+    for (uint64_t count : {uint64_t{1} << 40, std::numeric_limits<uint64_t>::max()}) {
+        file.seekp(static_cast<std::streamoff>(trailer.footer_offset + offsetof(publish::ColumnarFooter, row_group_count)));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        file.flush();
+        EXPECT_THROW(publish::ColumnarReader reader(temp_filename), std::runtime_error);
+    }
+}
+
+} // namespace
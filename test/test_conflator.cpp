@@ -0,0 +1,319 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "conflator.hpp"
+#include "order_book.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+feed::Event make_add(uint64_t order_id, char side, int64_t px, uint32_t qty, uint64_t ts = 1) {
+    feed::Event event;
+    event.type = feed::EventType::ADD_ORDER;
+    event.payload.add = feed::AddOrderMsg{};
+    event.payload.add.ts_us = ts;
+    event.payload.add.order_id = order_id;
+    std::memcpy(event.payload.add.symbol, "AAPL  ", 6);
+    event.payload.add.side = side;
+    event.payload.add.px_nano = px;
+    event.payload.add.qty = qty;
+    return event;
+}
+
+feed::Event make_modify(uint64_t order_id, int64_t px, uint32_t qty, uint64_t ts = 1) {
+    feed::Event event;
+    event.type = feed::EventType::MODIFY_ORDER;
+    event.payload.modify = feed::ModifyOrderMsg{};
+    event.payload.modify.ts_us = ts;
+    event.payload.modify.order_id = order_id;
+    event.payload.modify.new_px_nano = px;
+    event.payload.modify.new_qty = qty;
+    return event;
+}
+
+feed::Event make_execute(uint64_t order_id, uint32_t qty, uint64_t ts = 1) {
+    feed::Event event;
+    event.type = feed::EventType::EXECUTE_ORDER;
+    event.payload.execute = feed::ExecuteOrderMsg{};
+    event.payload.execute.ts_us = ts;
+    event.payload.execute.order_id = order_id;
+    event.payload.execute.exec_qty = qty;
+    return event;
+}
+
+feed::Event make_delete(uint64_t order_id, uint64_t ts = 1) {
+    feed::Event event;
+    event.type = feed::EventType::DELETE_ORDER;
+    event.payload.delete_order = feed::DeleteOrderMsg{};
+    event.payload.delete_order.ts_us = ts;
+    event.payload.delete_order.order_id = order_id;
+    return event;
+}
+
+bool apply(book::OrderBook& book, const feed::Event& event) {
+    switch (event.type) {
+        case feed::EventType::ADD_ORDER: {
+            const auto& msg = event.payload.add;
+            return book.on_add(msg.order_id, msg.side == 'B' ? book::Side::BUY : book::Side::SELL, msg.px_nano,
+                               msg.qty);
+        }
+        case feed::EventType::MODIFY_ORDER:
+            return book.on_modify(event.payload.modify.order_id, event.payload.modify.new_px_nano,
+                                  event.payload.modify.new_qty);
+        case feed::EventType::EXECUTE_ORDER:
+            return book.on_execute(event.payload.execute.order_id, event.payload.execute.exec_qty);
+        case feed::EventType::DELETE_ORDER:
+            return book.on_delete(event.payload.delete_order.order_id);
+        default:
+            return false;
+    }
+}
+
+std::vector<feed::Event> drain_all(feed::EventConflator& conflator) {
+    std::vector<feed::Event> out;
+    std::vector<feed::Event> slots(16);
+    for (size_t n = conflator.drain(slots); n > 0; n = conflator.drain(slots)) {
+        out.insert(out.end(), slots.begin(), slots.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+    return out;
+}
+
+void expect_same_book(const book::OrderBook& direct, const book::OrderBook& conflated) {
+    EXPECT_EQ(conflated.order_count(), direct.order_count());
+    const book::TopOfBook a = direct.top_of_book();
+    const book::TopOfBook b = conflated.top_of_book();
+    EXPECT_EQ(b.best_bid_px, a.best_bid_px);
+    EXPECT_EQ(b.bid_sz, a.bid_sz);
+    EXPECT_EQ(b.best_ask_px, a.best_ask_px);
+    EXPECT_EQ(b.ask_sz, a.ask_sz);
+}
+
+// Apply resting events directly, then the burst both directly and conflated
+void expect_burst_matches(const std::vector<feed::Event>& resting, const std::vector<feed::Event>& burst) {
+    book::OrderBook direct;
+    book::OrderBook conflated;
+    feed::EventConflator conflator;
+    for (const feed::Event& event : resting) {
+        apply(direct, event);
+        apply(conflated, event);
+    }
+    for (const feed::Event& event : burst) {
+        apply(direct, event);
+        conflator.add(event);
+    }
+    for (const feed::Event& event : drain_all(conflator)) {
+        apply(conflated, event);
+    }
+    expect_same_book(direct, conflated);
+}
+
+} // anonymous namespace
+
+TEST(EventConflatorTest, ChangesCollapseBehindAdd) {
+    feed::EventConflator conflator;
+    conflator.add(make_add(1, 'B', 100, 50, 10));
+    conflator.add(make_modify(1, 99, 40, 11));
+    conflator.add(make_execute(1, 15, 12));
+    conflator.add(make_execute(1, 5, 13));
+    
+    std::vector<feed::Event> out = drain_all(conflator);
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[0].type, feed::EventType::ADD_ORDER);  // Verbatim, so a crossing ADD is still rejected
+    EXPECT_EQ(out[0].payload.add.px_nano, 100);
+    EXPECT_EQ(out[0].payload.add.qty, 50);
+    EXPECT_EQ(out[1].type, feed::EventType::MODIFY_ORDER);
+    EXPECT_EQ(out[1].payload.modify.new_px_nano, 99);
+    EXPECT_EQ(out[1].payload.modify.new_qty, 20);
+    EXPECT_EQ(out[1].payload.modify.ts_us, 13);
+    EXPECT_EQ(conflator.events_in(), 4);
+    EXPECT_EQ(conflator.events_out(), 2);
+    EXPECT_TRUE(conflator.empty());
+}
+
+TEST(EventConflatorTest, ShortLivedOrderCancelsOut) {
+    feed::EventConflator conflator;
+    conflator.add(make_add(1, 'S', 101, 10));
+    conflator.add(make_add(2, 'S', 102, 10));
+    conflator.add(make_modify(2, 103, 5));
+    conflator.add(make_delete(1));
+    conflator.add(make_delete(2));
+    
+    EXPECT_TRUE(conflator.empty());
+    EXPECT_TRUE(drain_all(conflator).empty());
+}
+
+TEST(EventConflatorTest, ExistingOrderKeepsLatestState) {
+    feed::EventConflator conflator;
+    conflator.add(make_execute(7, 5));
+    conflator.add(make_execute(7, 3));
+    conflator.add(make_execute(8, 2));
+    conflator.add(make_modify(8, 98, 30));
+    conflator.add(make_execute(8, 30));
+    
+    std::vector<feed::Event> out = drain_all(conflator);
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[0].type, feed::EventType::EXECUTE_ORDER);
+    EXPECT_EQ(out[0].payload.execute.exec_qty, 8);
+    EXPECT_EQ(out[1].type, feed::EventType::DELETE_ORDER);  // Modified, then fully executed
+    EXPECT_EQ(out[1].payload.delete_order.order_id, 8);
+}
+
+TEST(EventConflatorTest, DeleteThenReAddSurvivesPartialDrain) {
+    feed::EventConflator conflator;
+    conflator.add(make_delete(3));
+    conflator.add(make_add(3, 'B', 97, 20));
+    conflator.add(make_add(4, 'B', 96, 20));
+    
+    feed::Event slot;
+    ASSERT_EQ(conflator.drain(std::span<feed::Event>(&slot, 1)), 1);
+    EXPECT_EQ(slot.type, feed::EventType::DELETE_ORDER);
+    
+    std::vector<feed::Event> out = drain_all(conflator);
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[0].type, feed::EventType::ADD_ORDER);
+    EXPECT_EQ(out[0].payload.add.order_id, 3);
+    EXPECT_EQ(out[1].payload.add.order_id, 4);
+    EXPECT_EQ(conflator.events_out(), 3);
+}
+
+TEST(EventConflatorTest, ConflatedBookMatchesFullReplay) {
+    // Valid random flow: bids below 100, asks above 100, so nothing crosses
+    std::mt19937 rng(42);
+    std::vector<std::pair<uint64_t, feed::Event>> live;  // order id -> its ADD
+    std::unordered_map<uint64_t, uint32_t> remaining;
+    std::vector<feed::Event> events;
+    uint64_t next_id = 1;
+    
+    for (int i = 0; i < 20000; ++i) {
+        const int action = static_cast<int>(rng() % 4);
+        if (live.empty() || action == 0) {
+            const char side = rng() % 2 ? 'B' : 'S';
+            const int64_t px = side == 'B' ? 90 + rng() % 10 : 101 + rng() % 10;
+            events.push_back(make_add(next_id, side, px, 1 + rng() % 100));
+            live.emplace_back(next_id, events.back());
+            remaining[next_id] = events.back().payload.add.qty;
+            next_id++;
+            continue;
+        }
+        const size_t pick = rng() % live.size();
+        const uint64_t order_id = live[pick].first;
+        if (action == 1) {
+            const bool buy = live[pick].second.payload.add.side == 'B';
+            const uint32_t qty = 1 + rng() % 100;
+            events.push_back(make_modify(order_id, buy ? 90 + rng() % 10 : 101 + rng() % 10, qty));
+            remaining[order_id] = qty;
+            continue;
+        }
+        const uint32_t exec = action == 2 ? 1 + rng() % remaining[order_id] : remaining[order_id];
+        events.push_back(action == 2 ? make_execute(order_id, exec) : make_delete(order_id));
+        remaining[order_id] -= exec;
+        if (remaining[order_id] == 0) {
+            live.erase(live.begin() + static_cast<std::ptrdiff_t>(pick));
+        }
+    }
+    
+    // Apply the first half directly, conflate the rest in chunks as the handler would
+    book::OrderBook direct;
+    book::OrderBook conflated;
+    const size_t split = events.size() / 2;
+    for (size_t i = 0; i < events.size(); ++i) {
+        apply(direct, events[i]);
+    }
+    for (size_t i = 0; i < split; ++i) {
+        apply(conflated, events[i]);
+    }
+    feed::EventConflator conflator;
+    std::vector<feed::Event> slots(64);
+    for (size_t i = split; i < events.size(); ++i) {
+        conflator.add(events[i]);
+        if (i % 1000 == 0) {
+            for (size_t n = conflator.drain(slots); n > 0; n = conflator.drain(slots)) {
+                for (size_t j = 0; j < n; ++j) {
+                    apply(conflated, slots[j]);
+                }
+            }
+        }
+    }
+    for (const feed::Event& event : drain_all(conflator)) {
+        apply(conflated, event);
+    }
+    
+    EXPECT_LT(conflator.events_out(), conflator.events_in());
+    expect_same_book(direct, conflated);
+}
+
+TEST(EventConflatorTest, KeepsCrossOrderCausality) {
+    const std::vector<feed::Event> resting = {make_add(1, 'B', 100, 10), make_add(2, 'S', 101, 10)};
+    
+    // The ADD of id 2 at 99 only passes once bid 1 is gone
+    expect_burst_matches(resting, {make_delete(2), make_delete(1), make_add(2, 'S', 99, 5)});
+    // Same without id reuse
+    expect_burst_matches(resting, {make_execute(2, 1), make_delete(1), make_modify(2, 99, 5)});
+    // The ask may only move to 99 after the bid left 100; the bid changes again later
+    expect_burst_matches(resting, {make_modify(1, 98, 10), make_modify(2, 99, 10), make_modify(1, 98, 4)});
+    // Unknown sides: a later bid ADD at 101 must see the ask that is still there
+    expect_burst_matches(resting, {make_execute(2, 1), make_add(3, 'B', 101, 1), make_delete(2)});
+}
+
+TEST(EventConflatorTest, OverlappingRandomFlowMatchesFullReplay) {
+    // Bids and asks share one price range, so whether an event is accepted
+    // depends on the events of other orders before it. The flow keeps only
+    // events the book accepts, as a consistent feed would.
+    for (uint32_t seed = 1; seed <= 20; ++seed) {
+        std::mt19937 rng(seed);
+        book::OrderBook direct;
+        std::vector<feed::Event> events;
+        uint64_t next_id = 1;
+        while (events.size() < 3000) {
+            const uint64_t order_id = rng() % 3 == 0 ? next_id : 1 + rng() % next_id;
+            const int64_t px = 95 + static_cast<int64_t>(rng() % 11);
+            feed::Event event;
+            switch (rng() % 4) {
+                case 0: event = make_add(order_id, rng() % 2 ? 'B' : 'S', px, 1 + rng() % 50); break;
+                case 1: event = make_modify(order_id, px, 1 + rng() % 50); break;
+                case 2: event = make_execute(order_id, 1 + rng() % 30); break;
+                default: event = make_delete(order_id); break;
+            }
+            if (apply(direct, event)) {
+                events.push_back(event);
+                next_id += order_id == next_id;
+            }
+        }
+        
+        book::OrderBook conflated;
+        feed::EventConflator conflator;
+        std::vector<feed::Event> slots(8);
+        for (size_t i = 0; i < events.size(); ++i) {
+            conflator.add(events[i]);
+            if (i % 97 == 0) {
+                // Partial drains, as when the ring only has a little room
+                const size_t n = conflator.drain(slots);
+                for (size_t j = 0; j < n; ++j) {
+                    apply(conflated, slots[j]);
+                }
+            }
+        }
+        for (const feed::Event& event : drain_all(conflator)) {
+            apply(conflated, event);
+        }
+        SCOPED_TRACE(seed);
+        EXPECT_LT(conflator.events_out(), conflator.events_in());
+        expect_same_book(direct, conflated);
+        
+        // Same orders at the same prices and sizes, not just the same top
+        std::map<uint64_t, std::tuple<book::Side, int64_t, uint32_t>> a;
+        std::map<uint64_t, std::tuple<book::Side, int64_t, uint32_t>> b;
+        direct.for_each_order([&](uint64_t id, const book::OrderInfo& o) { a[id] = {o.side, o.price, o.quantity}; });
+        conflated.for_each_order([&](uint64_t id, const book::OrderInfo& o) { b[id] = {o.side, o.price, o.quantity}; });
+        EXPECT_EQ(a, b);
+    }
+}
@@ -233,6 +233,80 @@ TEST_F(DecoderTest, Reset) {
     EXPECT_EQ(event2.payload.add.order_id, 1);
 }
 
+TEST_F(DecoderTest, NextIntoDecodesInPlace) {
+    feed::AddOrderMsg add;
+    add.type = 'A';
+    add.ts_us = 1000;
+    add.order_id = 7;
+    std::memcpy(add.symbol, "MSFT  ", 6);
+    add.side = 'S';
+    add.px_nano = 250000000000LL;
+    add.qty = 30;
+    write_message(&add, sizeof(add));
+    
+    feed::DeleteOrderMsg del;
+    del.type = 'D';
+    del.ts_us = 2000;
+    del.order_id = 7;
+    write_message(&del, sizeof(del));
+    
+    feed::Decoder decoder(temp_filename);
+    feed::Event slot;
+    
+    EXPECT_TRUE(decoder.next_into(slot));
+    EXPECT_EQ(slot.type, feed::EventType::ADD_ORDER);
+    EXPECT_EQ(slot.payload.add.order_id, 7);
+    EXPECT_EQ(slot.payload.add.qty, 30);
+    EXPECT_GT(slot.decode_timestamp_us, 0);
+    
+    // The same storage is reused for the next message
+    EXPECT_TRUE(decoder.next_into(slot));
+    EXPECT_EQ(slot.type, feed::EventType::DELETE_ORDER);
+    EXPECT_EQ(slot.payload.delete_order.ts_us, 2000);
+    
+    EXPECT_FALSE(decoder.next_into(slot));
+    EXPECT_EQ(slot.type, feed::EventType::INVALID);
+}
+
+TEST_F(DecoderTest, RawMessagesDecodeLater) {
+    feed::ExecuteOrderMsg exec;
+    exec.type = 'E';
+    exec.ts_us = 3000;
+    exec.order_id = 9;
+    exec.exec_qty = 0;  // invalid, but still framed
+    write_message(&exec, sizeof(exec));
+    
+    const char junk = 'X';
+    write_message(&junk, 1);
+    
+    feed::ModifyOrderMsg modify;
+    modify.type = 'U';
+    modify.ts_us = 4000;
+    modify.order_id = 9;
+    modify.new_px_nano = 101000000000LL;
+    modify.new_qty = 50;
+    write_message(&modify, sizeof(modify));
+    write_message(&modify, 5);  // truncated tail
+    
+    feed::Decoder decoder(temp_filename);
+    feed::Event event;
+    
+    std::span<const char> raw = decoder.next_raw();
+    ASSERT_EQ(raw.size(), sizeof(exec));
+    EXPECT_FALSE(feed::Decoder::decode(raw, event));
+    
+    // Unknown bytes are skipped
+    raw = decoder.next_raw();
+    ASSERT_EQ(raw.size(), feed::Decoder::message_size('U'));
+    ASSERT_TRUE(feed::Decoder::decode(raw, event));
+    EXPECT_EQ(event.type, feed::EventType::MODIFY_ORDER);
+    EXPECT_EQ(event.payload.modify.new_qty, 50);
+    EXPECT_FALSE(feed::Decoder::decode(raw.subspan(1), event));
+    
+    EXPECT_TRUE(decoder.next_raw().empty());
+    EXPECT_FALSE(decoder.has_next());
+}
+
 TEST_F(DecoderTest, MoveSemantics) {
     feed::AddOrderMsg msg;
     msg.type = 'A';
@@ -0,0 +1,113 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "depth_snapshot.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+namespace {
+
+TEST(DepthPublisherTest, SnapshotOnlyWhenRequested) {
+    book::OrderBook book;
+    book.on_add(1, book::Side::BUY, 100, 10);
+    book.on_add(2, book::Side::BUY, 99, 20);
+    book.on_add(3, book::Side::BUY, 100, 5);
+    book.on_add(4, book::Side::SELL, 102, 7);
+    
+    book::DepthPublisher depth;
+    EXPECT_EQ(depth.snapshot(), nullptr);
+    EXPECT_FALSE(depth.publish_if_wanted(book, 1));
+    
+    const uint64_t ticket = depth.request();
+    EXPECT_TRUE(depth.wanted());
+    EXPECT_FALSE(depth.ready(ticket));
+    EXPECT_TRUE(depth.publish_if_wanted(book, 2));
+    EXPECT_FALSE(depth.wanted());
+    ASSERT_TRUE(depth.ready(ticket));
+    
+    std::shared_ptr<const book::DepthSnapshot> snapshot = depth.snapshot();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->version, 1);
+    EXPECT_EQ(snapshot->ts_us, 2);
+    ASSERT_EQ(snapshot->bids.size(), 2);
+    EXPECT_EQ(snapshot->bids[0].price, 100);
+    EXPECT_EQ(snapshot->bids[0].quantity, 15);
+    EXPECT_EQ(snapshot->bids[1].price, 99);
+    ASSERT_EQ(snapshot->asks.size(), 1);
+    EXPECT_EQ(snapshot->asks[0].quantity, 7);
+}
+
+TEST(DepthPublisherTest, HeldSnapshotOutlivesReplacement) {
+    book::OrderBook book;
+    book.on_add(1, book::Side::BUY, 100, 10);
+    book::DepthPublisher depth;
+    depth.publish(book, 1);
+    
+    std::shared_ptr<const book::DepthSnapshot> held = depth.snapshot();
+    std::weak_ptr<const book::DepthSnapshot> watch = held;
+    book.on_delete(1);
+    depth.publish(book, 2);
+    
+    // The old view is unchanged while held, and freed when released
+    EXPECT_EQ(held->bids.size(), 1);
+    EXPECT_TRUE(depth.snapshot()->bids.empty());
+    held.reset();
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST(DepthPublisherTest, MaxLevelsCapsEachSide) {
+    book::OrderBook book;
+    for (uint64_t i = 0; i < 10; ++i) {
+        book.on_add(i + 1, book::Side::BUY, 100 - static_cast<int64_t>(i), 1);
+        book.on_add(i + 101, book::Side::SELL, 200 + static_cast<int64_t>(i), 1);
+    }
+    book::DepthPublisher depth;
+    depth.publish(book, 1, 3);
+    EXPECT_EQ(depth.snapshot()->bids.size(), 3);
+    EXPECT_EQ(depth.snapshot()->asks.back().price, 202);
+}
+
+TEST(DepthPublisherTest, ReaderSeesConsistentViews) {
+    // Snapshots are taken between updates, and every update adds one level
+    // per side, so each view must have as many bids as asks
+    book::OrderBook book;
+    book::DepthPublisher depth;
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::atomic<int> served{0};
+    
+    std::thread reader([&]() {
+        while (!done.load(std::memory_order_acquire)) {
+            const uint64_t ticket = depth.request();
+            while (!depth.ready(ticket) && !done.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            if (auto snapshot = depth.snapshot()) {
+                if (snapshot->bids.size() != snapshot->asks.size()) {
+                    inconsistent++;
+                }
+                served++;
+            }
+        }
+    });
+    
+    uint64_t i = 0;
+    for (; served.load() < 100 && i < 1000000; ++i) {
+        book.on_add(2 * i + 1, book::Side::BUY, 1000 - static_cast<int64_t>(i % 500), 1);
+        book.on_add(2 * i + 2, book::Side::SELL, 2000 + static_cast<int64_t>(i % 500), 1);
+        depth.publish_if_wanted(book, i);
+        std::this_thread::yield();
+    }
+    // Serve any request still pending before stopping the reader
+    depth.publish(book, i);
+    done.store(true, std::memory_order_release);
+    reader.join();
+    
+    EXPECT_EQ(inconsistent.load(), 0);
+    EXPECT_GT(served.load(), 0);
+}
+
+} // anonymous namespace
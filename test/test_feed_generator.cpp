@@ -0,0 +1,166 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "feed_generator.hpp"
+#include "decoder.hpp"
+#include "order_book.hpp"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+
+class FeedGeneratorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (std::string& name : temp_filenames) {
+            name = "generator_test_XXXXXX";
+            int fd = mkstemp(&name[0]);
+            ASSERT_NE(fd, -1);
+            close(fd);
+        }
+    }
+    
+    void TearDown() override {
+        for (const std::string& name : temp_filenames) {
+            std::remove(name.c_str());
+        }
+    }
+    
+    static feed::SimConfig make_config(feed::SimProfile profile, size_t threads) {
+        feed::SimConfig config;
+        config.symbols = {"AAPL", "MSFT", "GOOG"};
+        config.seed = 7;
+        config.threads = threads;
+        config.profile = profile;
+        return config;
+    }
+    
+    static void generate(const std::string& path, const feed::SimConfig& config,
+                         std::initializer_list<uint64_t> batches) {
+        feed::FeedWriter output(path);
+        feed::FeedGenerator generator(config);
+        for (uint64_t batch : batches) {
+            generator.generate(output, batch);
+        }
+        output.close();
+    }
+    
+    static std::string read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    
+    std::string temp_filenames[2];
+};
+
+} // anonymous namespace
+
+TEST_F(FeedGeneratorTest, SameFileForAnyThreadCountAndBatching) {
+    for (feed::SimProfile profile : {feed::SimProfile::UNIFORM, feed::SimProfile::REALISTIC}) {
+        generate(temp_filenames[0], make_config(profile, 1), {200000});
+        generate(temp_filenames[1], make_config(profile, 3), {70000, 1, 129999});
+        const std::string single = read_file(temp_filenames[0]);
+        EXPECT_FALSE(single.empty());
+        EXPECT_EQ(single, read_file(temp_filenames[1]));
+    }
+}
+
+TEST_F(FeedGeneratorTest, RealisticProfileReplaysWithoutRejects) {
+    generate(temp_filenames[0], make_config(feed::SimProfile::REALISTIC, 2), {300000});
+    
+    feed::Decoder decoder(temp_filenames[0]);
+    std::map<std::string, book::OrderBook> books;
+    std::map<uint64_t, book::OrderBook*> owner;
+    std::map<std::string, uint64_t> activity;
+    uint64_t last_ts = 0;
+    uint64_t messages = 0;
+    uint64_t executions = 0;
+    
+    while (decoder.has_next()) {
+        feed::Event event = decoder.next();
+        ASSERT_NE(event.type, feed::EventType::INVALID);
+        messages++;
+        switch (event.type) {
+            case feed::EventType::ADD_ORDER: {
+                const auto& msg = event.payload.add;
+                ASSERT_GE(msg.ts_us, last_ts);
+                last_ts = msg.ts_us;
+                EXPECT_EQ(msg.px_nano % 10'000'000, 0);  // One-cent grid
+                const std::string symbol = feed::Symbol(msg.symbol).to_string();
+                book::OrderBook& book = books[symbol];
+                const book::Side side = msg.side == 'B' ? book::Side::BUY : book::Side::SELL;
+                ASSERT_TRUE(book.on_add(msg.order_id, side, msg.px_nano, msg.qty));
+                owner[msg.order_id] = &book;
+                activity[symbol]++;
+                break;
+            }
+            case feed::EventType::MODIFY_ORDER: {
+                const auto& msg = event.payload.modify;
+                ASSERT_GE(msg.ts_us, last_ts);
+                last_ts = msg.ts_us;
+                ASSERT_TRUE(owner.count(msg.order_id));
+                ASSERT_TRUE(owner[msg.order_id]->on_modify(msg.order_id, msg.new_px_nano, msg.new_qty));
+                break;
+            }
+            case feed::EventType::EXECUTE_ORDER: {
+                const auto& msg = event.payload.execute;
+                ASSERT_GE(msg.ts_us, last_ts);
+                last_ts = msg.ts_us;
+                ASSERT_TRUE(owner.count(msg.order_id));
+                book::OrderBook& book = *owner[msg.order_id];
+                const book::TopOfBook top = book.top_of_book();
+                book::OrderInfo resting;
+                ASSERT_TRUE(book.on_execute(msg.order_id, msg.exec_qty, resting));
+                // Executions always take the touch
+                EXPECT_EQ(resting.price, resting.side == book::Side::BUY ? top.best_bid_px : top.best_ask_px);
+                executions++;
+                break;
+            }
+            case feed::EventType::DELETE_ORDER: {
+                const auto& msg = event.payload.delete_order;
+                ASSERT_GE(msg.ts_us, last_ts);
+                last_ts = msg.ts_us;
+                ASSERT_TRUE(owner.count(msg.order_id));
+                ASSERT_TRUE(owner[msg.order_id]->on_delete(msg.order_id));
+                owner.erase(msg.order_id);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    
+    EXPECT_EQ(messages, 300000u);
+    EXPECT_GT(executions, 0u);
+    // Zipf: the first symbol is the busiest, then the second, then the third
+    ASSERT_EQ(activity.size(), 3u);
+    EXPECT_GT(activity["AAPL"], activity["MSFT"]);
+    EXPECT_GT(activity["MSFT"], activity["GOOG"]);
+    // Deep books with long queues
+    for (const auto& [symbol, book] : books) {
+        size_t levels = 0;
+        for (book::Side side : {book::Side::BUY, book::Side::SELL}) {
+            book.for_each_level(side, [&](int64_t, uint32_t) { return ++levels, true; });
+        }
+        EXPECT_GT(book.order_count(), 1000u) << symbol;
+        EXPECT_GT(book.order_count() / levels, 10u) << symbol;
+    }
+}
+
+TEST(FeedGeneratorConfigTest, ParsesProfilesAndRejectsEmptySymbols) {
+    feed::SimProfile profile = feed::SimProfile::UNIFORM;
+    EXPECT_TRUE(feed::parse_sim_profile("realistic", profile));
+    EXPECT_EQ(profile, feed::SimProfile::REALISTIC);
+    EXPECT_TRUE(feed::parse_sim_profile("uniform", profile));
+    EXPECT_EQ(profile, feed::SimProfile::UNIFORM);
+    EXPECT_FALSE(feed::parse_sim_profile("bursty", profile));
+    
+    EXPECT_THROW(feed::FeedGenerator(feed::SimConfig()), std::invalid_argument);
+}
@@ -0,0 +1,169 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "mpmc_queue.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <memory>
+
+namespace {
+
+TEST(MpmcQueueTest, BasicOperations) {
+    core::MpmcQueue<int> queue(4);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.capacity(), 4);
+    
+    // Every slot is usable
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.size(), 4);
+    
+    int value;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpmcQueueTest, MoveSemantics) {
+    core::MpscQueue<std::unique_ptr<int>> queue(2);
+    auto ptr = std::make_unique<int>(42);
+    EXPECT_TRUE(queue.try_push(std::move(ptr)));
+    EXPECT_EQ(ptr, nullptr);
+    
+    std::unique_ptr<int> popped;
+    EXPECT_TRUE(queue.try_pop(popped));
+    ASSERT_NE(popped, nullptr);
+    EXPECT_EQ(*popped, 42);
+}
+
+TEST(MpmcQueueTest, BatchPushStopsWhenFull) {
+    core::MpscQueue<int> queue(8);
+    const int items[] = {1, 2, 3, 4, 5, 6};
+    
+    EXPECT_EQ(queue.try_push_batch(items, 6), 6);
+    EXPECT_EQ(queue.try_push_batch(items, 6), 2);  // only two slots left
+    EXPECT_EQ(queue.try_push_batch(items, 6), 0);
+    
+    int out[16];
+    EXPECT_EQ(queue.try_pop_batch(out, 16), 8);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[5], 6);
+    EXPECT_EQ(out[6], 1);
+    EXPECT_EQ(out[7], 2);
+    EXPECT_EQ(queue.try_pop_batch(out, 16), 0);
+    
+    // Wraps around the end of the array
+    EXPECT_EQ(queue.try_push_batch(items, 5), 5);
+    EXPECT_EQ(queue.try_pop_batch(out, 3), 3);
+    EXPECT_EQ(queue.try_push_batch(items, 6), 6);
+    EXPECT_EQ(queue.try_pop_batch(out, 16), 8);
+    EXPECT_EQ(out[0], 4);
+    EXPECT_EQ(out[2], 1);
+    EXPECT_EQ(out[7], 6);
+}
+
+// Producers tag values with their id; each producer's values must arrive in order
+template<typename Queue>
+void run_producers(Queue& queue, size_t num_producers, size_t per_producer, size_t batch,
+                   std::vector<std::thread>& threads) {
+    for (size_t p = 0; p < num_producers; ++p) {
+        threads.emplace_back([&queue, p, per_producer, batch]() {
+            std::vector<uint64_t> items(batch);
+            size_t sent = 0;
+            while (sent < per_producer) {
+                const size_t n = std::min(batch, per_producer - sent);
+                for (size_t i = 0; i < n; ++i) {
+                    items[i] = (static_cast<uint64_t>(p) << 32) | (sent + i);
+                }
+                size_t pushed = batch == 1 ? (queue.try_push(items[0]) ? 1 : 0)
+                                           : queue.try_push_batch(items.data(), n);
+                sent += pushed;
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+}
+
+TEST(MpmcQueueTest, MultipleProducersSingleConsumer) {
+    constexpr size_t PRODUCERS = 4;
+    constexpr size_t PER_PRODUCER = 20000;
+    
+    for (size_t batch : {size_t{1}, size_t{16}}) {
+        core::MpscQueue<uint64_t> queue(256);
+        std::vector<std::thread> threads;
+        run_producers(queue, PRODUCERS, PER_PRODUCER, batch, threads);
+        
+        std::vector<uint64_t> next(PRODUCERS, 0);
+        size_t received = 0;
+        uint64_t out[32];
+        while (received < PRODUCERS * PER_PRODUCER) {
+            size_t n = queue.try_pop_batch(out, 32);
+            for (size_t i = 0; i < n; ++i) {
+                const size_t producer = static_cast<size_t>(out[i] >> 32);
+                ASSERT_LT(producer, PRODUCERS);
+                ASSERT_EQ(out[i] & 0xFFFFFFFFu, next[producer]);
+                next[producer]++;
+            }
+            received += n;
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+        
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(MpmcQueueTest, MultipleProducersMultipleConsumers) {
+    constexpr size_t PRODUCERS = 4;
+    constexpr size_t CONSUMERS = 3;
+    constexpr size_t PER_PRODUCER = 20000;
+    constexpr size_t TOTAL = PRODUCERS * PER_PRODUCER;
+    
+    core::MpmcQueue<uint64_t> queue(256);
+    std::vector<std::thread> threads;
+    run_producers(queue, PRODUCERS, PER_PRODUCER, 8, threads);
+    
+    // Each value must be delivered exactly once
+    std::vector<std::atomic<uint8_t>> seen(TOTAL);
+    std::atomic<size_t> received{0};
+    for (size_t c = 0; c < CONSUMERS; ++c) {
+        threads.emplace_back([&]() {
+            uint64_t value;
+            while (received.load() < TOTAL) {
+                if (queue.try_pop(value)) {
+                    const size_t index = static_cast<size_t>(value >> 32) * PER_PRODUCER + (value & 0xFFFFFFFFu);
+                    seen[index].fetch_add(1);
+                    received.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(received.load(), TOTAL);
+    for (size_t i = 0; i < TOTAL; ++i) {
+        ASSERT_EQ(seen[i].load(), 1) << "value " << i;
+    }
+}
+
+} // anonymous namespace
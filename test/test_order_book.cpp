@@ -5,6 +5,8 @@
 
 #include "order_book.hpp"
 #include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
 
 namespace {
 
@@ -114,6 +116,49 @@ TEST_F(OrderBookTest, ExecuteMoreThanAvailable) {
     EXPECT_EQ(tob.bid_sz, 100);
 }
 
+TEST_F(OrderBookTest, ExecuteReportsRestingOrder) {
+    EXPECT_TRUE(book->on_add(1, book::Side::SELL, 100250000000LL, 100));
+    EXPECT_TRUE(book->on_modify(1, 100500000000LL, 80));
+    
+    book::OrderInfo resting;
+    EXPECT_TRUE(book->on_execute(1, 30, resting));
+    EXPECT_EQ(resting.side, book::Side::SELL);
+    EXPECT_EQ(resting.price, 100500000000LL);
+    EXPECT_EQ(resting.quantity, 80u); // Before the fill
+    
+    // A rejected execute leaves resting alone
+    book::OrderInfo untouched(book::Side::BUY, 1, 2);
+    EXPECT_FALSE(book->on_execute(1, 51, untouched));
+    EXPECT_EQ(untouched.price, 1);
+    EXPECT_EQ(book->top_of_book().ask_sz, 50u);
+}
+
+TEST_F(OrderBookTest, Analytics) {
+    // Analytics off: depth reads 0, microprice still works
+    EXPECT_TRUE(book->on_add(1, book::Side::BUY, 100000000000LL, 300));
+    EXPECT_TRUE(book->on_add(2, book::Side::SELL, 100100000000LL, 100));
+    EXPECT_EQ(book->depth(book::Side::BUY), 0u);
+    EXPECT_DOUBLE_EQ(book->microprice(), (100.0 * 100 + 100.1 * 300) / 400 * 1e9);
+    
+    book->enable_analytics(2, 10);  // Two levels, band of 10 bps (10 cents at $100)
+    EXPECT_TRUE(book->on_add(3, book::Side::BUY, 99950000000LL, 100));
+    EXPECT_TRUE(book->on_add(4, book::Side::BUY, 99860000000LL, 50));   // Outside the band
+    EXPECT_TRUE(book->on_add(5, book::Side::SELL, 100300000000LL, 200));
+    
+    const book::BookAnalytics stats = book->analytics();
+    EXPECT_EQ(stats.bid_depth, 400u);
+    EXPECT_EQ(stats.ask_depth, 300u);
+    EXPECT_EQ(stats.bid_band_depth, 400u);
+    EXPECT_EQ(stats.ask_band_depth, 100u);
+    EXPECT_DOUBLE_EQ(stats.imbalance, 100.0 / 700.0);
+    EXPECT_DOUBLE_EQ(stats.microprice, book->microprice());
+    
+    // Deleting the best bid moves the band down to include order 4
+    EXPECT_TRUE(book->on_delete(1));
+    EXPECT_EQ(book->depth(book::Side::BUY), 150u);
+    EXPECT_EQ(book->band_depth(book::Side::BUY), 150u);
+}
+
 TEST_F(OrderBookTest, DeleteOrder) {
     // Add order
     EXPECT_TRUE(book->on_add(1, book::Side::BUY, 100000000000LL, 100));
@@ -201,3 +246,410 @@ TEST_F(OrderBookTest, CompleteLifecycle) {
 }
 
 } // anonymous namespace
+
+namespace {
+
+// Same behaviour is expected from every level-store / order-index combination
+template<typename Book>
+class OrderBookPolicyTest : public ::testing::Test {
+protected:
+    // One-cent grid so the flat ladder can index prices directly
+    Book book{book::PriceGrid{0, 10000000LL}};
+};
+
+using PolicyBooks = ::testing::Types<
+    book::BasicOrderBook<book::MapLevels, book::HashOrderIndex>,
+    book::BasicOrderBook<book::MapLevels, book::OpenAddressingOrderIndex>,
+    book::BasicOrderBook<book::MapLevels, book::DirectOrderIndex>,
+    book::BasicOrderBook<book::SortedVectorLevels, book::HashOrderIndex>,
+    book::BasicOrderBook<book::SortedVectorLevels, book::OpenAddressingOrderIndex>,
+    book::BasicOrderBook<book::SortedVectorLevels, book::DirectOrderIndex>,
+    book::BasicOrderBook<book::FlatLadderLevels, book::HashOrderIndex>,
+    book::BasicOrderBook<book::FlatLadderLevels, book::OpenAddressingOrderIndex>,
+    book::BasicOrderBook<book::FlatLadderLevels, book::DirectOrderIndex>,
+    book::BasicOrderBook<book::MapLevels, book::HashOrderIndex, book::PackedOrder>,
+    book::BasicOrderBook<book::SortedVectorLevels, book::OpenAddressingOrderIndex, book::PackedOrder>,
+    book::BasicOrderBook<book::FlatLadderLevels, book::DirectOrderIndex, book::PackedOrder>>;
+TYPED_TEST_SUITE(OrderBookPolicyTest, PolicyBooks);
+
+TYPED_TEST(OrderBookPolicyTest, BestPriceOrdering) {
+    auto& b = this->book;
+    EXPECT_TRUE(b.on_add(1, book::Side::BUY, 100000000000LL, 100));
+    EXPECT_TRUE(b.on_add(2, book::Side::BUY, 99000000000LL, 200));
+    EXPECT_TRUE(b.on_add(3, book::Side::BUY, 101000000000LL, 50));
+    EXPECT_TRUE(b.on_add(4, book::Side::SELL, 102000000000LL, 100));
+    EXPECT_TRUE(b.on_add(5, book::Side::SELL, 103000000000LL, 200));
+    EXPECT_TRUE(b.on_add(6, book::Side::SELL, 101500000000LL, 50));
+    
+    auto tob = b.top_of_book();
+    EXPECT_EQ(tob.best_bid_px, 101000000000LL);
+    EXPECT_EQ(tob.bid_sz, 50);
+    EXPECT_EQ(tob.best_ask_px, 101500000000LL);
+    EXPECT_EQ(tob.ask_sz, 50);
+    
+    // Removing the best levels exposes the next ones
+    EXPECT_TRUE(b.on_delete(3));
+    EXPECT_TRUE(b.on_delete(6));
+    tob = b.top_of_book();
+    EXPECT_EQ(tob.best_bid_px, 100000000000LL);
+    EXPECT_EQ(tob.best_ask_px, 102000000000LL);
+}
+
+TYPED_TEST(OrderBookPolicyTest, Lifecycle) {
+    auto& b = this->book;
+    EXPECT_TRUE(b.on_add(1, book::Side::BUY, 100000000000LL, 100));
+    EXPECT_TRUE(b.on_add(2, book::Side::BUY, 100000000000LL, 200));
+    EXPECT_FALSE(b.on_add(2, book::Side::BUY, 100000000000LL, 200));
+    EXPECT_FALSE(b.on_add(3, book::Side::SELL, 99000000000LL, 10));  // crosses
+    
+    EXPECT_TRUE(b.on_modify(1, 99500000000LL, 150));
+    EXPECT_TRUE(b.on_execute(2, 50));
+    auto tob = b.top_of_book();
+    EXPECT_EQ(tob.best_bid_px, 100000000000LL);
+    EXPECT_EQ(tob.bid_sz, 150);
+    
+    EXPECT_TRUE(b.on_execute(2, 150));
+    tob = b.top_of_book();
+    EXPECT_EQ(tob.best_bid_px, 99500000000LL);
+    EXPECT_EQ(tob.bid_sz, 150);
+    EXPECT_EQ(b.order_count(), 1);
+    
+    EXPECT_FALSE(b.on_execute(1, 151));
+    EXPECT_TRUE(b.on_delete(1));
+    EXPECT_FALSE(b.on_delete(1));
+    EXPECT_TRUE(b.empty());
+    EXPECT_FALSE(b.top_of_book().has_bid());
+}
+
+TYPED_TEST(OrderBookPolicyTest, ManyOrders) {
+    auto& b = this->book;
+    constexpr uint64_t NUM_ORDERS = 2000;
+    for (uint64_t i = 1; i <= NUM_ORDERS; ++i) {
+        const int64_t ticks = static_cast<int64_t>(i % 200);
+        if (i % 2 == 0) {
+            EXPECT_TRUE(b.on_add(i, book::Side::BUY, (9900 - ticks) * 10000000LL, 10));
+        } else {
+            EXPECT_TRUE(b.on_add(i, book::Side::SELL, (10100 + ticks) * 10000000LL, 10));
+        }
+    }
+    EXPECT_EQ(b.order_count(), NUM_ORDERS);
+    
+    size_t visited = 0;
+    b.for_each_order([&](uint64_t, const book::OrderInfo& info) {
+        EXPECT_EQ(info.price % 10000000LL, 0);
+        visited++;
+    });
+    EXPECT_EQ(visited, NUM_ORDERS);
+    
+    for (uint64_t i = 1; i <= NUM_ORDERS; i += 2) {
+        EXPECT_TRUE(b.on_delete(i));
+    }
+    EXPECT_EQ(b.order_count(), NUM_ORDERS / 2);
+    EXPECT_FALSE(b.top_of_book().has_ask());
+    EXPECT_EQ(b.top_of_book().best_bid_px, 9900 * 10000000LL);
+}
+
+TYPED_TEST(OrderBookPolicyTest, AnalyticsMatchRecomputation) {
+    auto& b = this->book;
+    constexpr size_t LEVELS = 3;
+    constexpr uint32_t BAND_BPS = 20;  // 20 cents around $100
+    b.enable_analytics(LEVELS, BAND_BPS);
+    
+    // What depth() and band_depth() must equal, computed from scratch
+    auto expect_matches = [&](book::Side side) {
+        uint64_t depth = 0;
+        uint64_t band = 0;
+        size_t level = 0;
+        int64_t limit = 0;
+        b.for_each_level(side, [&](int64_t price, uint32_t quantity) {
+            if (level == 0) {
+                const int64_t width = price * BAND_BPS / 10000;
+                limit = side == book::Side::BUY ? price - width : price + width;
+            }
+            if (level++ < LEVELS) {
+                depth += quantity;
+            }
+            if (side == book::Side::BUY ? price >= limit : price <= limit) {
+                band += quantity;
+            }
+            return true;
+        });
+        EXPECT_EQ(b.depth(side), depth);
+        EXPECT_EQ(b.band_depth(side), band);
+    };
+    
+    std::mt19937 rng(7);
+    std::unordered_map<uint64_t, uint32_t> live;  // order id -> quantity
+    uint64_t next_id = 1;
+    for (int step = 0; step < 5000; ++step) {
+        const uint32_t action = rng() % 4;
+        if (action == 0 || live.size() < 10) {
+            const bool buy = rng() % 2 == 0;
+            const int64_t cents = buy ? 9990 - static_cast<int64_t>(rng() % 40) : 10010 + static_cast<int64_t>(rng() % 40);
+            const uint32_t quantity = 1 + rng() % 100;
+            if (b.on_add(next_id, buy ? book::Side::BUY : book::Side::SELL, cents * 10000000LL, quantity)) {
+                live[next_id] = quantity;
+            }
+            next_id++;
+        } else {
+            auto it = live.begin();
+            std::advance(it, rng() % live.size());
+            if (action == 1) {
+                const uint32_t quantity = 1 + rng() % it->second;
+                ASSERT_TRUE(b.on_execute(it->first, quantity));
+                if ((it->second -= quantity) == 0) {
+                    live.erase(it);
+                }
+            } else if (action == 2) {
+                ASSERT_TRUE(b.on_delete(it->first));
+                live.erase(it);
+            } else {
+                b.on_modify(it->first, b.top_of_book().best_bid_px - 10000000LL, it->second);
+            }
+        }
+        // Reading every few steps leaves runs of purely incremental updates
+        if (step % 3 == 0) {
+            expect_matches(book::Side::BUY);
+            expect_matches(book::Side::SELL);
+        }
+    }
+}
+
+TEST(PriceGridTest, OffGridPricesAreRejected) {
+    book::OrderBook b(book::PriceGrid{0, 10000000LL});
+    EXPECT_TRUE(b.on_add(1, book::Side::BUY, 100000000000LL, 100));
+    EXPECT_FALSE(b.on_add(2, book::Side::BUY, 100000000001LL, 100));
+    EXPECT_FALSE(b.on_modify(1, 99999999999LL, 100));
+    EXPECT_EQ(b.top_of_book().best_bid_px, 100000000000LL);
+    EXPECT_EQ(b.price_rejects(), 2);
+    
+    // Other rejects are not price rejects
+    EXPECT_FALSE(b.on_add(1, book::Side::BUY, 100000000000LL, 100));
+    EXPECT_FALSE(b.on_add(3, book::Side::SELL, 90000000000LL, 100));
+    EXPECT_FALSE(b.on_modify(4, 99999999999LL, 100));
+    EXPECT_EQ(b.price_rejects(), 2);
+}
+
+TEST(PriceGridTest, LadderRejectsPricesOutsideSpan) {
+    book::BasicOrderBook<book::FlatLadderLevels, book::HashOrderIndex> b(book::PriceGrid{0, 1});
+    EXPECT_TRUE(b.on_add(1, book::Side::BUY, 1000, 100));
+    EXPECT_FALSE(b.on_add(2, book::Side::BUY, 1000 - book::FlatLadderLevels<std::less<int64_t>>::MAX_SPAN, 100));
+    EXPECT_TRUE(b.on_add(3, book::Side::BUY, 900, 100));
+    EXPECT_EQ(b.top_of_book().best_bid_px, 1000);
+}
+
+TEST(PriceGridTest, LadderSpanFollowsPopulatedLevels) {
+    book::BasicOrderBook<book::FlatLadderLevels, book::HashOrderIndex> b(book::PriceGrid{0, 1});
+    const int64_t base = 1000000;
+    EXPECT_TRUE(b.on_add(1, book::Side::BUY, base, 100));
+    EXPECT_TRUE(b.on_add(2, book::Side::BUY, base + 40000, 100));
+    EXPECT_TRUE(b.on_add(3, book::Side::BUY, base - 20000, 100));
+    EXPECT_TRUE(b.on_add(4, book::Side::BUY, base - 25000, 100));
+    // Inside the populated range, whatever was allocated to get there
+    EXPECT_TRUE(b.on_add(5, book::Side::BUY, base, 100));
+    EXPECT_TRUE(b.on_add(6, book::Side::BUY, base + 1, 100));
+    EXPECT_FALSE(b.on_add(7, book::Side::BUY, base + 40600, 100));
+    
+    // Emptying the lowest level frees span at the top
+    EXPECT_TRUE(b.on_delete(4));
+    EXPECT_TRUE(b.on_add(7, book::Side::BUY, base + 40600, 100));
+    EXPECT_EQ(b.top_of_book().best_bid_px, base + 40600);
+    
+    std::vector<int64_t> prices;
+    b.for_each_level(book::Side::BUY, [&](int64_t px, uint32_t) { return prices.push_back(px), true; });
+    EXPECT_EQ(prices, (std::vector<int64_t>{base + 40600, base + 40000, base + 1, base, base - 20000}));
+}
+
+TEST(PriceGridTest, LadderFollowsDriftingBook) {
+    book::BasicOrderBook<book::FlatLadderLevels, book::HashOrderIndex> b(book::PriceGrid{0, 1});
+    const int64_t span = book::FlatLadderLevels<std::less<int64_t>>::MAX_SPAN;
+    int64_t price = 1000000;
+    uint64_t id = 1;
+    EXPECT_TRUE(b.on_add(id, book::Side::BUY, price, 100));
+    
+    // Cancel/replace one tick at a time, new order first so the ladder never
+    // empties: up three spans and back down again
+    size_t rejects = 0;
+    for (int64_t step = 0; step < 6 * span; ++step) {
+        price += step < 3 * span ? 1 : -1;
+        rejects += !b.on_add(id + 1, book::Side::BUY, price, 100);
+        EXPECT_TRUE(b.on_delete(id++));
+    }
+    EXPECT_EQ(rejects, 0u);
+    EXPECT_EQ(b.order_count(), 1);
+    EXPECT_EQ(b.top_of_book().best_bid_px, 1000000);
+}
+
+TEST(DirectOrderIndexTest, IdsBelowBaseFallBackToHash) {
+    book::DenseOrderBook b;
+    const uint64_t base = 10 * book::DirectOrderIndex<book::OrderInfo>::SEGMENT_SIZE;
+    EXPECT_TRUE(b.on_add(base, book::Side::BUY, 1000, 100));
+    EXPECT_TRUE(b.on_add(base - 1, book::Side::BUY, 1000, 50));
+    EXPECT_FALSE(b.on_add(base - 1, book::Side::BUY, 1000, 50));
+    EXPECT_EQ(b.order_count(), 2);
+    EXPECT_EQ(b.top_of_book().bid_sz, 150);
+    EXPECT_TRUE(b.on_delete(base - 1));
+    EXPECT_EQ(b.order_count(), 1);
+}
+
+TEST(DirectOrderIndexTest, LargeJumpsFallBackToHash) {
+    using Index = book::DirectOrderIndex<book::OrderInfo>;
+    Index index(std::pmr::get_default_resource());
+    EXPECT_TRUE(index.insert(1, book::OrderInfo(book::Side::BUY, 10, 100)));
+    
+    const uint64_t far = 1 + Index::SEGMENT_SIZE * (Index::MAX_JUMP_SEGMENTS + 1);
+    EXPECT_TRUE(index.insert(far, book::OrderInfo(book::Side::SELL, 20, 200)));
+    EXPECT_EQ(index.segment_count(), 1);
+    EXPECT_EQ(index.overflow_count(), 1);
+    EXPECT_FALSE(index.insert(far, book::OrderInfo(book::Side::SELL, 20, 200)));
+    
+    ASSERT_NE(index.find(far), nullptr);
+    EXPECT_EQ(index.find(far)->quantity, 200);
+    EXPECT_EQ(index.size(), 2);
+    
+    index.erase(far);
+    EXPECT_EQ(index.find(far), nullptr);
+    EXPECT_EQ(index.overflow_count(), 0);
+    EXPECT_EQ(index.size(), 1);
+}
+
+TEST(DirectOrderIndexTest, WindowFollowsIdsAfterJump) {
+    using Index = book::DirectOrderIndex<book::OrderInfo>;
+    const uint64_t far = Index::SEGMENT_SIZE * (Index::MAX_JUMP_SEGMENTS + 1) * 1000;
+    
+    // Everything before the jump is gone: the window moves with the ids
+    Index empty_window(std::pmr::get_default_resource());
+    EXPECT_TRUE(empty_window.insert(1, book::OrderInfo(book::Side::BUY, 10, 100)));
+    empty_window.erase(1);
+    for (uint64_t id = far; id < far + 50000; ++id) {
+        ASSERT_TRUE(empty_window.insert(id, book::OrderInfo(book::Side::BUY, 1, 1)));
+    }
+    EXPECT_EQ(empty_window.size(), 50000);
+    EXPECT_EQ(empty_window.overflow_count(), 0);
+    
+    // One order keeps resting (e.g. restored from a checkpoint): it moves to
+    // the overflow once the new ids outnumber it
+    Index straggler(std::pmr::get_default_resource());
+    EXPECT_TRUE(straggler.insert(1, book::OrderInfo(book::Side::BUY, 10, 100)));
+    for (uint64_t id = far; id < far + 50000; ++id) {
+        ASSERT_TRUE(straggler.insert(id, book::OrderInfo(book::Side::BUY, 1, 1)));
+    }
+    EXPECT_EQ(straggler.size(), 50001);
+    EXPECT_LE(straggler.overflow_count(), 3);
+    ASSERT_NE(straggler.find(1), nullptr);
+    EXPECT_EQ(straggler.find(1)->quantity, 100);
+    for (uint64_t id = far; id < far + 50000; ++id) {
+        ASSERT_NE(straggler.find(id), nullptr);
+    }
+    EXPECT_FALSE(straggler.insert(far, book::OrderInfo(book::Side::BUY, 1, 1)));
+}
+
+TEST(DirectOrderIndexTest, RetiredSegmentsAreReleased) {
+    using Index = book::DirectOrderIndex<book::OrderInfo>;
+    Index index(std::pmr::get_default_resource());
+    
+    // Sliding window of live orders far longer than the window itself
+    const uint64_t live = 100;
+    const uint64_t total = Index::SEGMENT_SIZE * Index::MAX_SEGMENTS * 4;
+    for (uint64_t id = 1; id <= total; ++id) {
+        ASSERT_TRUE(index.insert(id, book::OrderInfo(book::Side::BUY, 1, 1)));
+        if (id > live) {
+            index.erase(id - live);
+        }
+    }
+    EXPECT_EQ(index.size(), live);
+    EXPECT_LE(index.segment_count(), 2);
+    EXPECT_EQ(index.overflow_count(), 0);
+    for (uint64_t id = total - live + 1; id <= total; ++id) {
+        EXPECT_NE(index.find(id), nullptr);
+    }
+}
+
+TEST(DirectOrderIndexTest, LongLivedOrdersMoveToOverflow) {
+    using Index = book::DirectOrderIndex<book::OrderInfo>;
+    Index index(std::pmr::get_default_resource());
+    
+    // Order 1 rests while the window advances past MAX_SEGMENTS
+    EXPECT_TRUE(index.insert(1, book::OrderInfo(book::Side::BUY, 1, 7)));
+    const uint64_t total = Index::SEGMENT_SIZE * (Index::MAX_SEGMENTS + 2);
+    for (uint64_t id = 2; id <= total; ++id) {
+        ASSERT_TRUE(index.insert(id, book::OrderInfo(book::Side::BUY, 1, 1)));
+        index.erase(id);
+    }
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_EQ(index.overflow_count(), 1);
+    EXPECT_LE(index.segment_count(), Index::MAX_SEGMENTS);
+    ASSERT_NE(index.find(1), nullptr);
+    EXPECT_EQ(index.find(1)->quantity, 7);
+    
+    size_t visited = 0;
+    index.for_each([&](uint64_t id, const book::OrderInfo&) {
+        EXPECT_EQ(id, 1);
+        visited++;
+    });
+    EXPECT_EQ(visited, 1);
+}
+
+TEST(DirectOrderIndexTest, ClearAndMove) {
+    using Index = book::DirectOrderIndex<book::OrderInfo>;
+    Index index(std::pmr::get_default_resource());
+    for (uint64_t id = 1; id <= 5000; ++id) {
+        EXPECT_TRUE(index.insert(id, book::OrderInfo(book::Side::SELL, 1, 1)));
+    }
+    
+    Index moved(std::move(index));
+    EXPECT_EQ(moved.size(), 5000);
+    EXPECT_NE(moved.find(4321), nullptr);
+    
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(moved.find(4321), nullptr);
+    
+    // Reusable after clear with a different base
+    EXPECT_TRUE(moved.insert(1000000, book::OrderInfo(book::Side::SELL, 1, 1)));
+    EXPECT_NE(moved.find(1000000), nullptr);
+}
+
+TEST(PackedOrderTest, PacksSideIntoTickWord) {
+    EXPECT_EQ(sizeof(book::PackedOrder), 8);
+    EXPECT_EQ(sizeof(std::pair<const uint64_t, book::PackedOrder>), 16);
+    
+    book::PackedOrder order(book::Side::SELL, 123456, 700);
+    EXPECT_EQ(order.side(), book::Side::SELL);
+    EXPECT_EQ(order.ticks(), 123456);
+    EXPECT_EQ(order.quantity(), 700);
+    
+    order.set_ticks(book::PackedOrder::SELL_BIT - 1);
+    EXPECT_EQ(order.side(), book::Side::SELL);
+    EXPECT_EQ(order.ticks(), static_cast<int32_t>(book::PackedOrder::SELL_BIT - 1));
+    
+    book::PackedOrder buy(book::Side::BUY, 0, 1);
+    EXPECT_EQ(buy.side(), book::Side::BUY);
+}
+
+TEST(PackedOrderTest, PricesOutsideTickRangeAreRejected) {
+    // $0.01 ticks from a $50.00 base
+    book::PackedOrderBook b(book::PriceGrid{50000000000LL, 10000000LL});
+    EXPECT_TRUE(b.on_add(1, book::Side::BUY, 100000000000LL, 100));
+    EXPECT_FALSE(b.on_add(2, book::Side::BUY, 49990000000LL, 100));   // below base
+    EXPECT_TRUE(b.on_add(3, book::Side::SELL, 101000000000LL, 100));
+    EXPECT_FALSE(b.on_modify(3, 40000000000LL, 100));
+    
+    const int64_t too_far = 50000000000LL + (int64_t{book::PackedOrder::SELL_BIT} * 10000000LL);
+    EXPECT_FALSE(b.on_add(4, book::Side::SELL, too_far, 100));
+    EXPECT_EQ(b.price_rejects(), 3);
+    
+    auto tob = b.top_of_book();
+    EXPECT_EQ(tob.best_bid_px, 100000000000LL);
+    EXPECT_EQ(tob.best_ask_px, 101000000000LL);
+    
+    // Nano prices come back out at the boundary
+    size_t visited = 0;
+    b.for_each_order([&](uint64_t order_id, const book::OrderInfo& info) {
+        EXPECT_EQ(info.price, order_id == 1 ? 100000000000LL : 101000000000LL);
+        visited++;
+    });
+    EXPECT_EQ(visited, 2);
+}
+
+} // anonymous namespace
@@ -8,6 +8,10 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <span>
+#include <memory>
+#include <sys/mman.h>
+#include <unistd.h>
 
 namespace {
 
@@ -130,6 +134,207 @@ TEST(RingBufferTest, SingleProducerSingleConsumer) {
     }
 }
 
+TEST(RingBufferTest, ClaimCommitPeekRelease) {
+    core::RingBuffer<int> buffer(4);
+    
+    // Nothing is visible until commit
+    int* slot = buffer.try_claim();
+    ASSERT_NE(slot, nullptr);
+    *slot = 7;
+    EXPECT_EQ(buffer.peek(), nullptr);
+    buffer.commit();
+    
+    const int* front = buffer.peek();
+    ASSERT_NE(front, nullptr);
+    EXPECT_EQ(*front, 7);
+    EXPECT_EQ(buffer.peek(), front);  // peek does not consume
+    buffer.release();
+    EXPECT_TRUE(buffer.empty());
+    
+    // Capacity - 1 slots can be claimed before the buffer is full
+    for (int i = 0; i < 3; ++i) {
+        int* next = buffer.try_claim();
+        ASSERT_NE(next, nullptr);
+        *next = i;
+        buffer.commit();
+    }
+    EXPECT_EQ(buffer.try_claim(), nullptr);
+}
+
+TEST(RingBufferTest, BatchesStopAtWrapAndFullness) {
+    core::RingBuffer<int> buffer(8);
+    
+    std::span<int> slots = buffer.claim_batch(100);
+    EXPECT_EQ(slots.size(), 7);  // one slot always stays free
+    for (size_t i = 0; i < 6; ++i) {
+        slots[i] = static_cast<int>(i);
+    }
+    buffer.commit(6);
+    
+    std::span<int> items = buffer.peek_batch(4);
+    ASSERT_EQ(items.size(), 4);
+    EXPECT_EQ(items[0], 0);
+    EXPECT_EQ(items[3], 3);
+    buffer.release(4);
+    
+    // Tail is at 6: contiguous space runs to the end of the array, then wraps
+    slots = buffer.claim_batch(100);
+    ASSERT_EQ(slots.size(), 2);
+    slots[0] = 6;
+    slots[1] = 7;
+    buffer.commit(2);
+    slots = buffer.claim_batch(100);
+    ASSERT_EQ(slots.size(), 3);
+    slots[0] = 8;
+    buffer.commit(1);
+    
+    std::vector<int> drained;
+    for (std::span<int> batch = buffer.peek_batch(100); !batch.empty(); batch = buffer.peek_batch(100)) {
+        drained.insert(drained.end(), batch.begin(), batch.end());
+        buffer.release(batch.size());
+    }
+    EXPECT_EQ(drained, (std::vector<int>{4, 5, 6, 7, 8}));
+}
+
+TEST(RingBufferTest, InPlaceSingleProducerSingleConsumer) {
+    constexpr size_t NUM_ITEMS = 100000;
+    core::RingBuffer<uint64_t> buffer(256);
+    
+    std::thread producer([&]() {
+        uint64_t next = 0;
+        while (next < NUM_ITEMS) {
+            std::span<uint64_t> slots = buffer.claim_batch(std::min<size_t>(16, NUM_ITEMS - next));
+            for (auto& slot : slots) {
+                slot = next++;
+            }
+            buffer.commit(slots.size());
+            if (slots.empty()) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    uint64_t expected = 0;
+    while (expected < NUM_ITEMS) {
+        std::span<uint64_t> items = buffer.peek_batch(32);
+        for (uint64_t value : items) {
+            ASSERT_EQ(value, expected);
+            expected++;
+        }
+        buffer.release(items.size());
+        if (items.empty()) {
+            std::this_thread::yield();
+        }
+    }
+    
+    producer.join();
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBufferTest, TelemetryCounters) {
+    core::RingBuffer<int> buffer(8);
+    int value;
+    EXPECT_FALSE(buffer.try_pop(value));
+    EXPECT_EQ(buffer.peek(), nullptr);
+    
+    for (int i = 0; i < 5; ++i) {
+        buffer.try_push(i);
+    }
+    buffer.commit(buffer.claim_batch(8).size());  // 2 more, up to the wrap
+    EXPECT_FALSE(buffer.try_push(99));
+    EXPECT_TRUE(buffer.claim_batch(4).empty());
+    
+    buffer.try_pop(value);
+    buffer.release(buffer.peek_batch(3).size());
+    
+    core::RingStats stats = buffer.stats();
+    EXPECT_EQ(stats.pushes, 7);
+    EXPECT_EQ(stats.pops, 4);
+    EXPECT_EQ(stats.full_spins, 2);
+    EXPECT_EQ(stats.empty_spins, 2);
+    EXPECT_EQ(stats.high_water, 7);
+    
+    // The high-water mark stays put as the buffer drains
+    buffer.release(buffer.peek_batch(8).size());
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.stats().pops, 7);
+    EXPECT_EQ(buffer.stats().high_water, 7);
+}
+
+TEST(RingBufferTest, HighWaterUsesHeadAtCommit) {
+    core::RingBuffer<int> buffer(16);
+    int value;
+    
+    // The consumer drains between every claim and commit, around the ring
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(buffer.try_push(i));
+        }
+        const size_t claimed = buffer.claim_batch(4).size();
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(buffer.try_pop(value));
+        }
+        buffer.commit(claimed);
+        buffer.release(buffer.peek_batch(claimed).size());
+        ASSERT_TRUE(buffer.empty());
+    }
+    EXPECT_EQ(buffer.stats().high_water, 4);
+}
+
+TEST(RingBufferTest, MappedStorage) {
+    core::PageOptions options;
+    options.pages = core::PageMode::HUGETLB;  // Falls back to THP without a hugetlb pool
+    options.numa_node = core::current_numa_node();
+    options.prefault = true;
+    core::RingBuffer<std::unique_ptr<int>> buffer(1024, options);
+    
+    EXPECT_GE(buffer.region().size(), 1024 * sizeof(std::unique_ptr<int>));
+    
+    // Slots are value-initialised and destroyed with the buffer
+    std::span<std::unique_ptr<int>> slots = buffer.claim_batch(4);
+    ASSERT_EQ(slots.size(), 4);
+    for (size_t i = 0; i < slots.size(); ++i) {
+        EXPECT_EQ(slots[i], nullptr);
+        slots[i] = std::make_unique<int>(static_cast<int>(i));
+    }
+    buffer.commit(slots.size());
+    
+    std::unique_ptr<int> value;
+    ASSERT_TRUE(buffer.try_pop(value));
+    EXPECT_EQ(*value, 0);
+}
+
+// Pages of the mapping the kernel has backed so far
+size_t resident_pages(const core::MappedRegion& region) {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> residency((region.size() + page - 1) / page);
+    if (mincore(region.data(), region.size(), residency.data()) != 0) {
+        return SIZE_MAX;
+    }
+    size_t resident = 0;
+    for (unsigned char flags : residency) {
+        resident += flags & 1;
+    }
+    return resident;
+}
+
+TEST(RingBufferTest, MappedTrivialSlotsAreNotTouched) {
+    constexpr size_t CAPACITY = 1 << 16;
+    core::PageOptions options;
+    core::RingBuffer<uint64_t> lazy(CAPACITY, options);
+    EXPECT_EQ(resident_pages(lazy.region()), 0);
+    
+    options.prefault = true;
+    core::RingBuffer<uint64_t> prefaulted(CAPACITY, options);
+    EXPECT_EQ(resident_pages(prefaulted.region()), CAPACITY * sizeof(uint64_t) / sysconf(_SC_PAGESIZE));
+    
+    // The zeroed mapping is the initial slot contents
+    uint64_t value = 1;
+    ASSERT_TRUE(lazy.try_push(7));
+    ASSERT_TRUE(lazy.try_pop(value));
+    EXPECT_EQ(value, 7);
+}
+
 TEST(RingBufferTest, PowerOfTwoAssertion) {
     // Valid power of 2 sizes should work
     EXPECT_NO_THROW(core::RingBuffer<int>(2));
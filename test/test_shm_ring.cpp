@@ -0,0 +1,142 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "shm_ring.hpp"
+#include "shm_publisher.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+class ShmRingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        name_ = "/market_feed_test_" + std::to_string(::getpid()) + "_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        core::ShmSegment::unlink(name_);
+    }
+    
+    void TearDown() override {
+        core::ShmSegment::unlink(name_);
+    }
+    
+    std::string name_;
+};
+
+TEST_F(ShmRingTest, PublishAndRead) {
+    core::ShmRingProducer<uint64_t> producer(name_, 8);
+    core::ShmRingConsumer<uint64_t> consumer(name_);
+    EXPECT_EQ(producer.epoch(), 1);
+    EXPECT_TRUE(consumer.producer_alive());
+    
+    uint64_t value;
+    EXPECT_FALSE(consumer.try_read(value));
+    for (uint64_t i = 0; i < 5; ++i) {
+        producer.publish(i * 10);
+    }
+    for (uint64_t i = 0; i < 5; ++i) {
+        ASSERT_TRUE(consumer.try_read(value));
+        EXPECT_EQ(value, i * 10);
+    }
+    EXPECT_FALSE(consumer.try_read(value));
+    EXPECT_EQ(consumer.dropped(), 0);
+}
+
+TEST_F(ShmRingTest, SlowConsumerDetectsOverwrite) {
+    core::ShmRingProducer<uint64_t> producer(name_, 8);
+    core::ShmRingConsumer<uint64_t> consumer(name_);
+    
+    // The producer never waits; 20 records into 8 slots loses the first 12
+    for (uint64_t i = 0; i < 20; ++i) {
+        producer.publish(i);
+    }
+    uint64_t value;
+    ASSERT_TRUE(consumer.try_read(value));
+    EXPECT_EQ(value, 12);
+    EXPECT_EQ(consumer.dropped(), 12);
+    
+    // A consumer attached from the start sees only what the ring still holds
+    core::ShmRingConsumer<uint64_t> late(name_, true);
+    ASSERT_TRUE(late.try_read(value));
+    EXPECT_EQ(value, 12);
+    EXPECT_EQ(late.dropped(), 0);
+}
+
+TEST_F(ShmRingTest, RestartedProducerContinuesSequence) {
+    {
+        core::ShmRingProducer<uint64_t> producer(name_, 8);
+        producer.publish(1);
+        producer.publish(2);
+    }
+    core::ShmRingConsumer<uint64_t> consumer(name_, true);
+    EXPECT_FALSE(consumer.producer_alive());
+    
+    core::ShmRingProducer<uint64_t> restarted(name_, 8);
+    EXPECT_EQ(restarted.epoch(), 2);
+    EXPECT_EQ(restarted.published(), 2);
+    restarted.publish(3);
+    
+    uint64_t value;
+    for (uint64_t expected : {1, 2, 3}) {
+        ASSERT_TRUE(consumer.try_read(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_EQ(consumer.epoch(), 2);
+}
+
+TEST_F(ShmRingTest, RejectsMismatchedLayoutAndSecondProducer) {
+    EXPECT_THROW(core::ShmRingConsumer<uint64_t> missing(name_), std::runtime_error);
+    
+    core::ShmRingProducer<uint64_t> producer(name_, 8);
+    EXPECT_THROW(core::ShmRingConsumer<publish::TobRecord> wrong(name_), std::runtime_error);
+    
+    // Only a dead producer can be replaced; this one is us in another process
+    pid_t child = ::fork();
+    if (child == 0) {
+        try {
+            core::ShmRingProducer<uint64_t> second(name_, 8);
+            ::_exit(0);
+        } catch (const std::runtime_error&) {
+            ::_exit(1);
+        }
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    EXPECT_EQ(WEXITSTATUS(status), 1);
+}
+
+TEST_F(ShmRingTest, CrossProcessTopOfBook) {
+    pid_t child = ::fork();
+    if (child == 0) {
+        publish::ShmTopOfBookPublisher publisher(name_, 64);
+        book::TopOfBook tob;
+        tob.best_bid_px = 100000000000LL;
+        tob.bid_sz = 100;
+        for (uint64_t ts = 1; ts <= 10; ++ts) {
+            publisher.publish(ts, feed::Symbol("AAPL"), tob);
+        }
+        ::_exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    
+    core::ShmRingConsumer<publish::TobRecord> consumer(name_, true);
+    publish::TobRecord record;
+    for (uint64_t ts = 1; ts <= 10; ++ts) {
+        ASSERT_TRUE(consumer.try_read(record));
+        EXPECT_EQ(record.ts_us, ts);
+        EXPECT_STREQ(record.symbol, "AAPL");
+        EXPECT_EQ(record.bid_px, 100000000000LL);
+        EXPECT_EQ(record.bid_sz, 100);
+        EXPECT_EQ(record.ask_sz, 0);
+    }
+    EXPECT_FALSE(consumer.try_read(record));
+    EXPECT_FALSE(consumer.producer_alive());
+}
+
+} // anonymous namespace
@@ -0,0 +1,177 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "snapshot.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+
+class SnapshotTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        temp_filename = "test_snapshot_XXXXXX";
+        int fd = mkstemp(&temp_filename[0]);
+        ASSERT_NE(fd, -1);
+        close(fd);
+    }
+    
+    void TearDown() override {
+        std::remove(temp_filename.c_str());
+    }
+    
+    std::unordered_map<feed::Symbol, book::OrderBook> make_books() {
+        std::unordered_map<feed::Symbol, book::OrderBook> books;
+        books[feed::Symbol("AAPL")];
+        books[feed::Symbol("MSFT")];
+        return books;
+    }
+    
+    std::string temp_filename;
+};
+
+TEST_F(SnapshotTest, RoundTrip) {
+    auto books = make_books();
+    auto& aapl = books[feed::Symbol("AAPL")];
+    auto& msft = books[feed::Symbol("MSFT")];
+    
+    EXPECT_TRUE(aapl.on_add(1, book::Side::BUY, 150000000000LL, 100));
+    EXPECT_TRUE(aapl.on_add(2, book::Side::BUY, 150000000000LL, 50));
+    EXPECT_TRUE(aapl.on_add(3, book::Side::SELL, 151000000000LL, 200));
+    EXPECT_TRUE(msft.on_add(4, book::Side::SELL, 250000000000LL, 75));
+    
+    book::save_snapshot(temp_filename, books, {12345, 4});
+    
+    auto restored = make_books();
+    book::SnapshotPosition position = book::load_snapshot(temp_filename, restored);
+    EXPECT_EQ(position.feed_offset, 12345);
+    EXPECT_EQ(position.message_count, 4);
+    
+    const auto& restored_aapl = restored[feed::Symbol("AAPL")];
+    EXPECT_EQ(restored_aapl.order_count(), 3);
+    auto tob = restored_aapl.top_of_book();
+    EXPECT_EQ(tob.best_bid_px, 150000000000LL);
+    EXPECT_EQ(tob.bid_sz, 150);
+    EXPECT_EQ(tob.best_ask_px, 151000000000LL);
+    EXPECT_EQ(tob.ask_sz, 200);
+    
+    const auto& restored_msft = restored[feed::Symbol("MSFT")];
+    EXPECT_EQ(restored_msft.order_count(), 1);
+    EXPECT_EQ(restored_msft.top_of_book().ask_sz, 75);
+    
+    // Restored orders remain individually addressable
+    auto& mutable_aapl = restored[feed::Symbol("AAPL")];
+    EXPECT_TRUE(mutable_aapl.on_delete(2));
+    EXPECT_EQ(mutable_aapl.top_of_book().bid_sz, 100);
+}
+
+TEST_F(SnapshotTest, UnknownSymbolsAreSkipped) {
+    auto books = make_books();
+    EXPECT_TRUE(books[feed::Symbol("MSFT")].on_add(1, book::Side::BUY, 250000000000LL, 10));
+    book::save_snapshot(temp_filename, books, {100, 1});
+    
+    std::unordered_map<feed::Symbol, book::OrderBook> restored;
+    restored[feed::Symbol("AAPL")];
+    EXPECT_NO_THROW(book::load_snapshot(temp_filename, restored));
+    EXPECT_TRUE(restored[feed::Symbol("AAPL")].empty());
+    EXPECT_EQ(restored.size(), 1);
+}
+
+TEST_F(SnapshotTest, CorruptPayloadIsRejected) {
+    auto books = make_books();
+    EXPECT_TRUE(books[feed::Symbol("AAPL")].on_add(1, book::Side::BUY, 150000000000LL, 100));
+    book::save_snapshot(temp_filename, books, {0, 0});
+    
+    // Flip the last byte of the payload
+    {
+        std::fstream file(temp_filename, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1, std::ios::end);
+        char byte = 0;
+        file.get(byte);
+        file.seekp(-1, std::ios::end);
+        file.put(static_cast<char>(byte ^ 0xFF));
+    }
+    
+    auto restored = make_books();
+    EXPECT_THROW(book::load_snapshot(temp_filename, restored), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, OversizedOrderCountIsRejected) {
+    auto books = make_books();
+    EXPECT_TRUE(books[feed::Symbol("AAPL")].on_add(1, book::Side::BUY, 150000000000LL, 100));
+    book::save_snapshot(temp_filename, books, {0, 0});
+    
+    // A section claiming 2^61 orders (3 * 2^64 bytes: wraps to 0 when multiplied),
+    // with the checksum fixed up so only the bounds check can catch it
+    std::string bytes;
+    {
+        std::ifstream file(temp_filename, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    const uint64_t order_count = uint64_t{1} << 61;
+    std::memcpy(&bytes[sizeof(book::SnapshotHeader) + offsetof(book::SnapshotBook, order_count)],
+                &order_count, sizeof(order_count));
+    const uint64_t checksum = book::snapshot_checksum(bytes.data() + sizeof(book::SnapshotHeader),
+                                                      bytes.size() - sizeof(book::SnapshotHeader));
+    std::memcpy(&bytes[offsetof(book::SnapshotHeader, checksum)], &checksum, sizeof(checksum));
+    {
+        std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    
+    auto restored = make_books();
+    EXPECT_THROW(book::load_snapshot(temp_filename, restored), std::runtime_error);
+}
+
+TEST(SnapshotFeedTest, OnlyTheCheckpointedFeedIsAccepted) {
+    const std::string feed = "0123456789abcdef";
+    const book::SnapshotPosition position{10, 3, book::snapshot_checksum(feed.data(), 10)};
+    
+    EXPECT_NO_THROW(book::verify_snapshot_feed(position, feed));
+    // The feed may have grown past the checkpoint
+    EXPECT_NO_THROW(book::verify_snapshot_feed(position, std::string(feed + "more")));
+    
+    std::string regenerated = feed;
+    regenerated[2] = 'x';
+    EXPECT_THROW(book::verify_snapshot_feed(position, regenerated), std::runtime_error);
+    EXPECT_THROW(book::verify_snapshot_feed(position, feed.substr(0, 8)), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, TruncatedFileIsRejected) {
+    {
+        std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+        file << "MFSNAP";
+    }
+    auto restored = make_books();
+    EXPECT_THROW(book::load_snapshot(temp_filename, restored), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, MissingFileIsRejected) {
+    auto restored = make_books();
+    EXPECT_THROW(book::load_snapshot("nonexistent.snap", restored), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, DenseBooksRoundTrip) {
+    std::unordered_map<feed::Symbol, book::DenseOrderBook> books;
+    auto& aapl = books[feed::Symbol("AAPL")];
+    EXPECT_TRUE(aapl.on_add(1000, book::Side::BUY, 150000000000LL, 100));
+    EXPECT_TRUE(aapl.on_add(5, book::Side::SELL, 151000000000LL, 200));
+    book::save_snapshot(temp_filename, books, {64, 2});
+    
+    std::unordered_map<feed::Symbol, book::DenseOrderBook> restored;
+    restored[feed::Symbol("AAPL")];
+    book::load_snapshot(temp_filename, restored);
+    auto& restored_aapl = restored[feed::Symbol("AAPL")];
+    EXPECT_EQ(restored_aapl.order_count(), 2);
+    EXPECT_TRUE(restored_aapl.on_delete(5));
+    EXPECT_TRUE(restored_aapl.on_delete(1000));
+}
+
+} // anonymous namespace
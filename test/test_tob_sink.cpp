@@ -0,0 +1,83 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "tob_sink.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Records what it sees so tests can check fan-out order
+class RecordingSink {
+public:
+    RecordingSink(std::vector<std::string>& log, std::string name) : log_(&log), name_(std::move(name)) {}
+    
+    void write(const publish::BinaryTobRecord& record, const feed::Symbol& symbol) {
+        log_->push_back(name_ + ":" + symbol.to_string() + ":" + std::to_string(record.ts_us));
+    }
+    
+    void end_round() {
+        log_->push_back(name_ + ":end");
+    }
+
+private:
+    std::vector<std::string>* log_;
+    std::string name_;
+};
+
+static_assert(publish::TopOfBookSink<RecordingSink>);
+
+publish::BinaryTobRecord make_record(uint64_t ts_us) {
+    book::TopOfBook tob;
+    tob.best_bid_px = 100250000000LL;
+    tob.bid_sz = 300;
+    tob.best_ask_px = 100260000000LL;
+    tob.ask_sz = 200;
+    return publish::make_binary_tob_record(ts_us, 0, tob);
+}
+
+TEST(TopOfBookSinkTest, FanOutCallsSinksInOrder) {
+    std::vector<std::string> log;
+    publish::FanOutSink sink(RecordingSink(log, "a"), publish::OptionalSink<RecordingSink>(),
+                             publish::OptionalSink<RecordingSink>(RecordingSink(log, "b")));
+    sink.write(make_record(1), feed::Symbol("AAPL"));
+    sink.write(make_record(2), feed::Symbol("MSFT"));
+    sink.end_round();
+    
+    const std::vector<std::string> expected = {"a:AAPL:1", "b:AAPL:1", "a:MSFT:2", "b:MSFT:2", "a:end", "b:end"};
+    EXPECT_EQ(log, expected);
+    EXPECT_FALSE(sink.get<1>().has_value());
+    EXPECT_TRUE(sink.get<2>().has_value());
+}
+
+TEST(TopOfBookSinkTest, CsvSinkMatchesPublisher) {
+    std::ostringstream direct_output;
+    publish::TopOfBookPublisher direct(direct_output);
+    std::ostringstream sink_output;
+    publish::TopOfBookPublisher batched(sink_output, false);
+    publish::CsvSink sink(batched);
+    
+    for (uint64_t ts = 1; ts <= 3; ++ts) {
+        const publish::BinaryTobRecord record = make_record(ts);
+        direct.publish(ts, feed::Symbol("AAPL"), publish::to_top_of_book(record));
+        sink.write(record, feed::Symbol("AAPL"));
+    }
+    sink.end_round();
+    EXPECT_EQ(sink_output.str(), direct_output.str());
+}
+
+TEST(TopOfBookSinkTest, NullSinkCounts) {
+    publish::FanOutSink sink(publish::NullSink{});
+    for (uint64_t ts = 0; ts < 5; ++ts) {
+        sink.write(make_record(ts), feed::Symbol("AAPL"));
+    }
+    sink.end_round();
+    EXPECT_EQ(sink.get<0>().records(), 5);
+    EXPECT_EQ(sink.get<0>().rounds(), 1);
+}
+
+} // namespace
@@ -0,0 +1,83 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "tob_table.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+book::TopOfBook make_tob(uint32_t k) {
+    book::TopOfBook tob;
+    tob.best_bid_px = 1000 + k;
+    tob.bid_sz = k;
+    tob.best_ask_px = 2000 + k;
+    tob.ask_sz = k + 1;
+    return tob;
+}
+
+TEST(TopOfBookTableTest, UpdateAndRead) {
+    book::TopOfBookTable table(4);
+    const size_t aapl = table.add_symbol(feed::Symbol("AAPL"));
+    const size_t msft = table.add_symbol(feed::Symbol("MSFT"));
+    EXPECT_EQ(table.size(), 2);
+    EXPECT_EQ(table.find(feed::Symbol("MSFT")), msft);
+    EXPECT_FALSE(table.find(feed::Symbol("TSLA")).has_value());
+    EXPECT_EQ(table.read(aapl).version, 0);
+    
+    EXPECT_TRUE(table.update(aapl, make_tob(5), 42));
+    book::Quote quote = table.read(aapl);
+    EXPECT_EQ(quote.tob.best_bid_px, 1005);
+    EXPECT_EQ(quote.tob.bid_sz, 5);
+    EXPECT_EQ(quote.tob.best_ask_px, 2005);
+    EXPECT_EQ(quote.tob.ask_sz, 6);
+    EXPECT_EQ(quote.ts_us, 42);
+    EXPECT_EQ(quote.version, 1);
+    
+    // Unchanged top of book is not rewritten
+    EXPECT_FALSE(table.update(aapl, make_tob(5), 43));
+    EXPECT_EQ(table.read(aapl).ts_us, 42);
+    EXPECT_EQ(table.read(msft).version, 0);
+}
+
+TEST(TopOfBookTableTest, ReadersSeeWholeUpdates) {
+    book::TopOfBookTable table(1);
+    const size_t slot = table.add_symbol(feed::Symbol("AAPL"));
+    constexpr uint32_t updates = 200000;
+    std::atomic<bool> done{false};
+    
+    std::vector<std::thread> readers;
+    std::atomic<uint64_t> torn{0};
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&]() {
+            uint64_t last_version = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                const book::Quote quote = table.read(slot);
+                const uint32_t k = quote.tob.bid_sz;
+                if (quote.version < last_version || (quote.version > 0 &&
+                    (quote.tob.best_bid_px != 1000 + k || quote.tob.best_ask_px != 2000 + k ||
+                     quote.tob.ask_sz != k + 1 || quote.ts_us != k))) {
+                    torn++;
+                }
+                last_version = quote.version;
+            }
+        });
+    }
+    
+    for (uint32_t k = 1; k <= updates; ++k) {
+        table.update(slot, make_tob(k), k);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(table.read(slot).version, updates);
+}
+
+} // anonymous namespace
@@ -0,0 +1,91 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "trades.hpp"
+#include "trade_publisher.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+book::Trade make_trade(uint64_t ts_us, int64_t price, uint32_t quantity) {
+    return book::Trade{ts_us, 7, price, quantity, book::Side::SELL};
+}
+
+} // anonymous namespace
+
+TEST(BarAggregatorTest, BuildsOhlcvAndVwap) {
+    book::BarAggregator aggregator(1000);
+    book::Bar bar;
+    EXPECT_FALSE(aggregator.on_trade(make_trade(10500, 100000000000LL, 100), bar));
+    EXPECT_FALSE(aggregator.on_trade(make_trade(10600, 102000000000LL, 50), bar));
+    EXPECT_FALSE(aggregator.on_trade(make_trade(10700, 99000000000LL, 25), bar));
+    EXPECT_FALSE(aggregator.on_trade(make_trade(10999, 101000000000LL, 25), bar));
+    
+    const book::Bar& current = aggregator.current();
+    EXPECT_EQ(current.start_us, 10000u);
+    EXPECT_EQ(current.end_us(), 11000u);
+    EXPECT_EQ(current.open, 100000000000LL);
+    EXPECT_EQ(current.high, 102000000000LL);
+    EXPECT_EQ(current.low, 99000000000LL);
+    EXPECT_EQ(current.close, 101000000000LL);
+    EXPECT_EQ(current.volume, 200u);
+    EXPECT_EQ(current.trades, 4u);
+    // (100*100 + 102*50 + 99*25 + 101*25) / 200 = 100.5
+    EXPECT_DOUBLE_EQ(current.vwap(), 100500000000.0);
+}
+
+TEST(BarAggregatorTest, RollsOverAndSkipsEmptyIntervals) {
+    book::BarAggregator aggregator(1000);
+    book::Bar bar;
+    EXPECT_FALSE(aggregator.on_trade(make_trade(1500, 100, 1), bar));
+    
+    // Nothing traded in [2000, 5000): the next bar starts at 5000
+    EXPECT_TRUE(aggregator.on_trade(make_trade(5200, 200, 2), bar));
+    EXPECT_EQ(bar.start_us, 1000u);
+    EXPECT_EQ(bar.close, 100);
+    EXPECT_EQ(aggregator.current().start_us, 5000u);
+    EXPECT_EQ(aggregator.current().open, 200);
+    
+    // Feed time alone closes a bar once its interval is over
+    EXPECT_FALSE(aggregator.close_if_due(5999, bar));
+    EXPECT_TRUE(aggregator.close_if_due(6000, bar));
+    EXPECT_EQ(bar.start_us, 5000u);
+    EXPECT_EQ(bar.volume, 2u);
+    EXPECT_FALSE(aggregator.has_open_bar());
+    EXPECT_FALSE(aggregator.finish(bar));
+    
+    // finish() writes out a partial bar
+    EXPECT_FALSE(aggregator.on_trade(make_trade(7100, 300, 3), bar));
+    EXPECT_TRUE(aggregator.finish(bar));
+    EXPECT_EQ(bar.start_us, 7000u);
+    EXPECT_EQ(bar.trades, 1u);
+    
+    EXPECT_THROW(book::BarAggregator(0), std::invalid_argument);
+}
+
+TEST(TradePublisherTest, WritesTradesAndBarsAsCsv) {
+    std::ostringstream trades;
+    std::ostringstream bars;
+    publish::TradePublisher trade_publisher(trades);
+    publish::BarPublisher bar_publisher(bars);
+    const feed::Symbol symbol("AAPL");
+    
+    trade_publisher.publish(symbol, make_trade(1500, 100250000000LL, 30));
+    EXPECT_EQ(trades.str(), "ts_us,symbol,order_id,side,price,quantity\n"
+                            "1500,AAPL,7,S,100.250000000,30\n");
+    EXPECT_EQ(trade_publisher.published(), 1u);
+    
+    book::BarAggregator aggregator(1000);
+    book::Bar bar;
+    aggregator.on_trade(make_trade(1500, 100000000000LL, 10), bar);
+    aggregator.on_trade(make_trade(1600, 101000000000LL, 30), bar);
+    ASSERT_TRUE(aggregator.finish(bar));
+    bar_publisher.publish(symbol, bar);
+    EXPECT_EQ(bars.str(), "start_us,interval_us,symbol,open,high,low,close,volume,trades,vwap\n"
+                          "1000,1000,AAPL,100.000000000,101.000000000,100.000000000,101.000000000,40,2,100.750000000\n");
+}
@@ -0,0 +1,143 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "udp_publisher.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+publish::TobRecord make_record(uint64_t ts_us, const char* symbol) {
+    book::TopOfBook tob;
+    tob.best_bid_px = 100000000000LL;
+    tob.bid_sz = static_cast<uint32_t>(ts_us);
+    tob.best_ask_px = 100500000000LL;
+    tob.ask_sz = 200;
+    return publish::make_tob_record(ts_us, feed::Symbol(symbol), tob);
+}
+
+publish::UdpTobHeader make_header(uint32_t session, uint64_t sequence) {
+    publish::UdpTobHeader header{};
+    std::memcpy(header.magic, publish::UDP_TOB_MAGIC, sizeof(header.magic));
+    header.version = publish::UDP_TOB_VERSION;
+    header.session = session;
+    header.sequence = sequence;
+    return header;
+}
+
+TEST(UdpCodecTest, RoundTrip) {
+    std::vector<publish::TobRecord> sent;
+    for (uint64_t i = 0; i < publish::UDP_TOB_MAX_RECORDS; ++i) {
+        sent.push_back(make_record(1000 + i, i % 2 ? "MSFT" : "AAPL"));
+    }
+    char datagram[publish::UDP_TOB_MAX_DATAGRAM];
+    const size_t size = publish::encode_udp_datagram(make_header(7, 42), sent, datagram);
+    EXPECT_LE(size, publish::UDP_TOB_MAX_DATAGRAM);
+    
+    publish::UdpTobHeader header;
+    std::vector<publish::TobRecord> received;
+    ASSERT_TRUE(publish::decode_udp_datagram(std::span<const char>(datagram, size), header, received));
+    EXPECT_EQ(header.session, 7);
+    EXPECT_EQ(header.sequence, 42);
+    EXPECT_EQ(header.record_count, sent.size());
+    ASSERT_EQ(received.size(), sent.size());
+    EXPECT_EQ(std::memcmp(received.data(), sent.data(), sent.size() * sizeof(publish::TobRecord)), 0);
+}
+
+TEST(UdpCodecTest, RejectsMalformed) {
+    const std::vector<publish::TobRecord> sent = {make_record(1, "AAPL"), make_record(2, "AAPL")};
+    char datagram[publish::UDP_TOB_MAX_DATAGRAM];
+    const size_t size = publish::encode_udp_datagram(make_header(1, 1), sent, datagram);
+    
+    publish::UdpTobHeader header;
+    std::vector<publish::TobRecord> received;
+    EXPECT_FALSE(publish::decode_udp_datagram(std::span<const char>(datagram, size - 1), header, received));
+    EXPECT_FALSE(publish::decode_udp_datagram(std::span<const char>(datagram, 10), header, received));
+    datagram[0] = 'X';
+    EXPECT_FALSE(publish::decode_udp_datagram(std::span<const char>(datagram, size), header, received));
+    EXPECT_TRUE(received.empty());
+}
+
+TEST(UdpCodecTest, ParseEndpoint) {
+    const auto [group, port] = publish::parse_udp_endpoint("239.255.0.1:30001");
+    EXPECT_EQ(group, "239.255.0.1");
+    EXPECT_EQ(port, 30001);
+    EXPECT_THROW(publish::parse_udp_endpoint("239.255.0.1"), std::invalid_argument);
+    EXPECT_THROW(publish::parse_udp_endpoint("239.255.0.1:x"), std::invalid_argument);
+    EXPECT_THROW(publish::parse_udp_endpoint("239.255.0.1:70000"), std::invalid_argument);
+}
+
+TEST(UdpSequenceTrackerTest, CountsGapsLateAndRestarts) {
+    publish::UdpSequenceTracker tracker;
+    for (uint64_t sequence : {1, 2, 3, 6, 7, 5, 7, 10}) {
+        tracker.on_datagram(make_header(1, sequence));
+    }
+    EXPECT_EQ(tracker.datagrams(), 8);
+    EXPECT_EQ(tracker.gaps(), 2);     // 4-5 and 8-9
+    EXPECT_EQ(tracker.missing(), 4);
+    EXPECT_EQ(tracker.late(), 2);     // 5 (reordered) and 7 (duplicate)
+    EXPECT_EQ(tracker.sessions(), 1);
+    
+    // A new session starts over without counting a gap
+    tracker.on_datagram(make_header(2, 1));
+    tracker.on_datagram(make_header(2, 2));
+    EXPECT_EQ(tracker.sessions(), 2);
+    EXPECT_EQ(tracker.gaps(), 2);
+    EXPECT_EQ(tracker.late(), 2);
+}
+
+TEST(UdpPublisherTest, LoopbackMulticast) {
+    const std::string group = "239.255.77.1";
+    const uint16_t port = static_cast<uint16_t>(40000 + ::getpid() % 20000);
+    std::unique_ptr<publish::UdpTobReceiver> receiver;
+    try {
+        receiver = std::make_unique<publish::UdpTobReceiver>(group, port);
+    } catch (const std::runtime_error& e) {
+        GTEST_SKIP() << "No loopback multicast: " << e.what();
+    }
+    
+    // 3 records per datagram and 2 datagrams per sendmmsg()
+    constexpr uint64_t COUNT = 20;
+    {
+        publish::UdpTopOfBookPublisher publisher(group, port, "127.0.0.1", 2, 3);
+        book::TopOfBook tob;
+        tob.best_bid_px = 100000000000LL;
+        for (uint64_t i = 0; i < COUNT; ++i) {
+            tob.bid_sz = static_cast<uint32_t>(i + 1);
+            publisher.publish(i, feed::Symbol("AAPL"), tob);
+        }
+        publisher.flush();
+        EXPECT_EQ(publisher.published(), COUNT);
+        EXPECT_EQ(publisher.datagrams(), 7);
+        EXPECT_EQ(publisher.send_calls(), 4);
+    }
+    
+    publish::UdpSequenceTracker tracker;
+    publish::UdpTobHeader header;
+    std::vector<publish::TobRecord> records;
+    while (records.size() < COUNT) {
+        const size_t datagrams = receiver->receive(1000);
+        ASSERT_GT(datagrams, 0) << "timed out after " << records.size() << " records";
+        for (size_t i = 0; i < datagrams; ++i) {
+            ASSERT_TRUE(publish::decode_udp_datagram(receiver->datagram(i), header, records));
+            tracker.on_datagram(header);
+        }
+    }
+    ASSERT_EQ(records.size(), COUNT);
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        EXPECT_EQ(records[i].ts_us, i);
+        EXPECT_EQ(records[i].bid_sz, i + 1);
+        EXPECT_STREQ(records[i].symbol, "AAPL");
+    }
+    EXPECT_EQ(tracker.datagrams(), 7);
+    EXPECT_EQ(tracker.gaps(), 0);
+    EXPECT_EQ(tracker.late(), 0);
+}
+
+} // namespace
@@ -0,0 +1,165 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "columnar.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <getopt.h>
+
+namespace {
+
+struct Config {
+    std::string input_file;
+    std::string column;
+    bool list = false;
+    bool dump = false;
+};
+
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " --input FILE [options]\n"
+              << "Options:\n"
+              << "  --input FILE              Columnar file written by market-feed\n"
+              << "  --column NAME             Scan one column: rows, min, max, sum and scan speed\n"
+              << "  --dump                    With --column, print every value\n"
+              << "  --list                    Print the schema, symbols and row groups\n"
+              << "  --help                    Show this help message\n";
+}
+
+Config parse_args(int argc, char* argv[]) {
+    Config config;
+    
+    static struct option long_options[] = {
+        {"input", required_argument, 0, 'i'},
+        {"column", required_argument, 0, 'c'},
+        {"dump", no_argument, 0, 'd'},
+        {"list", no_argument, 0, 'l'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    
+    int c;
+    while ((c = getopt_long(argc, argv, "i:c:dlh", long_options, nullptr)) != -1) {
+        switch (c) {
+            case 'i':
+                config.input_file = optarg;
+                break;
+            case 'c':
+                config.column = optarg;
+                break;
+            case 'd':
+                config.dump = true;
+                break;
+            case 'l':
+                config.list = true;
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                std::exit(0);
+            default:
+                print_usage(argv[0]);
+                std::exit(1);
+        }
+    }
+    
+    if (config.input_file.empty() || (config.column.empty() && !config.list)) {
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+    
+    return config;
+}
+
+void list(const publish::ColumnarReader& reader) {
+    std::cout << "rows=" << reader.row_count() << " row_groups=" << reader.row_group_count() << "\n";
+    std::cout << "columns:";
+    for (const publish::ColumnSpec& column : reader.columns()) {
+        std::cout << " " << column.name
+                  << (column.encoding == publish::ColumnEncoding::DELTA_VARINT ? "(delta)" : "(varint)");
+    }
+    std::cout << "\nsymbols:";
+    for (size_t id = 0; id < reader.symbols().size(); ++id) {
+        std::cout << " " << id << "=" << reader.symbols()[id].to_string();
+    }
+    std::cout << "\n";
+    for (size_t group = 0; group < reader.row_group_count(); ++group) {
+        std::cout << "group " << group << ": rows=" << reader.group_rows(group);
+        for (size_t column = 0; column < reader.columns().size(); ++column) {
+            const publish::ColumnarChunkInfo& chunk = reader.chunk(group, column);
+            std::cout << " " << reader.columns()[column].name << "=" << chunk.size << "B["
+                      << chunk.min << "," << chunk.max << "]";
+        }
+        std::cout << "\n";
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        Config config = parse_args(argc, argv);
+        publish::ColumnarReader reader(config.input_file);
+        
+        if (config.list) {
+            list(reader);
+        }
+        if (config.column.empty()) {
+            return 0;
+        }
+        
+        // Decode one chunk at a time into a reused buffer; other columns'
+        // bytes are never touched
+        const size_t column = reader.column_index(config.column);
+        std::vector<int64_t> values;
+        uint64_t rows = 0;
+        uint64_t bytes = 0;
+        int64_t min = std::numeric_limits<int64_t>::max();
+        int64_t max = std::numeric_limits<int64_t>::min();
+        int64_t sum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t group = 0; group < reader.row_group_count(); ++group) {
+            reader.read_column(group, column, values);
+            for (const int64_t value : values) {
+                sum += value;
+            }
+            if (!values.empty()) {
+                const auto [group_min, group_max] = std::minmax_element(values.begin(), values.end());
+                min = std::min(min, *group_min);
+                max = std::max(max, *group_max);
+            }
+            if (config.dump) {
+                for (const int64_t value : values) {
+                    std::printf("%lld\n", static_cast<long long>(value));
+                }
+            }
+            rows += values.size();
+            bytes += reader.chunk(group, column).size;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::fflush(stdout);
+        
+        std::cerr << config.column << ": rows=" << rows;
+        if (rows > 0) {
+            std::cerr << " min=" << min << " max=" << max << " sum=" << sum;
+        }
+        std::cerr << " encoded_bytes=" << bytes << " (" << (rows > 0 ? static_cast<double>(bytes) / rows : 0.0)
+                  << " B/row)";
+        if (!config.dump && seconds > 0) {
+            std::cerr << " scan=" << static_cast<uint64_t>(rows / seconds / 1e6) << " Mrows/s "
+                      << static_cast<uint64_t>(rows * sizeof(int64_t) / seconds / 1e6) << " MB/s decoded";
+        }
+        std::cerr << "\n";
+    
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    
+    return 0;
+}
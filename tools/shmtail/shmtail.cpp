@@ -0,0 +1,121 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "shm_ring.hpp"
+#include "publisher.hpp"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <getopt.h>
+
+namespace {
+
+struct Config {
+    std::string name = "/market-feed";
+    bool from_start = false;
+    uint64_t count = 0;  // 0 = until the producer exits
+};
+
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n"
+              << "Options:\n"
+              << "  --name NAME               Shared-memory ring name (default: /market-feed)\n"
+              << "  --from-start              Replay every record still in the ring\n"
+              << "  --count N                 Exit after N records (default: until producer exits)\n"
+              << "  --help                    Show this help message\n";
+}
+
+Config parse_args(int argc, char* argv[]) {
+    Config config;
+    
+    static struct option long_options[] = {
+        {"name", required_argument, 0, 'n'},
+        {"from-start", no_argument, 0, 'f'},
+        {"count", required_argument, 0, 'c'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    
+    int c;
+    while ((c = getopt_long(argc, argv, "n:fc:h", long_options, nullptr)) != -1) {
+        switch (c) {
+            case 'n':
+                config.name = optarg;
+                break;
+            case 'f':
+                config.from_start = true;
+                break;
+            case 'c':
+                config.count = std::stoull(optarg);
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                std::exit(0);
+            default:
+                print_usage(argv[0]);
+                std::exit(1);
+        }
+    }
+    
+    return config;
+}
+
+void print_side(int64_t price_nano, uint32_t size) {
+    if (size > 0) {
+        std::printf("%.9f,%u", static_cast<double>(price_nano) / 1e9, size);
+    } else {
+        std::printf(",");
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        Config config = parse_args(argc, argv);
+        core::ShmRingConsumer<publish::TobRecord> consumer(config.name, config.from_start);
+        
+        std::printf("ts_us,symbol,bid_px,bid_sz,ask_px,ask_sz\n");
+        
+        uint64_t received = 0;
+        uint64_t epoch = consumer.epoch();
+        publish::TobRecord record;
+        while (config.count == 0 || received < config.count) {
+            if (!consumer.try_read(record)) {
+                if (!consumer.producer_alive()) {
+                    break;
+                }
+                std::fflush(stdout);
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+            }
+            
+            if (consumer.epoch() != epoch) {
+                epoch = consumer.epoch();
+                std::cerr << "Producer restarted (epoch " << epoch << ")\n";
+            }
+            
+            const std::string symbol(record.symbol, strnlen(record.symbol, sizeof(record.symbol)));
+            std::printf("%llu,%s,", static_cast<unsigned long long>(record.ts_us), symbol.c_str());
+            print_side(record.bid_px, record.bid_sz);
+            std::printf(",");
+            print_side(record.ask_px, record.ask_sz);
+            std::printf("\n");
+            received++;
+        }
+        std::fflush(stdout);
+        
+        std::cerr << "Received " << received << " records, dropped " << consumer.dropped() << "\n";
+    
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "binary_publisher.hpp"
+#include "publisher.hpp"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <getopt.h>
+
+namespace {
+
+struct Config {
+    std::string input_file = "-";  // "-" = stdin
+};
+
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n"
+              << "Converts binary top-of-book output (--output-format binary) to CSV on stdout\n"
+              << "Options:\n"
+              << "  --input FILE              Binary top-of-book file (default: stdin)\n"
+              << "  --help                    Show this help message\n";
+}
+
+Config parse_args(int argc, char* argv[]) {
+    Config config;
+    
+    static struct option long_options[] = {
+        {"input", required_argument, 0, 'i'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    
+    int c;
+    while ((c = getopt_long(argc, argv, "i:h", long_options, nullptr)) != -1) {
+        switch (c) {
+            case 'i':
+                config.input_file = optarg;
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                std::exit(0);
+            default:
+                print_usage(argv[0]);
+                std::exit(1);
+        }
+    }
+    
+    return config;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        Config config = parse_args(argc, argv);
+        std::ifstream file;
+        if (config.input_file != "-") {
+            file.open(config.input_file, std::ios::binary);
+            if (!file) {
+                throw std::runtime_error("Cannot open " + config.input_file);
+            }
+        }
+        std::istream& input = config.input_file == "-" ? std::cin : file;
+        
+        publish::BinaryTobReader reader(input);
+        publish::TopOfBookPublisher publisher(std::cout);
+        
+        uint64_t converted = 0;
+        publish::BinaryTobRecord record;
+        while (reader.next(record)) {
+            if (record.symbol_id >= reader.symbols().size()) {
+                throw std::runtime_error("Record " + std::to_string(converted) + " has unknown symbol id " +
+                                         std::to_string(record.symbol_id));
+            }
+            publisher.publish(record.ts_us, reader.symbols()[record.symbol_id], publish::to_top_of_book(record));
+            converted++;
+        }
+        
+        if (reader.record_count() != 0 && converted != reader.record_count()) {
+            std::cerr << "Warning: header promises " << reader.record_count() << " records, read "
+                      << converted << "\n";
+        }
+    
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    
+    return 0;
+}
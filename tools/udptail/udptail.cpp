@@ -0,0 +1,166 @@
+/**
+ * MIT License
+ * Copyright (c) 2025 Market Feed Project
+ */
+
+#include "udp_publisher.hpp"
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <getopt.h>
+
+namespace {
+
+struct Config {
+    std::string endpoint = "239.255.0.1:30001";
+    std::string interface = "127.0.0.1";
+    uint64_t count = 0;     // 0 = until interrupted
+    uint64_t idle_ms = 0;   // 0 = wait forever
+    bool quiet = false;
+};
+
+std::atomic<bool> g_shutdown{false};
+
+void signal_handler(int) {
+    g_shutdown = true;
+}
+
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n"
+              << "Options:\n"
+              << "  --udp GROUP:PORT          Multicast group to join (default: 239.255.0.1:30001)\n"
+              << "  --interface ADDR          Interface address (default: 127.0.0.1)\n"
+              << "  --count N                 Exit after N records (default: until interrupted)\n"
+              << "  --idle-ms N               Exit after N ms without a datagram\n"
+              << "  --quiet                   Only print the gap statistics\n"
+              << "  --help                    Show this help message\n";
+}
+
+Config parse_args(int argc, char* argv[]) {
+    Config config;
+    
+    static struct option long_options[] = {
+        {"udp", required_argument, 0, 'u'},
+        {"interface", required_argument, 0, 'I'},
+        {"count", required_argument, 0, 'c'},
+        {"idle-ms", required_argument, 0, 'i'},
+        {"quiet", no_argument, 0, 'q'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    
+    int c;
+    while ((c = getopt_long(argc, argv, "u:I:c:i:qh", long_options, nullptr)) != -1) {
+        switch (c) {
+            case 'u':
+                config.endpoint = optarg;
+                break;
+            case 'I':
+                config.interface = optarg;
+                break;
+            case 'c':
+                config.count = std::stoull(optarg);
+                break;
+            case 'i':
+                config.idle_ms = std::stoull(optarg);
+                break;
+            case 'q':
+                config.quiet = true;
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                std::exit(0);
+            default:
+                print_usage(argv[0]);
+                std::exit(1);
+        }
+    }
+    
+    return config;
+}
+
+void print_side(int64_t price_nano, uint32_t size) {
+    if (size > 0) {
+        std::printf("%.9f,%u", static_cast<double>(price_nano) / 1e9, size);
+    } else {
+        std::printf(",");
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        Config config = parse_args(argc, argv);
+        const auto [group, port] = publish::parse_udp_endpoint(config.endpoint);
+        publish::UdpTobReceiver receiver(group, port, config.interface);
+        
+        std::signal(SIGINT, signal_handler);
+        std::signal(SIGTERM, signal_handler);
+        
+        if (!config.quiet) {
+            std::printf("ts_us,symbol,bid_px,bid_sz,ask_px,ask_sz\n");
+        }
+        
+        constexpr int POLL_MS = 100;
+        publish::UdpSequenceTracker tracker;
+        publish::UdpTobHeader header;
+        std::vector<publish::TobRecord> records;
+        uint64_t received = 0;
+        uint64_t malformed = 0;
+        uint64_t idle_ms = 0;
+        while (!g_shutdown && (config.count == 0 || received < config.count)) {
+            const size_t datagrams = receiver.receive(POLL_MS);
+            if (datagrams == 0) {
+                std::fflush(stdout);
+                idle_ms += POLL_MS;
+                if (config.idle_ms > 0 && idle_ms >= config.idle_ms) {
+                    break;
+                }
+                continue;
+            }
+            idle_ms = 0;
+            
+            for (size_t i = 0; i < datagrams; ++i) {
+                records.clear();
+                if (!publish::decode_udp_datagram(receiver.datagram(i), header, records)) {
+                    malformed++;
+                    continue;
+                }
+                const uint64_t sessions = tracker.sessions();
+                tracker.on_datagram(header);
+                if (sessions > 0 && tracker.sessions() != sessions) {
+                    std::cerr << "Publisher restarted (session " << header.session << ")\n";
+                }
+                received += records.size();
+                if (config.quiet) {
+                    continue;
+                }
+                for (const publish::TobRecord& record : records) {
+                    const std::string symbol(record.symbol, strnlen(record.symbol, sizeof(record.symbol)));
+                    std::printf("%llu,%s,", static_cast<unsigned long long>(record.ts_us), symbol.c_str());
+                    print_side(record.bid_px, record.bid_sz);
+                    std::printf(",");
+                    print_side(record.ask_px, record.ask_sz);
+                    std::printf("\n");
+                }
+            }
+        }
+        std::fflush(stdout);
+        
+        std::cerr << "Received " << received << " records in " << tracker.datagrams() << " datagrams"
+                  << ": gaps=" << tracker.gaps() << " missing=" << tracker.missing()
+                  << " late=" << tracker.late() << " sessions=" << tracker.sessions()
+                  << " malformed=" << malformed << "\n";
+    
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    
+    return 0;
+}